@@ -0,0 +1,165 @@
+// Resampling throughput: 1-minute bars and trade ticks into 5m, 15m, 1h, 1d,
+// volume and range bars at once, against a std::map group-by per time
+// timeframe (the offline way), which must produce the same bars.
+//   addBars  - MultiTimeframeAggregator::addBars, one timeframe per pass
+//   addBar   - every row offered to every timeframe in turn (how a live feed drives it)
+//   addTick  - synthetic ticks, volume bars split across ticks
+//
+//   g++ -std=c++17 -O2 -I../bot bar_aggregator_bench.cpp ../bot/BarAggregator.cpp ../bot/MarketGenerator.cpp
+//       ../bot/CsvParser.cpp ../bot/BarSeries.cpp ../bot/MappedFile.cpp -o bar_aggregator_bench
+//   ./bar_aggregator_bench [bars=5000000] [ticks=20000000]
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <vector>
+#include "BarAggregator.h"
+#include "MarketGenerator.h"
+
+using namespace TradingBot;
+
+namespace {
+
+double seconds(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - since).count();
+}
+
+std::vector<BarSpec> timeframes() {
+    std::vector<BarSpec> specs;
+    specs.push_back(BarSpec::time(300));
+    specs.push_back(BarSpec::time(900));
+    specs.push_back(BarSpec::time(3600));
+    specs.push_back(BarSpec::time(86400));
+    specs.push_back(BarSpec::volumeBars(2000000));
+    specs.push_back(BarSpec::rangeBars(50));
+    return specs;
+}
+
+// Bucket -> bar in a std::map, then copied out in key order
+BarSeries groupBy(const BarSeries& input, int64_t bucket_seconds) {
+    std::map<int64_t, OHLCV> buckets;
+    for (size_t i = 0; i < input.size(); ++i) {
+        int64_t bucket = input.timestamps()[i] - input.timestamps()[i] % bucket_seconds;
+        auto found = buckets.find(bucket);
+        if (found == buckets.end()) {
+            OHLCV& bar = buckets[bucket];
+            bar.open = input.open()[i];
+            bar.high = input.high()[i];
+            bar.low = input.low()[i];
+            bar.close = input.close()[i];
+            bar.volume = input.volume()[i];
+        } else {
+            OHLCV& bar = found->second;
+            bar.high = std::max(bar.high, input.high()[i]);
+            bar.low = std::min(bar.low, input.low()[i]);
+            bar.close = input.close()[i];
+            bar.volume += input.volume()[i];
+        }
+    }
+    BarSeries out;
+    for (const auto& entry : buckets) {
+        const OHLCV& bar = entry.second;
+        out.append(entry.first, bar.open, bar.high, bar.low, bar.close, bar.volume);
+    }
+    return out;
+}
+
+bool sameBars(const BarSeries& a, const BarSeries& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a.timestamps()[i] != b.timestamps()[i] || a.open()[i] != b.open()[i] || a.high()[i] != b.high()[i] ||
+            a.low()[i] != b.low()[i] || a.close()[i] != b.close()[i] || a.volume()[i] != b.volume()[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void printCounts(const MultiTimeframeAggregator& aggregator) {
+    for (size_t i = 0; i < aggregator.size(); ++i) {
+        std::printf("%s%s %zu", i ? ", " : "    ", describeBarSpec(aggregator[i].spec()).c_str(),
+                    aggregator[i].bars().size());
+    }
+    std::printf("\n");
+}
+}
+
+int main(int argc, char* argv[]) {
+    size_t bars = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 5000000;
+    size_t ticks = argc > 2 ? static_cast<size_t>(std::atoll(argv[2])) : 20000000;
+    GeneratorParams params;
+    params.volatility = 0.0005;
+    BarSeries minutes;
+    MarketGenerator(params).generate(bars, minutes);
+    std::vector<BarSpec> specs = timeframes();
+
+    auto t0 = std::chrono::steady_clock::now();
+    MultiTimeframeAggregator batched(specs);
+    batched.addBars(minutes);
+    batched.flush();
+    double batched_s = seconds(t0);
+
+    t0 = std::chrono::steady_clock::now();
+    MultiTimeframeAggregator streamed(specs);
+    for (size_t i = 0; i < minutes.size(); ++i) {
+        streamed.addBar(minutes.timestamps()[i], minutes.open()[i], minutes.high()[i], minutes.low()[i],
+                        minutes.close()[i], minutes.volume()[i]);
+    }
+    streamed.flush();
+    double streamed_s = seconds(t0);
+
+    t0 = std::chrono::steady_clock::now();
+    std::vector<BarSeries> grouped;
+    for (const BarSpec& spec : specs) {
+        if (spec.type == BarType::TIME) grouped.push_back(groupBy(minutes, spec.seconds));
+    }
+    double grouped_s = seconds(t0);
+
+    bool same = true;
+    for (size_t i = 0; i < specs.size(); ++i) {
+        same = same && sameBars(batched[i].bars(), streamed[i].bars());
+        if (i < grouped.size()) same = same && sameBars(batched[i].bars(), grouped[i]);
+    }
+    std::printf("%zu 1-minute bars into %zu timeframes\n", bars, specs.size());
+    printCounts(batched);
+    std::printf("  addBars:          %7.1f M bars/s\n", bars / batched_s / 1e6);
+    std::printf("  addBar:           %7.1f M bars/s\n", bars / streamed_s / 1e6);
+    std::printf("  map group-by:     %7.1f M bars/s (%zu time timeframes only)\n", bars / grouped_s / 1e6,
+                grouped.size());
+
+    // Ticks: 0-3 s apart, a small random walk, sizes 1-500
+    std::vector<int64_t> timestamps(ticks), sizes(ticks);
+    std::vector<double> prices(ticks);
+    Philox rng(7, 0);
+    int64_t timestamp = params.start_timestamp;
+    double price = params.start_price;
+    for (size_t i = 0; i < ticks; ++i) {
+        uint32_t word = rng.next();
+        timestamp += word & 3;
+        price *= 1.0 + 0.0002 * rng.normal();
+        timestamps[i] = timestamp;
+        prices[i] = price;
+        sizes[i] = 1 + (word >> 2) % 500;
+    }
+    t0 = std::chrono::steady_clock::now();
+    MultiTimeframeAggregator from_ticks(specs);
+    for (size_t i = 0; i < ticks; ++i) from_ticks.addTick(timestamps[i], prices[i], sizes[i]);
+    from_ticks.flush();
+    double ticks_s = seconds(t0);
+    int64_t volume_total = 0;
+    const BarSeries& volume_bars = from_ticks[4].bars();
+    for (size_t i = 0; i + 1 < volume_bars.size(); ++i) {
+        same = same && volume_bars.volume()[i] == specs[4].volume;
+        volume_total += volume_bars.volume()[i];
+    }
+    if (!volume_bars.empty()) volume_total += volume_bars.volume().back();
+    int64_t tick_total = 0;
+    for (int64_t size : sizes) tick_total += size;
+    same = same && volume_total == tick_total;
+    std::printf("%zu ticks into %zu timeframes\n", ticks, specs.size());
+    printCounts(from_ticks);
+    std::printf("  addTick:          %7.1f M ticks/s\n", ticks / ticks_s / 1e6);
+    std::printf("%s\n", same ? "all outputs agree" : "MISMATCH");
+    return same ? 0 : 1;
+}
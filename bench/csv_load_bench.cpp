@@ -0,0 +1,132 @@
+// CSV load throughput: the original getline/stringstream/stod loader versus
+// MarketDataHandler's mmap + in-place parser.
+//
+//   g++ -std=c++17 -O2 -I../bot csv_load_bench.cpp ../bot/MarketDataHandler.cpp ../bot/MarketGenerator.cpp
+//       ../bot/BarAggregator.cpp ../bot/BarCache.cpp ../bot/BarSeries.cpp ../bot/CsvParser.cpp ../bot/MappedFile.cpp
+//       ../bot/ThreadPool.cpp -pthread -o csv_load_bench
+//   ./csv_load_bench [rows=1000000] [csv path to use instead of a synthetic file] [threads=0]
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "MarketDataHandler.h"
+
+using namespace TradingBot;
+
+namespace {
+
+// The loader as it was before the mmap rewrite, kept here as the baseline
+std::string legacyTrim(const std::string& str) {
+    size_t first = str.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos) return "";
+    size_t last = str.find_last_not_of(" \t\r\n");
+    return str.substr(first, (last - first + 1));
+}
+OHLCV legacyParseLine(const std::string& line) {
+    OHLCV data;
+    std::stringstream ss(line);
+    std::string token;
+    int field = 0;
+    while (std::getline(ss, token, ',')) {
+        token = legacyTrim(token);
+        try {
+            switch (field) {
+                case 0: data.date = token; break;
+                case 1: data.open = std::stod(token); break;
+                case 2: data.high = std::stod(token); break;
+                case 3: data.low = std::stod(token); break;
+                case 4: data.close = std::stod(token); break;
+                case 5: data.volume = std::stoll(token); break;
+            }
+        } catch (const std::exception&) {
+        }
+        field++;
+    }
+    return data;
+}
+size_t legacyLoad(const std::string& filename, std::vector<OHLCV>& out) {
+    std::ifstream file(filename);
+    std::string line;
+    bool first_line = true;
+    while (std::getline(file, line)) {
+        if (first_line) {
+            first_line = false;
+            continue;
+        }
+        if (line.empty()) continue;
+        OHLCV data = legacyParseLine(line);
+        if (data.close > 0) out.push_back(data);
+    }
+    return out.size();
+}
+
+void writeSyntheticCsv(const std::string& path, size_t rows) {
+    std::ofstream out(path);
+    out << "Date,Open,High,Low,Close,Volume\n";
+    std::mt19937_64 gen(42);
+    std::normal_distribution<> step(0.0, 0.0005);
+    double price = 21500.0;
+    long long t = 1704067200;  // 2024-01-01
+    char line[160];
+    for (size_t i = 0; i < rows; ++i, t += 60) {
+        double open = price;
+        price *= 1.0 + step(gen);
+        double high = std::max(open, price) * 1.001;
+        double low = std::min(open, price) * 0.999;
+        long long day = t / 86400, secs = t % 86400;
+        // civil date for the synthetic minute bars
+        long long z = day + 719468, era = z / 146097, doe = z - era * 146097;
+        long long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        long long doy = doe - (365 * yoe + yoe / 4 - yoe / 100), mp = (5 * doy + 2) / 153;
+        long long d = doy - (153 * mp + 2) / 5 + 1, m = mp < 10 ? mp + 3 : mp - 9, y = yoe + era * 400 + (m <= 2);
+        std::snprintf(line, sizeof(line), "%04lld-%02lld-%02lld %02lld:%02lld:00,%.2f,%.2f,%.2f,%.2f,%lld\n",
+                      y, m, d, secs / 3600, secs / 60 % 60, open, high, low, price,
+                      100000LL + static_cast<long long>(gen() % 900000));
+        out << line;
+    }
+}
+
+double fileMB(const std::string& path) {
+    std::ifstream f(path, std::ios::binary | std::ios::ate);
+    return static_cast<double>(f.tellg()) / (1024.0 * 1024.0);
+}
+}
+
+int main(int argc, char* argv[]) {
+    size_t rows = argc > 1 ? std::stoul(argv[1]) : 1000000;
+    std::string path = argc > 2 ? argv[2] : "csv_load_bench.csv";
+    if (argc <= 2) writeSyntheticCsv(path, rows);
+    double mb = fileMB(path);
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<OHLCV> legacy;
+    legacyLoad(path, legacy);
+    auto t1 = std::chrono::steady_clock::now();
+    MarketDataHandler handler;
+    handler.setLoadThreads(argc > 3 ? std::stoul(argv[3]) : 0);
+    handler.loadFromCSV(path);
+    auto t2 = std::chrono::steady_clock::now();
+
+    double legacy_s = std::chrono::duration<double>(t1 - t0).count();
+    double mmap_s = std::chrono::duration<double>(t2 - t1).count();
+    std::printf("file: %s (%.1f MB)\n", path.c_str(), mb);
+    std::printf("legacy getline/stod : %8zu rows %8.3f s %8.1f MB/s\n", legacy.size(), legacy_s, mb / legacy_s);
+    std::printf("mmap + in-place     : %8zu rows %8.3f s %8.1f MB/s (%.1fx)\n",
+                handler.getDataSize(), mmap_s, mb / mmap_s, legacy_s / mmap_s);
+
+    // Both loaders must agree bit-for-bit on the numeric columns
+    size_t mismatches = 0;
+    Span<const double> closes = handler.getSeries().close();
+    for (size_t i = 0; i < legacy.size() && i < closes.size(); ++i) {
+        if (legacy[i].close != closes[i]) mismatches++;
+    }
+    if (mismatches > 0 || legacy.size() != closes.size()) {
+        std::printf("MISMATCH: %zu differing closes\n", mismatches);
+        return 1;
+    }
+    return 0;
+}
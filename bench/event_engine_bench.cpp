@@ -0,0 +1,143 @@
+// The event-driven backtest driver against the hand-written bar loop it
+// replaced, on synthetic random-walk bars. Both use the same precomputed
+// SignalKernel, broker, risk manager and in-memory trade log, and must
+// produce the same trades. Each timed run computes its signal batch, walks
+// the bars and books the trades.
+//
+//   g++ -std=c++17 -O2 -I../bot event_engine_bench.cpp ../bot/Backtester.cpp ../bot/EventEngine.cpp
+//       ../bot/TradingHandlers.cpp ../bot/SignalKernel.cpp ../bot/Strategy.cpp ../bot/Indicators.cpp
+//       ../bot/RiskManager.cpp ../bot/BrokerSimulator.cpp ../bot/SymbolTable.cpp ../bot/MatchingEngine.cpp
+//       ../bot/TradeLogger.cpp ../bot/TradeJournal.cpp ../bot/PerformanceTracker.cpp ../bot/RunArena.cpp
+//       ../bot/AllocationStats.cpp ../bot/BarSeries.cpp ../bot/MappedFile.cpp ../bot/Config.cpp -pthread
+//       -o event_engine_bench
+//   ./event_engine_bench [bars=2000000] [repeats=5]
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "Backtester.h"
+#include "BrokerSimulator.h"
+#include "PerformanceTracker.h"
+#include "RiskManager.h"
+
+using namespace TradingBot;
+
+namespace {
+
+BarSeries syntheticSeries(size_t bars) {
+    BarSeries series;
+    series.reserve(bars);
+    uint64_t state = 88172645463325252ull;
+    double price = 20000.0;
+    for (size_t i = 0; i < bars; ++i) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        double change = (static_cast<double>(state >> 11) * (1.0 / 9007199254740992.0) - 0.5) * 0.004;
+        double open = price;
+        price *= 1.0 + change;
+        series.append(1704067200 + static_cast<int64_t>(i) * 60, open, std::max(open, price) * 1.001,
+                      std::min(open, price) * 0.999, price, 100000);
+    }
+    return series;
+}
+
+// The pre-event-engine close-fill loop
+double legacyRun(const BarSeries& series, const BacktestParams& params, const SignalKernel& kernel,
+                 TradeLogger& logger) {
+    size_t start = static_cast<size_t>(params.long_ma_period);
+    std::vector<int8_t> signals(series.size() - start);
+    kernel.computeSignals(SignalParams(params.short_ma_period, params.long_ma_period, params.rsi_period,
+                                       params.rsi_upper, params.rsi_lower),
+                          start, series.size(), signals.data());
+    const int8_t* batch = signals.data();
+    RiskManager riskManager(params.risk_percentage);
+    BrokerSimulator broker(params.initial_balance);
+    broker.setVerbose(false);
+    SymbolId symbol = broker.registerSymbol(params.symbol);
+    Span<const double> closes = series.close();
+    size_t total_bars = series.size();
+    PerformanceTracker& performance = logger.performance();
+    int held = 0;
+    std::string date;
+    for (size_t i = start; i < total_bars; ++i) {
+        double price = closes[i];
+        int8_t code = batch[i - start];
+        if (code == kSignalHold) {
+            performance.onMark(broker.getBalance() + held * price, held > 0);
+            continue;
+        }
+        if (code == kSignalBuy && !broker.hasPosition(symbol)) {
+            int quantity = riskManager.calculatePositionSize(price, broker.getBalance());
+            if (quantity > 0) {
+                series.dateAt(i, date);
+                if (broker.executeBuy(symbol, quantity, price, date)) {
+                    logger.logTrade(broker.getLastTrade());
+                    held = quantity;
+                }
+            }
+        } else if (code == kSignalSell && broker.hasPosition(symbol)) {
+            series.dateAt(i, date);
+            if (broker.executeSell(symbol, broker.position(symbol).quantity, price, date)) {
+                logger.logTrade(broker.getLastTrade());
+                held = 0;
+            }
+        }
+        performance.onMark(broker.getBalance() + held * price, held > 0);
+    }
+    if (broker.hasPosition(symbol)) {
+        broker.executeSell(symbol, broker.position(symbol).quantity, closes.back(), series.dateAt(total_bars - 1));
+        logger.logTrade(broker.getLastTrade());
+    }
+    return broker.getBalance();
+}
+
+double seconds(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - since).count();
+}
+}
+
+int main(int argc, char* argv[]) {
+    size_t bars = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 2000000;
+    int repeats = argc > 2 ? std::max(std::atoi(argv[2]), 1) : 5;
+    BarSeries series = syntheticSeries(bars);
+    BacktestParams params;
+    params.short_ma_period = argc > 3 ? std::atoi(argv[3]) : 5;
+    params.long_ma_period = argc > 4 ? std::atoi(argv[4]) : 20;
+    params.risk_percentage = 50;
+    SignalKernel kernel(series.close());
+
+    double legacy_best = 1e9, engine_best = 1e9;
+    double legacy_balance = 0, engine_balance = 0;
+    int legacy_trades = 0, engine_trades = 0;
+    for (int r = 0; r < repeats; ++r) {
+        {
+            TradeLogger logger("");
+            auto t0 = std::chrono::steady_clock::now();
+            legacy_balance = legacyRun(series, params, kernel, logger);
+            legacy_best = std::min(legacy_best, seconds(t0));
+            legacy_trades = logger.calculateStatistics(params.initial_balance, legacy_balance).total_trades;
+        }
+        {
+            TradeLogger logger("");
+            auto t0 = std::chrono::steady_clock::now();
+            Backtester backtester(series, params, &kernel);
+            BacktestResult result = backtester.run(logger);
+            engine_best = std::min(engine_best, seconds(t0));
+            engine_balance = result.final_balance;
+            engine_trades = result.stats.total_trades;
+        }
+    }
+    std::printf("%zu bars, %d trades\n", bars, engine_trades);
+    std::printf("hand-written loop: %.2f ns/bar (balance %.2f, %d trades)\n", legacy_best * 1e9 / bars,
+                legacy_balance, legacy_trades);
+    std::printf("event engine:      %.2f ns/bar (balance %.2f, %d trades)\n", engine_best * 1e9 / bars,
+                engine_balance, engine_trades);
+    if (legacy_balance != engine_balance || legacy_trades != engine_trades) {
+        std::printf("MISMATCH between the two drivers\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,136 @@
+// MatchingEngine throughput with a realistic order mix (market, limit,
+// stop, stop-limit, plus cancels) over synthetic random-walk bars, and a
+// check that the steady state performs no heap allocations.
+//
+//   g++ -std=c++17 -O2 -I../bot matching_engine_bench.cpp ../bot/MatchingEngine.cpp -o matching_engine_bench
+//   ./matching_engine_bench [orders=5000000] [symbols=20] [orders_per_bar=8]
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include "MatchingEngine.h"
+
+using namespace TradingBot;
+
+namespace {
+std::atomic<uint64_t> g_allocations(0);
+}
+
+// Counts every allocation in the process; the timed loop must not add any
+void* operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+namespace {
+
+class Rng {
+public:
+    explicit Rng(uint64_t seed) : state_(seed) {}
+    uint64_t next() {
+        state_ ^= state_ << 13;
+        state_ ^= state_ >> 7;
+        state_ ^= state_ << 17;
+        return state_;
+    }
+    double uniform() { return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0); }
+private:
+    uint64_t state_;
+};
+
+struct Stats {
+    uint64_t orders = 0;
+    uint64_t cancels = 0;
+    uint64_t fills = 0;
+};
+
+// One pass over `bars` bars per symbol
+void simulate(MatchingEngine& engine, std::vector<double>& prices, Rng& rng, size_t bars, int per_bar,
+              std::vector<OrderId>& recent, std::vector<Fill>& fills, Stats& stats) {
+    SymbolId symbols = static_cast<SymbolId>(prices.size());
+    for (size_t b = 0; b < bars; ++b) {
+        for (SymbolId s = 0; s < symbols; ++s) {
+            double open = prices[s];
+            double close = open * (1.0 + (rng.uniform() - 0.5) * 0.01);
+            double high = std::max(open, close) * (1.0 + rng.uniform() * 0.004);
+            double low = std::min(open, close) * (1.0 - rng.uniform() * 0.004);
+            BarRange bar = {open, high, low, close, 1000000};
+            fills.clear();
+            stats.fills += engine.match(s, bar, fills);
+            prices[s] = close;
+
+            for (int k = 0; k < per_bar; ++k) {
+                Signal side = rng.next() & 1 ? Signal::BUY : Signal::SELL;
+                int quantity = 1 + static_cast<int>(rng.next() % 100);
+                double offset = close * (rng.uniform() * 0.02);
+                double away = side == Signal::BUY ? close - offset : close + offset;   // passive side
+                double through = side == Signal::BUY ? close + offset : close - offset;
+                OrderRequest request;
+                switch (rng.next() % 8) {
+                    case 0: request = OrderRequest::market(s, side, quantity); break;
+                    case 1: case 2: case 3: case 4: request = OrderRequest::limit(s, side, quantity, away); break;
+                    case 5: case 6: request = OrderRequest::stop(s, side, quantity, through); break;
+                    default: request = OrderRequest::stopLimit(s, side, quantity, through, through); break;
+                }
+                OrderId id = engine.submit(request);
+                stats.orders++;
+                // Cancel/replace: each new order retires the one submitted
+                // recent.size() orders earlier if it is still resting, which
+                // bounds the books the way a quoting strategy would
+                OrderId& slot = recent[stats.orders % recent.size()];
+                if (engine.cancel(slot)) stats.cancels++;
+                slot = id;
+            }
+        }
+    }
+}
+}
+
+int main(int argc, char* argv[]) {
+    size_t orders = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 5000000;
+    size_t symbols = argc > 2 ? static_cast<size_t>(std::atoll(argv[2])) : 20;
+    int per_bar = argc > 3 ? std::atoi(argv[3]) : 8;
+    if (symbols == 0) symbols = 1;
+    if (per_bar <= 0) per_bar = 1;
+    size_t bars = std::max<size_t>(orders / (symbols * per_bar), 1);
+
+    ExecutionSettings settings;
+    settings.brokerage_per_order = 20;
+    settings.brokerage_pct = 0.03;
+    settings.stt_sell_pct = 0.1;
+    settings.slippage_bps = 1;
+    settings.volume_participation = 0.0005;  // 500 shares a bar, so some fills are partial
+    MatchingEngine engine(settings);
+    std::vector<double> prices(symbols, 1000.0);
+    std::vector<OrderId> recent(2048, kInvalidOrder);
+    std::vector<Fill> fills;
+    fills.reserve(4096);
+    Rng rng(42);
+
+    // Warm-up grows the pool and the books to their working size
+    Stats warm;
+    simulate(engine, prices, rng, std::max<size_t>(bars / 10, 1), per_bar, recent, fills, warm);
+
+    Stats stats;
+    uint64_t allocations_before = g_allocations.load();
+    size_t capacity_before = engine.poolCapacity();
+    auto start = std::chrono::steady_clock::now();
+    simulate(engine, prices, rng, bars, per_bar, recent, fills, stats);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    uint64_t allocations = g_allocations.load() - allocations_before;
+
+    std::printf("%zu symbols x %zu bars, %llu orders, %llu cancels, %llu fills, %zu resting\n", symbols, bars,
+                static_cast<unsigned long long>(stats.orders), static_cast<unsigned long long>(stats.cancels),
+                static_cast<unsigned long long>(stats.fills), engine.openOrders());
+    std::printf("%.1f ns per order (submit + share of matching), %.2f M orders/s\n",
+                seconds * 1e9 / static_cast<double>(stats.orders), stats.orders / seconds / 1e6);
+    std::printf("pool %zu -> %zu nodes, %llu heap allocations in the timed loop\n", capacity_before,
+                engine.poolCapacity(), static_cast<unsigned long long>(allocations));
+    return 0;
+}
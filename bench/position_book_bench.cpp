@@ -0,0 +1,159 @@
+// Position book lookups on the fill path: the original std::map<string,
+// Position> broker versus BrokerSimulator's dense id-indexed book, through
+// both its string and its SymbolId overloads. Each step does what the
+// backtest/portfolio loops do per signal: a hasPosition check, then a buy,
+// or a position lookup and a sell.
+//
+//   g++ -std=c++17 -O2 -I../bot position_book_bench.cpp ../bot/BrokerSimulator.cpp ../bot/SymbolTable.cpp
+//       -o position_book_bench
+//   ./position_book_bench [steps=5000000] [symbols=50]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+#include "BrokerSimulator.h"
+
+using namespace TradingBot;
+
+namespace {
+
+// The book as it was: find + at / find + operator[], positions copied out
+class LegacyBroker {
+public:
+    explicit LegacyBroker(double balance) : balance_(balance) {}
+    bool executeBuy(const std::string& symbol, int quantity, double price, const std::string& date) {
+        double cost = quantity * price;
+        if (cost > balance_) return false;
+        balance_ -= cost;
+        if (positions_.find(symbol) != positions_.end()) {
+            Position& pos = positions_[symbol];
+            double total_cost = (pos.quantity * pos.entry_price) + cost;
+            pos.quantity += quantity;
+            pos.entry_price = total_cost / pos.quantity;
+        } else {
+            Position pos;
+            pos.symbol = symbol;
+            pos.quantity = quantity;
+            pos.entry_price = price;
+            pos.entry_date = date;
+            positions_[symbol] = pos;
+        }
+        record(symbol, Signal::BUY, quantity, price, cost, date);
+        return true;
+    }
+    bool executeSell(const std::string& symbol, int quantity, double price, const std::string& date) {
+        if (positions_.find(symbol) == positions_.end()) return false;
+        Position& pos = positions_[symbol];
+        if (quantity > pos.quantity) quantity = pos.quantity;
+        double revenue = quantity * price;
+        balance_ += revenue;
+        pos.quantity -= quantity;
+        if (pos.quantity == 0) positions_.erase(symbol);
+        record(symbol, Signal::SELL, quantity, price, revenue, date);
+        return true;
+    }
+    Position getPosition(const std::string& symbol) const {
+        auto it = positions_.find(symbol);
+        return it != positions_.end() ? it->second : Position();
+    }
+    bool hasPosition(const std::string& symbol) const {
+        return positions_.find(symbol) != positions_.end() && positions_.at(symbol).quantity > 0;
+    }
+    double getBalance() const { return balance_; }
+private:
+    double balance_;
+    std::map<std::string, Position> positions_;
+    Trade last_trade_;
+    void record(const std::string& symbol, Signal signal, int quantity, double price, double value,
+                const std::string& date) {
+        last_trade_.timestamp = date;
+        last_trade_.symbol = symbol;
+        last_trade_.signal = signal;
+        last_trade_.price = price;
+        last_trade_.quantity = quantity;
+        last_trade_.value = value;
+        last_trade_.balance_after = balance_;
+    }
+};
+
+// Symbol visited at each step: a fixed pseudo-random walk over all symbols
+std::vector<uint32_t> makeSchedule(size_t steps, size_t symbols) {
+    std::vector<uint32_t> schedule(steps);
+    uint64_t state = 88172645463325252ull;
+    for (size_t i = 0; i < steps; ++i) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        schedule[i] = static_cast<uint32_t>(state % symbols);
+    }
+    return schedule;
+}
+
+template <typename Broker, typename Key>
+double run(Broker& broker, const std::vector<Key>& keys, const std::vector<uint32_t>& schedule,
+           const std::string& date, double& checksum) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < schedule.size(); ++i) {
+        const Key& key = keys[schedule[i]];
+        double price = 100.0 + static_cast<double>(i & 63);
+        if (!broker.hasPosition(key)) {
+            broker.executeBuy(key, 10, price, date);
+        } else if (i & 1) {
+            broker.executeSell(key, broker.getPosition(key).quantity, price, date);
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    checksum = broker.getBalance();
+    return seconds;
+}
+
+// The id path reads positions by reference instead of copying them out
+struct IdBroker {
+    BrokerSimulator& broker;
+    bool hasPosition(SymbolId id) const { return broker.hasPosition(id); }
+    const Position& getPosition(SymbolId id) const { return broker.position(id); }
+    bool executeBuy(SymbolId id, int q, double p, const std::string& d) { return broker.executeBuy(id, q, p, d); }
+    bool executeSell(SymbolId id, int q, double p, const std::string& d) { return broker.executeSell(id, q, p, d); }
+    double getBalance() const { return broker.getBalance(); }
+};
+}
+
+int main(int argc, char* argv[]) {
+    size_t steps = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 5000000;
+    size_t symbol_count = argc > 2 ? static_cast<size_t>(std::atoll(argv[2])) : 50;
+    if (symbol_count == 0) symbol_count = 1;
+    const double balance = 1e15;
+    const std::string date = "2024-03-15 10:15:00";
+
+    std::vector<std::string> names;
+    for (size_t k = 0; k < symbol_count; ++k) names.push_back("NSE:SYMBOL" + std::to_string(k));
+    std::vector<uint32_t> schedule = makeSchedule(steps, symbol_count);
+
+    double legacy_sum = 0, string_sum = 0, id_sum = 0;
+    LegacyBroker legacy(balance);
+    double legacy_s = run(legacy, names, schedule, date, legacy_sum);
+
+    BrokerSimulator by_name(balance);
+    by_name.setVerbose(false);
+    for (const std::string& name : names) by_name.registerSymbol(name);
+    double string_s = run(by_name, names, schedule, date, string_sum);
+
+    BrokerSimulator by_id(balance);
+    by_id.setVerbose(false);
+    std::vector<SymbolId> ids;
+    for (const std::string& name : names) ids.push_back(by_id.registerSymbol(name));
+    IdBroker id_broker = {by_id};
+    double id_s = run(id_broker, ids, schedule, date, id_sum);
+
+    std::printf("%zu steps over %zu symbols\n", steps, symbol_count);
+    std::printf("std::map book      : %7.1f ns/step\n", legacy_s * 1e9 / steps);
+    std::printf("dense, string keys : %7.1f ns/step (%.1fx)\n", string_s * 1e9 / steps, legacy_s / string_s);
+    std::printf("dense, SymbolId    : %7.1f ns/step (%.1fx)\n", id_s * 1e9 / steps, legacy_s / id_s);
+    if (legacy_sum != string_sum || legacy_sum != id_sum) {
+        std::printf("MISMATCH: final balances differ\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,114 @@
+// Compile-time strategy composition against the same rule with run-time
+// parameters, on synthetic random-walk closes. Each path turns the whole
+// series into signal codes:
+//   compiled - MACrossoverRSI<...>: periods and thresholds are template arguments
+//   runtime  - RuntimeMACrossoverRSI built from SignalParams (what config.txt drives)
+//   Strategy - Strategy::onBar, the runtime rule plus signal reporting
+//   kernel   - SignalKernel::computeSignals over prefix sums (batch reference)
+// The first three must agree exactly; the kernel may differ on exact ties.
+//
+//   g++ -std=c++17 -O2 -I../bot strategy_bench.cpp ../bot/Strategy.cpp ../bot/Indicators.cpp
+//       ../bot/SignalKernel.cpp ../bot/BarSeries.cpp ../bot/MappedFile.cpp -o strategy_bench
+//   ./strategy_bench [bars=2000000] [repeats=5]
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "Strategy.h"
+#include "StrategyTemplates.h"
+#include "SignalKernel.h"
+
+using namespace TradingBot;
+
+namespace {
+
+std::vector<double> syntheticCloses(size_t bars) {
+    std::vector<double> closes(bars);
+    uint64_t state = 88172645463325252ull;
+    double price = 20000.0;
+    for (size_t i = 0; i < bars; ++i) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        price *= 1.0 + (static_cast<double>(state >> 11) * (1.0 / 9007199254740992.0) - 0.5) * 0.004;
+        closes[i] = price;
+    }
+    return closes;
+}
+
+double seconds(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - since).count();
+}
+
+// Best time of `repeats` runs of `fill` writing codes for bars [begin, end)
+template <typename Fill>
+double bestOf(int repeats, Fill fill) {
+    double best = 1e9;
+    for (int r = 0; r < repeats; ++r) {
+        auto t0 = std::chrono::steady_clock::now();
+        fill();
+        best = std::min(best, seconds(t0));
+    }
+    return best;
+}
+
+size_t differences(const std::vector<int8_t>& a, const std::vector<int8_t>& b) {
+    size_t count = 0;
+    for (size_t i = 0; i < a.size(); ++i) count += a[i] != b[i];
+    return count;
+}
+
+template <typename Compiled>
+bool compare(const char* label, const std::vector<double>& closes, const SignalParams& params, int repeats) {
+    Span<const double> series(closes.data(), closes.size());
+    size_t begin = static_cast<size_t>(params.long_period);
+    size_t count = closes.size() - begin;
+    std::vector<int8_t> compiled(count), runtime(count), streaming(count), batch(count);
+    SignalKernel kernel(series);
+
+    double compiled_s = bestOf(repeats, [&]() {
+        Compiled strategy;
+        generateSignals(strategy, series, begin, closes.size(), compiled.data());
+    });
+    double runtime_s = bestOf(repeats, [&]() {
+        RuntimeMACrossoverRSI strategy = makeMACrossoverRSI(params);
+        generateSignals(strategy, series, begin, closes.size(), runtime.data());
+    });
+    double strategy_s = bestOf(repeats, [&]() {
+        Strategy strategy(params.short_period, params.long_period, params.rsi_period, params.rsi_upper,
+                          params.rsi_lower);
+        strategy.setVerbose(false);
+        generateSignals(strategy, series, begin, closes.size(), streaming.data());
+    });
+    double kernel_s = bestOf(repeats, [&]() { kernel.computeSignals(params, begin, closes.size(), batch.data()); });
+
+    size_t signals = count - static_cast<size_t>(std::count(compiled.begin(), compiled.end(), kSignalHold));
+    double bars = static_cast<double>(closes.size());
+    std::printf("%s (%zu signals)\n", label, signals);
+    std::printf("  compiled:  %6.2f ns/bar\n", compiled_s * 1e9 / bars);
+    std::printf("  runtime:   %6.2f ns/bar\n", runtime_s * 1e9 / bars);
+    std::printf("  Strategy:  %6.2f ns/bar\n", strategy_s * 1e9 / bars);
+    std::printf("  kernel:    %6.2f ns/bar (%zu signals differ)\n", kernel_s * 1e9 / bars,
+                differences(compiled, batch));
+    if (differences(compiled, runtime) != 0 || differences(compiled, streaming) != 0) {
+        std::printf("  MISMATCH: compiled %zu / Strategy %zu signals differ from runtime\n",
+                    differences(compiled, runtime), differences(streaming, runtime));
+        return false;
+    }
+    return true;
+}
+}
+
+int main(int argc, char* argv[]) {
+    size_t bars = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 2000000;
+    int repeats = argc > 2 ? std::max(std::atoi(argv[2]), 1) : 5;
+    std::vector<double> closes = syntheticCloses(std::max<size_t>(bars, 100));
+    std::printf("%zu bars, best of %d\n", closes.size(), repeats);
+    bool same = compare<MACrossoverRSI<10, 50, 14, 30, 70>>("SMA 10/50, RSI 14 30/70", closes,
+                                                            SignalParams(10, 50, 14, 70, 30), repeats);
+    same = compare<MACrossoverRSI<5, 20, 7, 25, 75>>("SMA 5/20, RSI 7 25/75", closes,
+                                                     SignalParams(5, 20, 7, 75, 25), repeats) && same;
+    return same ? 0 : 1;
+}
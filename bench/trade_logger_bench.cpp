@@ -0,0 +1,91 @@
+// Trade logging cost on the caller's thread: the synchronous TradeLogger
+// (format + flush per trade) versus async mode (queue push only), plus the
+// wall time until the async file is complete.
+//
+//   g++ -std=c++17 -O2 -I../bot trade_logger_bench.cpp ../bot/TradeLogger.cpp ../bot/PerformanceTracker.cpp
+//       ../bot/RunArena.cpp ../bot/TradeJournal.cpp ../bot/BarSeries.cpp ../bot/MappedFile.cpp -pthread -o trade_logger_bench
+//   ./trade_logger_bench [trades=200000] [flush_interval_ms=100]
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "TradeLogger.h"
+
+using namespace TradingBot;
+
+namespace {
+
+std::vector<Trade> makeTrades(size_t count) {
+    std::vector<Trade> trades(count);
+    double balance = 100000.0;
+    for (size_t i = 0; i < count; ++i) {
+        Trade& t = trades[i];
+        t.timestamp = "2024-03-" + std::to_string(10 + i % 18) + " 10:" + std::to_string(10 + i % 50) + ":00";
+        t.symbol = "NIFTY50";
+        t.signal = i % 2 == 0 ? Signal::BUY : Signal::SELL;
+        t.price = 21000.0 + static_cast<double>(i % 997) * 0.35;
+        t.quantity = 1 + static_cast<int>(i % 7);
+        t.value = t.price * t.quantity;
+        balance += t.signal == Signal::BUY ? -t.value : t.value;
+        t.balance_after = balance;
+    }
+    return trades;
+}
+
+struct Timing {
+    double call_seconds;    // total time inside logTrade()
+    double worst_call_us;   // slowest single logTrade()
+    double total_seconds;   // until the file is complete
+};
+
+Timing run(const std::vector<Trade>& trades, const std::string& path, bool async, int flush_ms) {
+    Timing timing = {0, 0, 0};
+    auto start = std::chrono::steady_clock::now();
+    {
+        TradeLogger logger(path, async, flush_ms);
+        for (const Trade& trade : trades) {
+            auto before = std::chrono::steady_clock::now();
+            logger.logTrade(trade);
+            double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - before).count();
+            timing.call_seconds += us / 1e6;
+            timing.worst_call_us = std::max(timing.worst_call_us, us);
+        }
+        logger.close();
+    }
+    timing.total_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return timing;
+}
+
+std::string slurp(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+}
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 200000;
+    int flush_ms = argc > 2 ? std::atoi(argv[2]) : 100;
+    std::vector<Trade> trades = makeTrades(count);
+    const std::string sync_path = "trade_logger_bench_sync.csv";
+    const std::string async_path = "trade_logger_bench_async.csv";
+
+    Timing sync = run(trades, sync_path, false, flush_ms);
+    Timing async = run(trades, async_path, true, flush_ms);
+
+    std::printf("%zu trades\n", count);
+    std::printf("sync  : %8.1f ns/trade on caller, worst %8.1f us, file done in %.3f s\n",
+                sync.call_seconds * 1e9 / count, sync.worst_call_us, sync.total_seconds);
+    std::printf("async : %8.1f ns/trade on caller, worst %8.1f us, file done in %.3f s (%.1fx less caller time)\n",
+                async.call_seconds * 1e9 / count, async.worst_call_us, async.total_seconds,
+                async.call_seconds > 0 ? sync.call_seconds / async.call_seconds : 0.0);
+    if (slurp(sync_path) != slurp(async_path)) {
+        std::printf("MISMATCH: sync and async logs differ\n");
+        return 1;
+    }
+    std::remove(sync_path.c_str());
+    std::remove(async_path.c_str());
+    return 0;
+}
@@ -0,0 +1,334 @@
+// Google Benchmark suite over the hot paths, on synthetic minute bars from
+// MarketGenerator (seed 42, 0.05% per bar) at 1M and 10M bars:
+//   CSV parse (in memory) and load (file, mmap, all cores), streaming
+//   indicators, signal generation (prefix-sum kernel and streaming rule),
+//   broker and matching-engine fills, trade logging, whole backtests, and
+//   resampling and generation themselves.
+// Throughput is reported as items (bars, fills or trades) per second.
+//
+// Built by CMake as trading_benchmarks (target run-benchmarks writes
+// benchmarks.json); by hand:
+//   g++ -std=c++17 -O2 -I../bot trading_benchmarks.cpp $(ls ../bot/*.cpp | grep -v main.cpp)
+//       -lbenchmark -pthread -o trading_benchmarks
+// One size only with
+//   ./trading_benchmarks --benchmark_filter='/1000000$'
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+#include "Backtester.h"
+#include "BarAggregator.h"
+#include "BrokerSimulator.h"
+#include "CsvParser.h"
+#include "Indicators.h"
+#include "MarketDataHandler.h"
+#include "MarketGenerator.h"
+#include "MatchingEngine.h"
+#include "SignalKernel.h"
+#include "StrategyTemplates.h"
+#include "TradeLogger.h"
+
+using namespace TradingBot;
+
+namespace {
+
+// Inputs are built once per size and shared by every benchmark
+const BarSeries& bars(size_t n) {
+    static std::map<size_t, BarSeries> cache;
+    auto found = cache.find(n);
+    if (found != cache.end()) return found->second;
+    GeneratorParams params;
+    params.volatility = 0.0005;
+    BarSeries& series = cache[n];
+    MarketGenerator(params).generate(n, series);
+    return series;
+}
+
+const std::string& csvText(size_t n) {
+    static std::map<size_t, std::string> cache;
+    auto found = cache.find(n);
+    if (found != cache.end()) return found->second;
+    const BarSeries& series = bars(n);
+    std::string& text = cache[n];
+    text.reserve(n * 60);
+    text = "Date,Open,High,Low,Close,Volume\n";
+    std::string date;
+    for (size_t i = 0; i < n; ++i) {
+        series.dateAt(i, date);
+        text += date;
+        text.push_back(',');
+        appendFixed2(text, series.open()[i]);
+        text.push_back(',');
+        appendFixed2(text, series.high()[i]);
+        text.push_back(',');
+        appendFixed2(text, series.low()[i]);
+        text.push_back(',');
+        appendFixed2(text, series.close()[i]);
+        text.push_back(',');
+        text += std::to_string(series.volume()[i]);
+        text.push_back('\n');
+    }
+    return text;
+}
+
+// The CSV on disk, deleted when the suite exits
+struct TempFiles {
+    std::map<size_t, std::string> paths;
+    ~TempFiles() {
+        for (const auto& entry : paths) std::remove(entry.second.c_str());
+    }
+};
+const std::string& csvFile(size_t n) {
+    static TempFiles files;
+    auto found = files.paths.find(n);
+    if (found != files.paths.end()) return found->second;
+    std::string path = "trading_benchmarks_" + std::to_string(n) + ".csv";
+    const std::string& text = csvText(n);
+    std::FILE* out = std::fopen(path.c_str(), "wb");
+    if (out) {
+        std::fwrite(text.data(), 1, text.size(), out);
+        std::fclose(out);
+    }
+    return files.paths[n] = path;
+}
+
+std::vector<Trade> trades(size_t count) {
+    std::vector<Trade> out(count);
+    double balance = 100000.0;
+    for (size_t i = 0; i < count; ++i) {
+        Trade& t = out[i];
+        t.timestamp = "2024-03-" + std::to_string(10 + i % 18) + " 10:" + std::to_string(10 + i % 50) + ":00";
+        t.symbol = "NIFTY50";
+        t.signal = i % 2 == 0 ? Signal::BUY : Signal::SELL;
+        t.price = 21000.0 + static_cast<double>(i % 997) * 0.35;
+        t.quantity = 1 + static_cast<int>(i % 7);
+        t.value = t.price * t.quantity;
+        balance += t.signal == Signal::BUY ? -t.value : t.value;
+        t.balance_after = balance;
+    }
+    return out;
+}
+
+void perBar(benchmark::State& state, size_t n) {
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(n));
+}
+}
+
+static void BM_CsvParse(benchmark::State& state) {
+    size_t n = static_cast<size_t>(state.range(0));
+    std::string_view text = csvText(n);
+    std::string_view body = text.substr(skipLine(text));
+    BarSeries series;
+    for (auto _ : state) {
+        series.clear();
+        CsvLoadReport report;
+        parseBarRows(body, 2, series, report);
+        benchmark::DoNotOptimize(series.close().data());
+    }
+    perBar(state, n);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * body.size()));
+}
+
+static void BM_CsvLoad(benchmark::State& state) {
+    size_t n = static_cast<size_t>(state.range(0));
+    const std::string& path = csvFile(n);
+    for (auto _ : state) {
+        MarketDataHandler handler;
+        handler.setVerbose(false);
+        handler.loadFromCSV(path);
+        benchmark::DoNotOptimize(handler.getDataSize());
+    }
+    perBar(state, n);
+}
+
+static void BM_RollingSMA(benchmark::State& state) {
+    size_t n = static_cast<size_t>(state.range(0));
+    Span<const double> closes = bars(n).close();
+    for (auto _ : state) {
+        RollingSMA fast(10), slow(50);
+        double sum = 0;
+        for (double close : closes) {
+            fast.update(close);
+            slow.update(close);
+            sum += fast.value() - slow.value();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    perBar(state, n);
+}
+
+static void BM_RollingRSI(benchmark::State& state) {
+    size_t n = static_cast<size_t>(state.range(0));
+    Span<const double> closes = bars(n).close();
+    for (auto _ : state) {
+        RollingRSI rsi(14);
+        double sum = 0;
+        for (double close : closes) {
+            rsi.update(close);
+            sum += rsi.value();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    perBar(state, n);
+}
+
+static void BM_SignalKernel(benchmark::State& state) {
+    size_t n = static_cast<size_t>(state.range(0));
+    Span<const double> closes = bars(n).close();
+    std::vector<int8_t> signals(n);
+    for (auto _ : state) {
+        SignalKernel kernel(closes);    // prefix sums included
+        kernel.computeSignals(SignalParams(), 0, n, signals.data());
+        benchmark::DoNotOptimize(signals.data());
+    }
+    perBar(state, n);
+}
+
+static void BM_StreamingSignals(benchmark::State& state) {
+    size_t n = static_cast<size_t>(state.range(0));
+    Span<const double> closes = bars(n).close();
+    std::vector<int8_t> signals(n);
+    for (auto _ : state) {
+        RuntimeMACrossoverRSI strategy = makeMACrossoverRSI(SignalParams());
+        generateSignals(strategy, closes, 0, n, signals.data());
+        benchmark::DoNotOptimize(signals.data());
+    }
+    perBar(state, n);
+}
+
+// One buy or sell at every bar's close
+static void BM_BrokerFills(benchmark::State& state) {
+    size_t n = static_cast<size_t>(state.range(0));
+    Span<const double> closes = bars(n).close();
+    const std::string date = "2024-01-01 09:15:00";
+    for (auto _ : state) {
+        BrokerSimulator broker(1e12);
+        broker.setVerbose(false);
+        SymbolId symbol = broker.registerSymbol("SYN1");
+        for (size_t i = 0; i < n; ++i) {
+            if (i % 2 == 0) broker.executeBuy(symbol, 10, closes[i], date);
+            else broker.executeSell(symbol, 10, closes[i], date);
+        }
+        benchmark::DoNotOptimize(broker.getBalance());
+    }
+    perBar(state, n);
+}
+
+// A market order per bar, filled at the next bar's open with costs
+static void BM_MatchingEngineFills(benchmark::State& state) {
+    size_t n = static_cast<size_t>(state.range(0));
+    const BarSeries& series = bars(n);
+    ExecutionSettings settings;
+    settings.brokerage_per_order = 20;
+    settings.brokerage_pct = 0.03;
+    settings.slippage_bps = 2;
+    std::vector<Fill> fills;
+    for (auto _ : state) {
+        MatchingEngine engine(settings);
+        size_t filled = 0;
+        for (size_t i = 0; i < n; ++i) {
+            BarRange bar = {series.open()[i], series.high()[i], series.low()[i], series.close()[i],
+                            series.volume()[i]};
+            fills.clear();
+            filled += engine.match(0, bar, fills);
+            engine.submit(OrderRequest::market(0, i % 2 == 0 ? Signal::BUY : Signal::SELL, 10));
+        }
+        benchmark::DoNotOptimize(filled);
+    }
+    perBar(state, n);
+}
+
+// One trade per 10 bars, kept in memory (formatting and statistics only)
+static void BM_TradeLoggerMemory(benchmark::State& state) {
+    std::vector<Trade> log = trades(static_cast<size_t>(state.range(0)) / 10);
+    for (auto _ : state) {
+        TradeLogger logger("");
+        for (const Trade& trade : log) logger.logTrade(trade);
+        benchmark::DoNotOptimize(logger.calculateStatistics(100000.0, log.back().balance_after));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * log.size()));
+}
+
+// Same trades through the async CSV writer, until the file is complete
+static void BM_TradeLoggerAsyncFile(benchmark::State& state) {
+    std::vector<Trade> log = trades(static_cast<size_t>(state.range(0)) / 10);
+    const std::string path = "trading_benchmarks_trades.csv";
+    for (auto _ : state) {
+        TradeLogger logger(path, true, 100);
+        for (const Trade& trade : log) logger.logTrade(trade);
+        logger.close();
+    }
+    std::remove(path.c_str());
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * log.size()));
+}
+
+static void runBacktest(benchmark::State& state, bool matching_engine) {
+    size_t n = static_cast<size_t>(state.range(0));
+    const BarSeries& series = bars(n);
+    SignalKernel kernel(series.close());
+    BacktestParams params;
+    params.risk_percentage = 50;
+    params.use_matching_engine = matching_engine;
+    params.stop_loss_pct = matching_engine ? 2 : 0;
+    int trades_made = 0;
+    for (auto _ : state) {
+        Backtester backtester(series, params, &kernel);
+        BacktestResult result = backtester.run();
+        trades_made = result.stats.total_trades;
+    }
+    state.counters["trades"] = trades_made;
+    perBar(state, n);
+}
+static void BM_BacktestCloseFills(benchmark::State& state) { runBacktest(state, false); }
+static void BM_BacktestMatchingEngine(benchmark::State& state) { runBacktest(state, true); }
+
+static void BM_Resample(benchmark::State& state) {
+    size_t n = static_cast<size_t>(state.range(0));
+    const BarSeries& series = bars(n);
+    std::vector<BarSpec> specs;
+    specs.push_back(BarSpec::time(300));
+    specs.push_back(BarSpec::time(3600));
+    specs.push_back(BarSpec::time(86400));
+    specs.push_back(BarSpec::volumeBars(2000000));
+    for (auto _ : state) {
+        MultiTimeframeAggregator aggregator(specs);
+        aggregator.addBars(series);
+        aggregator.flush();
+        benchmark::DoNotOptimize(aggregator[0].bars().size());
+    }
+    perBar(state, n);
+}
+
+static void BM_Generate(benchmark::State& state) {
+    size_t n = static_cast<size_t>(state.range(0));
+    std::vector<int64_t> timestamps(n), volume(n);
+    std::vector<double> open(n), high(n), low(n), close(n);
+    GeneratorParams params;
+    params.model = PriceModel::JUMP_DIFFUSION;
+    params.volatility = 0.0005;
+    for (auto _ : state) {
+        MarketGenerator generator(params);
+        generator.generate(n, timestamps.data(), open.data(), high.data(), low.data(), close.data(), volume.data());
+        benchmark::DoNotOptimize(close.data());
+    }
+    perBar(state, n);
+}
+
+#define TRADINGBOT_SIZES ->Arg(1000000)->Arg(10000000)->Unit(benchmark::kMillisecond)
+BENCHMARK(BM_CsvParse) TRADINGBOT_SIZES;
+BENCHMARK(BM_CsvLoad) TRADINGBOT_SIZES->UseRealTime();
+BENCHMARK(BM_RollingSMA) TRADINGBOT_SIZES;
+BENCHMARK(BM_RollingRSI) TRADINGBOT_SIZES;
+BENCHMARK(BM_SignalKernel) TRADINGBOT_SIZES;
+BENCHMARK(BM_StreamingSignals) TRADINGBOT_SIZES;
+BENCHMARK(BM_BrokerFills) TRADINGBOT_SIZES;
+BENCHMARK(BM_MatchingEngineFills) TRADINGBOT_SIZES;
+BENCHMARK(BM_TradeLoggerMemory) TRADINGBOT_SIZES;
+BENCHMARK(BM_TradeLoggerAsyncFile) TRADINGBOT_SIZES->UseRealTime();
+BENCHMARK(BM_BacktestCloseFills) TRADINGBOT_SIZES;
+BENCHMARK(BM_BacktestMatchingEngine) TRADINGBOT_SIZES;
+BENCHMARK(BM_Resample) TRADINGBOT_SIZES;
+BENCHMARK(BM_Generate) TRADINGBOT_SIZES;
+
+BENCHMARK_MAIN();
@@ -0,0 +1,69 @@
+#include "AllocationStats.h"
+#include <cstdlib>
+#include <new>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace TradingBot {
+
+namespace {
+thread_local uint64_t tls_allocations = 0;
+thread_local uint64_t tls_bytes = 0;
+}
+
+uint64_t AllocationStats::threadAllocations() {
+    return tls_allocations;
+}
+uint64_t AllocationStats::threadBytes() {
+    return tls_bytes;
+}
+size_t AllocationStats::peakRSSBytes() {
+#if defined(__unix__) || defined(__APPLE__)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+    return static_cast<size_t>(usage.ru_maxrss);          // bytes
+#else
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;   // kilobytes
+#endif
+#else
+    return 0;
+#endif
+}
+
+#if TRADINGBOT_COUNT_ALLOCATIONS
+void* countedAllocate(size_t size) {
+    tls_allocations++;
+    tls_bytes += size;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* countedAllocate(size_t size, size_t alignment) {
+    tls_allocations++;
+    tls_bytes += size;
+    size = (size + alignment - 1) / alignment * alignment;  // aligned_alloc wants a multiple
+    if (void* p = std::aligned_alloc(alignment, size ? size : alignment)) return p;
+    throw std::bad_alloc();
+}
+#endif
+}
+
+#if TRADINGBOT_COUNT_ALLOCATIONS
+void* operator new(size_t size) { return TradingBot::countedAllocate(size); }
+void* operator new[](size_t size) { return TradingBot::countedAllocate(size); }
+void* operator new(size_t size, std::align_val_t alignment) {
+    return TradingBot::countedAllocate(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return TradingBot::countedAllocate(size, static_cast<size_t>(alignment));
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+#endif
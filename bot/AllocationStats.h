@@ -0,0 +1,38 @@
+#ifndef ALLOCATION_STATS_H
+#define ALLOCATION_STATS_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Build with -DTRADINGBOT_COUNT_ALLOCATIONS=0 to keep the standard operator new
+#ifndef TRADINGBOT_COUNT_ALLOCATIONS
+#define TRADINGBOT_COUNT_ALLOCATIONS 1
+#endif
+
+namespace TradingBot {
+
+// Heap allocation accounting. AllocationStats.cpp replaces the global
+// operator new/delete with thin wrappers over malloc/free that bump a
+// per-thread counter (no atomics, no locks), so a run can measure the
+// allocations it made on its own thread while other threads work.
+class AllocationStats {
+public:
+    static bool enabled() { return TRADINGBOT_COUNT_ALLOCATIONS != 0; }
+    static uint64_t threadAllocations();   // operator new calls on this thread so far
+    static uint64_t threadBytes();         // bytes requested by them
+    static size_t peakRSSBytes();          // process high-water resident set (0 if unknown)
+};
+
+// Allocations made on this thread between construction and now
+class AllocationScope {
+public:
+    AllocationScope() : count_(AllocationStats::threadAllocations()), bytes_(AllocationStats::threadBytes()) {}
+    uint64_t allocations() const { return AllocationStats::threadAllocations() - count_; }
+    uint64_t bytes() const { return AllocationStats::threadBytes() - bytes_; }
+private:
+    uint64_t count_;
+    uint64_t bytes_;
+};
+}
+
+#endif
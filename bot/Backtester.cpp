@@ -0,0 +1,117 @@
+#include "Backtester.h"
+#include "Strategy.h"
+#include "RiskManager.h"
+#include "BrokerSimulator.h"
+#include "PerformanceTracker.h"
+#include "TradingHandlers.h"
+#include "AllocationStats.h"
+#include <algorithm>
+#include <iostream>
+
+namespace TradingBot {
+
+BacktestParams BacktestParams::fromConfig(const Config& config) {
+    BacktestParams params;
+    params.short_ma_period = config.getShortMA();
+    params.long_ma_period = config.getLongMA();
+    params.rsi_period = config.getRSIPeriod();
+    params.rsi_upper = config.getRSIUpper();
+    params.rsi_lower = config.getRSILower();
+    params.risk_percentage = config.getRiskPercentage();
+    params.initial_balance = config.getInitialBalance();
+    params.symbol = config.getSymbol();
+    params.use_matching_engine = config.getUseMatchingEngine();
+    params.execution = config.getExecutionSettings();
+    params.stop_loss_pct = config.getStopLossPct();
+    return params;
+}
+
+Backtester::Backtester(const BarSeries& series, const BacktestParams& params, const SignalKernel* kernel)
+    : series_(series), params_(params), kernel_(kernel), verbose_(false), arena_(nullptr), begin_(0),
+      end_(series.size()), equity_curve_(nullptr), fills_(nullptr) {}
+
+BacktestResult Backtester::run() {
+    TradeLogger logger("");
+    return run(logger);
+}
+
+BacktestResult Backtester::run(TradeLogger& logger) {
+    AllocationScope run_allocations;
+    RunArena local_arena(64 * 1024);
+    RunArena& arena = arena_ ? *arena_ : local_arena;
+    Strategy strategy(params_.short_ma_period, params_.long_ma_period, params_.rsi_period,
+                      params_.rsi_upper, params_.rsi_lower);
+    RiskManager riskManager(params_.risk_percentage);
+    BrokerSimulator broker(params_.initial_balance);
+    strategy.setVerbose(verbose_);
+    broker.setVerbose(verbose_);
+    SymbolId symbol = broker.registerSymbol(params_.symbol);  // interned once; fills index by id
+    logger.performance().registerSymbol(params_.symbol);
+
+    size_t total_bars = std::min(end_, series_.size());
+    size_t start = std::max(begin_, static_cast<size_t>(std::max(params_.long_ma_period, 0)));
+    // Equity is marked on every bar for drawdown/Sharpe
+    Span<const int64_t> timestamps = series_.timestamps();
+    if (total_bars > start) {
+        logger.performance().setPeriodsPerYear(PerformanceTracker::periodsPerYear(timestamps[start],
+                                                                                    timestamps[total_bars - 1],
+                                                                                    total_bars - start));
+    }
+    SignalParams signal_params(params_.short_ma_period, params_.long_ma_period, params_.rsi_period,
+                               params_.rsi_upper, params_.rsi_lower);
+    int8_t* batch = nullptr;
+    if (kernel_ && start < total_bars) {
+        batch = arena.allocateArray<int8_t>(total_bars - start);
+        kernel_->computeSignals(signal_params, start, total_bars, batch);
+    }
+
+    // Matching-engine mode: orders placed on one bar's signal fill on later bars
+    CloseExecution close_execution(broker);
+    EngineExecution engine_execution(broker, params_.execution, params_.stop_loss_pct);
+    ExecutionHandler& execution = params_.use_matching_engine ? static_cast<ExecutionHandler&>(engine_execution)
+                                                              : close_execution;
+    SignalHandler signals = kernel_ ? SignalHandler(Span<const int8_t>(batch, batch ? total_bars - start : 0), start,
+                                                    series_, symbol, kernel_, signal_params)
+                                    : SignalHandler(strategy, series_.close());
+    signals.setVerbose(verbose_);
+    RiskHandler risk(riskManager, broker, execution);
+    TradeRecorder recorder(logger, broker);
+    ProgressReporter progress(broker, total_bars);
+    EventEngine events;
+    // A batch filled at the close needs no queue (runCloseChain); verbose runs keep the signal lines
+    bool direct = kernel_ && !params_.use_matching_engine && !verbose_;
+    if (direct) attachCloseChain(events, close_execution, recorder);
+    else attachTradingChain(events, signals, risk, execution, recorder);
+    if (verbose_) events.subscribeBarClose(&progress);
+    std::vector<double> unused_curve;
+    EquityCurveRecorder curve(broker, equity_curve_ ? *equity_curve_ : unused_curve);
+    if (equity_curve_) events.subscribeBarClose(&curve);
+    std::vector<Trade> unused_fills;
+    FillCollector collector(fills_ ? *fills_ : unused_fills);
+    if (fills_) events.subscribe(EventType::FILL, &collector);
+    SeriesFeed feed(series_, symbol, start, total_bars, execution.wantsBars());  // close fills need only closes
+
+    AllocationScope loop_allocations;
+    if (direct) runCloseChain(events, feed, signals, risk);
+    else events.run(feed);
+    uint64_t loop_count = loop_allocations.allocations();
+
+    // Close any remaining positions at the last bar
+    if (total_bars > 0) {
+        Event last;
+        SeriesFeed(series_, symbol, total_bars - 1, total_bars).next(last);
+        execution.flatten(last, events);
+        events.drain();
+    }
+    if (equity_curve_ && !equity_curve_->empty() && start < total_bars) equity_curve_->back() = broker.getBalance();
+    
+    BacktestResult result;
+    result.params = params_;
+    result.final_balance = broker.getBalance();
+    result.stats = logger.calculateStatistics(params_.initial_balance, result.final_balance);
+    result.bars = total_bars > start ? total_bars - start : 0;
+    result.loop_allocations = loop_count;
+    result.allocations = run_allocations.allocations();
+    return result;
+}
+}
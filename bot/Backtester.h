@@ -0,0 +1,91 @@
+#ifndef BACKTESTER_H
+#define BACKTESTER_H
+
+#include <string>
+#include <vector>
+#include "Types.h"
+#include "BarSeries.h"
+#include "Config.h"
+#include "TradeLogger.h"
+#include "SignalKernel.h"
+#include "RunArena.h"
+
+namespace TradingBot {
+
+// Everything one backtest run depends on besides the data
+struct BacktestParams {
+    int short_ma_period;
+    int long_ma_period;
+    int rsi_period;
+    double rsi_upper;
+    double rsi_lower;
+    double risk_percentage;
+    double initial_balance;
+    std::string symbol;
+    bool use_matching_engine;       // fill on the next bar through the MatchingEngine instead of at the close
+    ExecutionSettings execution;
+    double stop_loss_pct;           // engine only: protective sell stop this far below the entry
+    
+    BacktestParams() : short_ma_period(10), long_ma_period(50), rsi_period(14), rsi_upper(70), rsi_lower(30),
+                       risk_percentage(2.0), initial_balance(100000.0), symbol("NIFTY50"),
+                       use_matching_engine(false), stop_loss_pct(0) {}
+    static BacktestParams fromConfig(const Config& config);
+};
+
+struct BacktestResult {
+    BacktestParams params;
+    double final_balance;
+    Statistics stats;
+    // Heap allocations made on the running thread (0 if counting is compiled out)
+    uint64_t allocations;           // whole run, setup included
+    uint64_t loop_allocations;      // inside the bar loop
+    size_t bars;                    // bars the loop visited
+    
+    BacktestResult() : final_balance(0), allocations(0), loop_allocations(0), bars(0) {}
+};
+
+// Single-symbol MA crossover backtest over a read-only series. Each instance
+// owns its Strategy/RiskManager/BrokerSimulator, so many can share one series.
+//
+// The run is a driver on the EventEngine: the series is fed as MARKET events
+// through the same handler chain live and replay modes use (see
+// TradingHandlers.h). With a SignalKernel the whole signal vector is
+// computed up front and the signal handler only looks it up; without one,
+// signals come from the streaming Strategy bar by bar. A kernel can be
+// shared by many backtesters.
+//
+// In matching-engine mode a signal places a market order that fills at the
+// next bar's open (plus slippage and costs), and an optional stop-loss rests
+// in the engine's book while the position is open.
+class Backtester {
+public:
+    Backtester(const BarSeries& series, const BacktestParams& params, const SignalKernel* kernel = nullptr);
+    void setVerbose(bool verbose) { verbose_ = verbose; } // progress, signals and fills on stdout
+    // Scratch memory for the run (signal buffer); reset it between runs. Without
+    // one, each run uses a private arena.
+    void setArena(RunArena* arena) { arena_ = arena; }
+    // Trade bars [begin, end) only; indicators still see the bars before
+    // begin, and whatever is open is closed at bar end - 1
+    void setWindow(size_t begin, size_t end) { begin_ = begin; end_ = end; }
+    // Equity at every traded bar's close appended to `curve` (its last point
+    // is the balance once the final position is closed); reserve it up front
+    // to keep the bar loop free of allocations
+    void setEquityCurve(std::vector<double>* curve) { equity_curve_ = curve; }
+    // Every fill of the run appended to `fills`, the final flatten included
+    void setFills(std::vector<Trade>* fills) { fills_ = fills; }
+    BacktestResult run(TradeLogger& logger);
+    BacktestResult run();  // trades kept in memory only
+private:
+    const BarSeries& series_;
+    BacktestParams params_;
+    const SignalKernel* kernel_;
+    bool verbose_;
+    RunArena* arena_;
+    size_t begin_;
+    size_t end_;
+    std::vector<double>* equity_curve_;
+    std::vector<Trade>* fills_;
+};
+}
+
+#endif
@@ -0,0 +1,209 @@
+#include "BarAggregator.h"
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+namespace TradingBot {
+
+BarAggregator::BarAggregator(const BarSpec& spec)
+    : spec_(spec), in_bar_(false), start_(0), end_(0), open_(0), high_(0), low_(0), close_(0), volume_(0) {
+    // Degenerate sizes would never close (or never stop closing) a bar
+    spec_.seconds = std::max<int64_t>(spec_.seconds, 1);
+    spec_.volume = std::max<int64_t>(spec_.volume, 1);
+    spec_.range = std::max(spec_.range, 0.0);
+}
+
+void BarAggregator::begin(int64_t timestamp, double open) {
+    start_ = barStart(timestamp);
+    end_ = start_ + spec_.seconds;
+    open_ = high_ = low_ = close_ = open;
+    volume_ = 0;
+    in_bar_ = true;
+}
+
+void BarAggregator::addBar(int64_t timestamp, double open, double high, double low, double close, int64_t volume) {
+    switch (spec_.type) {
+    case BarType::TIME:
+        if (in_bar_ && timestamp >= end_) flush();
+        if (!in_bar_) begin(timestamp, open);
+        merge(high, low, close, volume);
+        break;
+    case BarType::VOLUME:
+        if (!in_bar_) begin(timestamp, open);
+        merge(high, low, close, volume);
+        if (volume_ >= spec_.volume) flush();
+        break;
+    case BarType::RANGE:
+        if (!in_bar_) begin(timestamp, open);
+        merge(high, low, close, volume);
+        if (high_ - low_ >= spec_.range) flush();
+        break;
+    }
+}
+
+void BarAggregator::addTick(int64_t timestamp, double price, int64_t size) {
+    if (spec_.type != BarType::VOLUME) {
+        addBar(timestamp, price, price, price, price, size);
+        return;
+    }
+    // Fill the bar in progress and carry the rest of the tick into new ones
+    do {
+        if (!in_bar_) begin(timestamp, price);
+        int64_t take = std::min(size, spec_.volume - volume_);
+        merge(price, price, price, take);
+        size -= take;
+        if (volume_ >= spec_.volume) flush();
+    } while (size > 0);
+}
+
+// Same rules as addBar with the bar in progress held in locals: the members
+// could alias the input columns, which would force a store and reload of
+// the whole bar on every row
+template <typename BreakBefore, typename BreakAfter>
+void BarAggregator::addRows(const BarSeries& series, BreakBefore break_before, BreakAfter break_after) {
+    Span<const int64_t> timestamps = series.timestamps(), volumes = series.volume();
+    Span<const double> opens = series.open(), highs = series.high(), lows = series.low(), closes = series.close();
+    bool in_bar = in_bar_;
+    int64_t start = start_, end = end_, volume = volume_;
+    double open = open_, high = high_, low = low_, close = close_;
+    for (size_t i = 0; i < series.size(); ++i) {
+        if (in_bar && break_before(timestamps[i], end)) {
+            bars_.append(start, open, high, low, close, volume);
+            in_bar = false;
+        }
+        if (!in_bar) {
+            start = barStart(timestamps[i]);
+            end = start + spec_.seconds;
+            open = high = low = opens[i];
+            volume = 0;
+            in_bar = true;
+        }
+        high = std::max(high, highs[i]);
+        low = std::min(low, lows[i]);
+        close = closes[i];
+        volume += volumes[i];
+        if (break_after(high, low, volume)) {
+            bars_.append(start, open, high, low, close, volume);
+            in_bar = false;
+        }
+    }
+    in_bar_ = in_bar;
+    start_ = start;
+    end_ = end;
+    open_ = open;
+    high_ = high;
+    low_ = low;
+    close_ = close;
+    volume_ = volume;
+}
+
+void BarAggregator::addBars(const BarSeries& series) {
+    if (series.empty()) return;
+    const int64_t limit = spec_.volume;
+    const double range = spec_.range;
+    switch (spec_.type) {
+    case BarType::TIME: {
+        // Every bucket the series spans, at most one bar per row
+        Span<const int64_t> timestamps = series.timestamps();
+        int64_t span = timestamps.back() - timestamps[0];
+        if (span >= 0) bars_.reserve(bars_.size() + std::min<size_t>(series.size(), span / spec_.seconds + 1));
+        addRows(series, [](int64_t timestamp, int64_t end) { return timestamp >= end; },
+                [](double, double, int64_t) { return false; });
+        break;
+    }
+    case BarType::VOLUME:
+        addRows(series, [](int64_t, int64_t) { return false; },
+                [limit](double, double, int64_t volume) { return volume >= limit; });
+        break;
+    case BarType::RANGE:
+        addRows(series, [](int64_t, int64_t) { return false; },
+                [range](double high, double low, int64_t) { return high - low >= range; });
+        break;
+    }
+}
+
+void BarAggregator::flush() {
+    if (!in_bar_) return;
+    bars_.append(start_, open_, high_, low_, close_, volume_);
+    in_bar_ = false;
+}
+
+void BarAggregator::takeBars(BarSeries& out) {
+    out.clear();
+    bars_.swap(out);    // keeps out's old capacity for the next bars
+}
+
+MultiTimeframeAggregator::MultiTimeframeAggregator(const std::vector<BarSpec>& specs) {
+    aggregators_.reserve(specs.size());
+    for (const BarSpec& spec : specs) aggregators_.push_back(BarAggregator(spec));
+}
+
+void MultiTimeframeAggregator::addBars(const BarSeries& series) {
+    // Timeframe by timeframe: each pass keeps one bar in registers
+    for (BarAggregator& aggregator : aggregators_) aggregator.addBars(series);
+}
+
+void MultiTimeframeAggregator::flush() {
+    for (BarAggregator& aggregator : aggregators_) aggregator.flush();
+}
+
+std::string describeBarSpec(const BarSpec& spec) {
+    if (spec.type == BarType::VOLUME) return "vol:" + std::to_string(spec.volume);
+    if (spec.type == BarType::RANGE) {
+        std::ostringstream out;
+        out << "range:" << spec.range;
+        return out.str();
+    }
+    if (spec.seconds % 86400 == 0) return std::to_string(spec.seconds / 86400) + "d";
+    if (spec.seconds % 3600 == 0) return std::to_string(spec.seconds / 3600) + "h";
+    if (spec.seconds % 60 == 0) return std::to_string(spec.seconds / 60) + "m";
+    return std::to_string(spec.seconds) + "s";
+}
+
+bool isTickHeader(std::string_view header) {
+    return std::count(header.begin(), header.end(), ',') < 3;
+}
+
+// One trimmed, non-empty Date,Price[,Size] row; false means malformed
+static bool parseTickRow(std::string_view line, int64_t& timestamp, double& price, int64_t& size) {
+    size_t first = line.find(',');
+    if (first == std::string_view::npos) return false;
+    size_t second = line.find(',', first + 1);
+    std::string_view price_field = line.substr(first + 1, second == std::string_view::npos ? second : second - first - 1);
+    size = 0;
+    if (!parseTimestamp(trimView(line.substr(0, first)), timestamp) || !parseDouble(trimView(price_field), price)) {
+        return false;
+    }
+    if (second != std::string_view::npos) {
+        std::string_view size_field = trimView(line.substr(second + 1));
+        if (!size_field.empty() && !parseInt64(size_field, size)) return false;
+    }
+    return price > 0;
+}
+
+size_t aggregateTickRows(std::string_view text, size_t first_line_number, MultiTimeframeAggregator& out,
+                         CsvLoadReport& report) {
+    size_t pos = 0;
+    size_t line_number = first_line_number;
+    while (pos < text.size()) {
+        const char* nl = static_cast<const char*>(std::memchr(text.data() + pos, '\n', text.size() - pos));
+        size_t end = nl ? static_cast<size_t>(nl - text.data()) : text.size();
+        std::string_view line = trimView(text.substr(pos, end - pos));
+        if (!line.empty()) {
+            report.lines++;
+            int64_t timestamp, size;
+            double price;
+            if (parseTickRow(line, timestamp, price, size)) {
+                out.addTick(timestamp, price, size);
+                report.loaded++;
+            } else {
+                if (report.malformed == 0) report.first_malformed_line = line_number;
+                report.malformed++;
+            }
+        }
+        pos = end + 1;
+        line_number++;
+    }
+    return line_number - first_line_number;
+}
+}
@@ -0,0 +1,98 @@
+#ifndef BAR_AGGREGATOR_H
+#define BAR_AGGREGATOR_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Types.h"
+#include "BarSeries.h"
+#include "CsvParser.h"
+
+namespace TradingBot {
+
+// Streaming resampler for one output timeframe. Feed it trade ticks or
+// finer bars in time order and it appends each completed bar to bars();
+// the only state is the bar in progress, so any length of input is one
+// pass in constant memory (drain bars() with takeBars() to bound the
+// output too).
+//
+//   TIME    bars are stamped with the start of their bucket; empty buckets
+//           produce no bar
+//   VOLUME  bars are stamped with their first input; a tick larger than the
+//           room left is split across bars so each holds exactly `volume`
+//           units, while an input bar is never split (the bar closes once
+//           its total reaches `volume`)
+//   RANGE   bars close on the first input that takes high - low to `range`
+//
+// An input older than the bar in progress is folded into it.
+class BarAggregator {
+public:
+    explicit BarAggregator(const BarSpec& spec);
+    void addTick(int64_t timestamp, double price, int64_t size);
+    void addBar(int64_t timestamp, double open, double high, double low, double close, int64_t volume);
+    void addBars(const BarSeries& series);  // every row of `series`, as addBar would
+    void flush();                           // complete the bar in progress, if any
+    const BarSeries& bars() const { return bars_; }   // completed bars
+    void takeBars(BarSeries& out);          // moves the completed bars into `out` (replacing it)
+    bool hasOpenBar() const { return in_bar_; }
+    const BarSpec& spec() const { return spec_; }
+private:
+    BarSpec spec_;
+    BarSeries bars_;
+    bool in_bar_;
+    int64_t start_;         // timestamp of the bar in progress
+    int64_t end_;           // TIME: first timestamp of the next bucket
+    double open_, high_, low_, close_;
+    int64_t volume_;
+
+    int64_t barStart(int64_t timestamp) const {     // TIME: start of the bucket
+        if (spec_.type != BarType::TIME) return timestamp;
+        int64_t offset = timestamp % spec_.seconds;
+        return timestamp - (offset < 0 ? offset + spec_.seconds : offset);
+    }
+    void begin(int64_t timestamp, double open);
+    template <typename BreakBefore, typename BreakAfter>
+    void addRows(const BarSeries& series, BreakBefore break_before, BreakAfter break_after);
+    void merge(double high, double low, double close, int64_t volume) {
+        if (high > high_) high_ = high;
+        if (low < low_) low_ = low;
+        close_ = close;
+        volume_ += volume;
+    }
+};
+
+// Several timeframes fed from one input stream, e.g. 5m, 1h and 1d bars
+// from a single read of a tick file
+class MultiTimeframeAggregator {
+public:
+    explicit MultiTimeframeAggregator(const std::vector<BarSpec>& specs);
+    void addTick(int64_t timestamp, double price, int64_t size) {
+        for (BarAggregator& aggregator : aggregators_) aggregator.addTick(timestamp, price, size);
+    }
+    void addBar(int64_t timestamp, double open, double high, double low, double close, int64_t volume) {
+        for (BarAggregator& aggregator : aggregators_) aggregator.addBar(timestamp, open, high, low, close, volume);
+    }
+    void addBars(const BarSeries& series);  // every row of `series`, in order
+    void flush();
+    size_t size() const { return aggregators_.size(); }
+    BarAggregator& operator[](size_t i) { return aggregators_[i]; }
+    const BarAggregator& operator[](size_t i) const { return aggregators_[i]; }
+private:
+    std::vector<BarAggregator> aggregators_;
+};
+
+// "5m", "1h", "vol:50000", "range:25" (the bar_timeframes syntax)
+std::string describeBarSpec(const BarSpec& spec);
+
+// True if a CSV header names tick columns (Date,Price[,Size]) rather than
+// the Date,Open,High,Low,Close[,Volume] bar layout
+bool isTickHeader(std::string_view header);
+// Parse Date,Price[,Size] rows (Size defaults to 0) straight into `out`
+// without storing the ticks; same report and return value as parseBarRows
+size_t aggregateTickRows(std::string_view text, size_t first_line_number, MultiTimeframeAggregator& out,
+                         CsvLoadReport& report);
+}
+
+#endif
@@ -0,0 +1,129 @@
+#include "BarCache.h"
+#include "MappedFile.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <system_error>
+
+namespace TradingBot {
+
+static const char kMagic[8] = {'T', 'B', 'B', 'A', 'R', 'S', 0, 0};
+static_assert(sizeof(BarCacheHeader) == 64, "cache header must stay 64 bytes");
+
+static bool hostIsLittleEndian() {
+    const uint16_t probe = 1;
+    unsigned char first;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+// 64-bit multiply-xorshift over 8-byte words; several GB/s, plenty to catch
+// truncated or corrupted files (not meant to be cryptographic). Every column
+// is a whole number of words, so columns can be folded in one at a time.
+static uint64_t checksumInit(uint64_t rows) {
+    return 0x9E3779B97F4A7C15ULL ^ rows;
+}
+static uint64_t checksumUpdate(uint64_t h, const void* data, size_t words) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < words; ++i) {
+        uint64_t w;
+        std::memcpy(&w, bytes + i * 8, 8);
+        h = (h ^ w) * 0xBF58476D1CE4E5B9ULL;
+        h ^= h >> 31;
+    }
+    return h;
+}
+
+static bool sourceStamp(const std::string& csv_path, uint64_t& size, int64_t& mtime) {
+    std::error_code ec;
+    size = static_cast<uint64_t>(std::filesystem::file_size(csv_path, ec));
+    if (ec) return false;
+    auto written = std::filesystem::last_write_time(csv_path, ec);
+    if (ec) return false;
+    mtime = static_cast<int64_t>(written.time_since_epoch().count());
+    return true;
+}
+
+std::string BarCache::cachePathFor(const std::string& csv_path) {
+    return csv_path + ".bars";
+}
+
+bool BarCache::load(const std::string& csv_path, BarSeries& out) {
+    if (!hostIsLittleEndian()) return false;
+    uint64_t source_size;
+    int64_t source_mtime;
+    if (!sourceStamp(csv_path, source_size, source_mtime)) return false;
+
+    auto file = std::make_shared<MappedFile>();
+    if (!file->open(cachePathFor(csv_path)) || file->size() < sizeof(BarCacheHeader)) return false;
+    BarCacheHeader header;
+    std::memcpy(&header, file->data(), sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion ||
+        header.header_size != sizeof(BarCacheHeader) || header.source_size != source_size ||
+        header.source_mtime != source_mtime) {
+        return false;
+    }
+    uint64_t rows = header.row_count;
+    if ((file->size() - sizeof(header)) / 48 < rows) return false;  // truncated
+    const unsigned char* columns = reinterpret_cast<const unsigned char*>(file->data()) + sizeof(header);
+    if (checksumUpdate(checksumInit(rows), columns, static_cast<size_t>(rows) * 6) != header.checksum) return false;
+
+    // The mapping is page-aligned and the header is 64 bytes, so every
+    // column starts 8-byte aligned and can be viewed in place
+    size_t n = static_cast<size_t>(rows);
+    const int64_t* ts = reinterpret_cast<const int64_t*>(columns);
+    const double* open = reinterpret_cast<const double*>(ts + n);
+    const double* high = open + n;
+    const double* low = high + n;
+    const double* close = low + n;
+    const int64_t* volume = reinterpret_cast<const int64_t*>(close + n);
+    out = BarSeries::view(file, n, ts, open, high, low, close, volume);
+    return true;
+}
+
+bool BarCache::save(const std::string& csv_path, const BarSeries& series) {
+    if (!hostIsLittleEndian()) return false;
+    BarCacheHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.header_size = sizeof(BarCacheHeader);
+    header.row_count = series.size();
+    if (!sourceStamp(csv_path, header.source_size, header.source_mtime)) return false;
+
+    // Columns in on-disk order; the checksum covers them in that order
+    size_t n = series.size();
+    const void* columns[6] = {series.timestamps().data(), series.open().data(), series.high().data(),
+                              series.low().data(), series.close().data(), series.volume().data()};
+    uint64_t h = checksumInit(n);
+    for (const void* column : columns) {
+        h = checksumUpdate(h, column, n);
+    }
+    header.checksum = h;
+
+    std::string path = cachePathFor(csv_path);
+    std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) return false;
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (const void* column : columns) {
+            out.write(static_cast<const char*>(column), static_cast<std::streamsize>(n * 8));
+        }
+        if (!out) {
+            out.close();
+            std::remove(tmp_path.c_str());
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, path, ec);
+    if (ec) {
+        std::remove(tmp_path.c_str());
+        return false;
+    }
+    return true;
+}
+}
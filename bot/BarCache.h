@@ -0,0 +1,39 @@
+#ifndef BAR_CACHE_H
+#define BAR_CACHE_H
+
+#include <cstdint>
+#include <string>
+#include "BarSeries.h"
+
+namespace TradingBot {
+
+// Binary columnar sidecar for a parsed CSV ("<csv>.bars").
+//
+// Layout, little-endian: a 64-byte header followed by six row_count-long
+// columns in order timestamps(int64), open, high, low, close(double),
+// volume(int64). The header pins the source file's size and mtime, so a
+// changed CSV invalidates the cache, and carries a checksum of the columns.
+struct BarCacheHeader {
+    char magic[8];          // "TBBARS\0\0"
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t row_count;
+    uint64_t source_size;
+    int64_t source_mtime;   // filesystem clock ticks of the source file
+    uint64_t checksum;      // of the column payload
+    uint64_t reserved[2];
+};
+
+class BarCache {
+public:
+    static const uint32_t kVersion = 1;
+    static std::string cachePathFor(const std::string& csv_path);
+    // Map the cache for csv_path if it exists and matches the source; the
+    // returned series views the mapping directly
+    static bool load(const std::string& csv_path, BarSeries& out);
+    // Write the cache next to csv_path (via a temp file + rename)
+    static bool save(const std::string& csv_path, const BarSeries& series);
+};
+}
+
+#endif
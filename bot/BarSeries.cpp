@@ -0,0 +1,306 @@
+#include "BarSeries.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+#include <stdexcept>
+
+namespace TradingBot {
+
+BarSeries BarSeries::view(std::shared_ptr<const void> owner, size_t rows, const int64_t* timestamps,
+                          const double* open, const double* high, const double* low,
+                          const double* close, const int64_t* volume) {
+    BarSeries series;
+    series.owner_ = std::move(owner);
+    series.external_.timestamps = Span<const int64_t>(timestamps, rows);
+    series.external_.open = Span<const double>(open, rows);
+    series.external_.high = Span<const double>(high, rows);
+    series.external_.low = Span<const double>(low, rows);
+    series.external_.close = Span<const double>(close, rows);
+    series.external_.volume = Span<const int64_t>(volume, rows);
+    return series;
+}
+void BarSeries::detach() {
+    timestamps_.assign(external_.timestamps.begin(), external_.timestamps.end());
+    open_.assign(external_.open.begin(), external_.open.end());
+    high_.assign(external_.high.begin(), external_.high.end());
+    low_.assign(external_.low.begin(), external_.low.end());
+    close_.assign(external_.close.begin(), external_.close.end());
+    volume_.assign(external_.volume.begin(), external_.volume.end());
+    owner_.reset();
+    external_ = ExternalColumns();
+}
+void BarSeries::reserve(size_t n) {
+    if (owner_) detach();
+    timestamps_.reserve(n);
+    open_.reserve(n);
+    high_.reserve(n);
+    low_.reserve(n);
+    close_.reserve(n);
+    volume_.reserve(n);
+}
+void BarSeries::append(int64_t timestamp, double open, double high, double low,
+                       double close, int64_t volume) {
+    if (owner_) detach();
+    timestamps_.push_back(timestamp);
+    open_.push_back(open);
+    high_.push_back(high);
+    low_.push_back(low);
+    close_.push_back(close);
+    volume_.push_back(volume);
+}
+void BarSeries::append(const BarSeries& other) {
+    if (owner_) detach();
+    timestamps_.insert(timestamps_.end(), other.timestamps().begin(), other.timestamps().end());
+    open_.insert(open_.end(), other.open().begin(), other.open().end());
+    high_.insert(high_.end(), other.high().begin(), other.high().end());
+    low_.insert(low_.end(), other.low().begin(), other.low().end());
+    close_.insert(close_.end(), other.close().begin(), other.close().end());
+    volume_.insert(volume_.end(), other.volume().begin(), other.volume().end());
+}
+void BarSeries::swap(BarSeries& other) {
+    timestamps_.swap(other.timestamps_);
+    open_.swap(other.open_);
+    high_.swap(other.high_);
+    low_.swap(other.low_);
+    close_.swap(other.close_);
+    volume_.swap(other.volume_);
+    owner_.swap(other.owner_);
+    std::swap(external_, other.external_);
+}
+bool BarSeries::isSorted() const {
+    Span<const int64_t> ts = timestamps();
+    return std::is_sorted(ts.begin(), ts.end());
+}
+template <typename T>
+static void applyPermutation(std::vector<T>& column, const std::vector<size_t>& order) {
+    std::vector<T> sorted(column.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        sorted[i] = column[order[i]];
+    }
+    column.swap(sorted);
+}
+void BarSeries::sortByTime() {
+    if (owner_) detach();
+    std::vector<size_t> order(size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [this](size_t a, size_t b) { return timestamps_[a] < timestamps_[b]; });
+    applyPermutation(timestamps_, order);
+    applyPermutation(open_, order);
+    applyPermutation(high_, order);
+    applyPermutation(low_, order);
+    applyPermutation(close_, order);
+    applyPermutation(volume_, order);
+}
+void BarSeries::clear() {
+    owner_.reset();
+    external_ = ExternalColumns();
+    timestamps_.clear();
+    open_.clear();
+    high_.clear();
+    low_.clear();
+    close_.clear();
+    volume_.clear();
+}
+OHLCV BarSeries::barAt(size_t index) const {
+    if (index >= size()) {
+        throw std::out_of_range("Index out of range in bar series");
+    }
+    OHLCV bar;
+    bar.date = formatTimestamp(timestamps()[index]);
+    bar.open = open()[index];
+    bar.high = high()[index];
+    bar.low = low()[index];
+    bar.close = close()[index];
+    bar.volume = volume()[index];
+    return bar;
+}
+std::string BarSeries::dateAt(size_t index) const {
+    if (index >= size()) {
+        throw std::out_of_range("Index out of range in bar series");
+    }
+    return formatTimestamp(timestamps()[index]);
+}
+void BarSeries::dateAt(size_t index, std::string& out) const {
+    if (index >= size()) {
+        throw std::out_of_range("Index out of range in bar series");
+    }
+    formatTimestamp(timestamps()[index], out);
+}
+
+// Days since 1970-01-01 for a proleptic Gregorian date (H. Hinnant's algorithm)
+static int64_t daysFromCivil(int64_t y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+static void civilFromDays(int64_t z, int64_t& y, unsigned& m, unsigned& d) {
+    z += 719468;
+    const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(z - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    d = doy - (153 * mp + 2) / 5 + 1;
+    m = mp < 10 ? mp + 3 : mp - 9;
+    y = static_cast<int64_t>(yoe) + era * 400 + (m <= 2);
+}
+
+static bool readDigits(std::string_view s, size_t pos, size_t count, int& out) {
+    if (pos + count > s.size()) return false;
+    out = 0;
+    for (size_t i = pos; i < pos + count; ++i) {
+        if (s[i] < '0' || s[i] > '9') return false;
+        out = out * 10 + (s[i] - '0');
+    }
+    return true;
+}
+
+bool parseTimestamp(std::string_view text, int64_t& epoch_seconds) {
+    int year, month, day;
+    if (!readDigits(text, 0, 4, year) || text.size() < 10 || text[4] != '-' ||
+        !readDigits(text, 5, 2, month) || text[7] != '-' || !readDigits(text, 8, 2, day)) {
+        return false;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > 31) return false;
+    int hour = 0, minute = 0, second = 0;
+    if (text.size() > 10) {
+        if ((text[10] != ' ' && text[10] != 'T') || !readDigits(text, 11, 2, hour) ||
+            text.size() < 16 || text[13] != ':' || !readDigits(text, 14, 2, minute)) {
+            return false;
+        }
+        if (text.size() > 16) {
+            if (text.size() < 19 || text[16] != ':' || !readDigits(text, 17, 2, second)) {
+                return false;
+            }
+            // Fractional seconds (tick data) are accepted and truncated
+            if (text.size() > 19) {
+                if (text[19] != '.' || text.size() == 20) return false;
+                for (size_t i = 20; i < text.size(); ++i) {
+                    if (text[i] < '0' || text[i] > '9') return false;
+                }
+            }
+        }
+        if (hour > 23 || minute > 59 || second > 60) return false;
+    }
+    epoch_seconds = daysFromCivil(year, static_cast<unsigned>(month), static_cast<unsigned>(day)) * 86400
+                    + hour * 3600 + minute * 60 + second;
+    return true;
+}
+
+std::string formatTimestamp(int64_t epoch_seconds) {
+    std::string out;
+    formatTimestamp(epoch_seconds, out);
+    return out;
+}
+
+// Writes `value` as exactly `width` digits (zero padded)
+static char* putDigits(char* p, unsigned value, int width) {
+    for (int i = width - 1; i >= 0; --i) {
+        p[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+    return p + width;
+}
+
+void formatTimestamp(int64_t epoch_seconds, std::string& out) {
+    int64_t days = epoch_seconds / 86400;
+    int64_t secs = epoch_seconds % 86400;
+    if (secs < 0) {
+        secs += 86400;
+        days--;
+    }
+    int64_t y;
+    unsigned m, d;
+    civilFromDays(days, y, m, d);
+    if (y < 0 || y > 9999) {  // outside what the fixed-width path writes
+        char buf[48];
+        int len;
+        if (secs == 0) {
+            len = std::snprintf(buf, sizeof(buf), "%04lld-%02u-%02u", static_cast<long long>(y), m, d);
+        } else {
+            len = std::snprintf(buf, sizeof(buf), "%04lld-%02u-%02u %02d:%02d:%02d", static_cast<long long>(y), m, d,
+                                static_cast<int>(secs / 3600), static_cast<int>(secs / 60 % 60), static_cast<int>(secs % 60));
+        }
+        out.assign(buf, static_cast<size_t>(len > 0 ? len : 0));
+        return;
+    }
+    // Digits are written directly: this runs for every fill, and snprintf
+    // was most of the cost of booking a trade
+    char buf[20];
+    char* p = putDigits(buf, static_cast<unsigned>(y), 4);
+    *p++ = '-';
+    p = putDigits(p, m, 2);
+    *p++ = '-';
+    p = putDigits(p, d, 2);
+    if (secs != 0) {
+        unsigned s = static_cast<unsigned>(secs);
+        *p++ = ' ';
+        p = putDigits(p, s / 3600, 2);
+        *p++ = ':';
+        p = putDigits(p, s / 60 % 60, 2);
+        *p++ = ':';
+        p = putDigits(p, s % 60, 2);
+    }
+    out.assign(buf, static_cast<size_t>(p - buf));
+}
+
+// Values too close to a rounding tie (or huge) go through snprintf itself
+void appendFixed2(std::string& out, double value) {
+    double scaled = value * 100.0;
+    double rounded = std::nearbyint(scaled);
+    if (!(std::abs(scaled) < 1e15) || std::abs(std::abs(scaled - rounded) - 0.5) < 1e-3) {
+        char buf[64];
+        int len = std::snprintf(buf, sizeof(buf), "%.2f", value);
+        out.append(buf, static_cast<size_t>(std::max(len, 0)));
+        return;
+    }
+    long long cents = static_cast<long long>(rounded);
+    if (cents < 0 || (cents == 0 && std::signbit(value))) {
+        out.push_back('-');
+        cents = -cents;
+    }
+    char buf[32];
+    int pos = sizeof(buf);
+    buf[--pos] = static_cast<char>('0' + cents % 10);
+    buf[--pos] = static_cast<char>('0' + cents / 10 % 10);
+    buf[--pos] = '.';
+    long long whole = cents / 100;
+    do {
+        buf[--pos] = static_cast<char>('0' + whole % 10);
+        whole /= 10;
+    } while (whole > 0);
+    out.append(buf + pos, sizeof(buf) - pos);
+}
+
+bool writeBarsCSV(const std::string& path, const BarSeries& series) {
+    std::FILE* out = std::fopen(path.c_str(), "wb");
+    if (!out) return false;
+    std::string text = "Date,Open,High,Low,Close,Volume\n";
+    std::string date;
+    char buffer[32];
+    bool ok = true;
+    for (size_t i = 0; i < series.size() && ok; ++i) {
+        formatTimestamp(series.timestamps()[i], date);
+        text += date;
+        for (double price : {series.open()[i], series.high()[i], series.low()[i], series.close()[i]}) {
+            text.push_back(',');
+            text.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), price).ptr);
+        }
+        text.push_back(',');
+        text += std::to_string(series.volume()[i]);
+        text.push_back('\n');
+        if (text.size() >= (1 << 20) || i + 1 == series.size()) {
+            ok = std::fwrite(text.data(), 1, text.size(), out) == text.size();
+            text.clear();
+        }
+    }
+    if (series.empty()) ok = std::fwrite(text.data(), 1, text.size(), out) == text.size();
+    return std::fclose(out) == 0 && ok;
+}
+}
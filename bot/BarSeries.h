@@ -0,0 +1,101 @@
+#ifndef BAR_SERIES_H
+#define BAR_SERIES_H
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Types.h"
+
+namespace TradingBot {
+
+// Non-owning view over a contiguous array (std::span is C++20)
+template <typename T>
+class Span {
+public:
+    Span() : data_(nullptr), size_(0) {}
+    Span(T* data, size_t size) : data_(data), size_(size) {}
+    template <typename U>
+    Span(const std::vector<U>& v) : data_(v.data()), size_(v.size()) {}
+    T* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    T& operator[](size_t i) const { return data_[i]; }
+    T* begin() const { return data_; }
+    T* end() const { return data_ + size_; }
+    T& back() const { return data_[size_ - 1]; }
+    Span subspan(size_t offset, size_t count) const { return Span(data_ + offset, count); }
+private:
+    T* data_;
+    size_t size_;
+};
+
+// Columnar (structure-of-arrays) bar store. Scans that only need closes touch
+// 8 bytes per bar instead of a whole OHLCV record with its date string.
+//
+// A series either owns its columns or views columns owned by someone else
+// (a memory-mapped cache file); mutating a viewing series copies first.
+class BarSeries {
+public:
+    BarSeries() {}
+    // Read-only series over external columns; `owner` keeps them alive
+    static BarSeries view(std::shared_ptr<const void> owner, size_t rows, const int64_t* timestamps,
+                          const double* open, const double* high, const double* low,
+                          const double* close, const int64_t* volume);
+    void reserve(size_t n);
+    void append(int64_t timestamp, double open, double high, double low, double close, int64_t volume);
+    void append(const BarSeries& other);      // concatenate another series' rows
+    void clear();
+    void swap(BarSeries& other);
+    size_t size() const { return close().size(); }
+    bool empty() const { return size() == 0; }
+    bool isView() const { return owner_ != nullptr; }
+
+    Span<const int64_t> timestamps() const { return owner_ ? external_.timestamps : Span<const int64_t>(timestamps_); }
+    Span<const double> open() const { return owner_ ? external_.open : Span<const double>(open_); }
+    Span<const double> high() const { return owner_ ? external_.high : Span<const double>(high_); }
+    Span<const double> low() const { return owner_ ? external_.low : Span<const double>(low_); }
+    Span<const double> close() const { return owner_ ? external_.close : Span<const double>(close_); }
+    Span<const int64_t> volume() const { return owner_ ? external_.volume : Span<const int64_t>(volume_); }
+
+    bool isSorted() const;                  // timestamps non-decreasing
+    void sortByTime();                      // stable sort of all columns by timestamp
+
+    OHLCV barAt(size_t index) const;        // row view, materialises the date string
+    std::string dateAt(size_t index) const; // formatted timestamp of one bar
+    void dateAt(size_t index, std::string& out) const; // same, reusing out's capacity (no allocation once warm)
+private:
+    std::vector<int64_t> timestamps_;  // seconds since the Unix epoch, UTC
+    std::vector<double> open_;
+    std::vector<double> high_;
+    std::vector<double> low_;
+    std::vector<double> close_;
+    std::vector<int64_t> volume_;
+
+    struct ExternalColumns {
+        Span<const int64_t> timestamps;
+        Span<const double> open, high, low, close;
+        Span<const int64_t> volume;
+    };
+    std::shared_ptr<const void> owner_;  // set while viewing external columns
+    ExternalColumns external_;
+    void detach();                       // copy external columns into owned storage
+};
+
+// "YYYY-MM-DD" with an optional " HH:MM[:SS[.fff]]" / "THH:MM[:SS[.fff]]" time part
+// (fractions of a second are dropped)
+bool parseTimestamp(std::string_view text, int64_t& epoch_seconds);
+// Inverse of parseTimestamp; the time part is omitted at midnight
+std::string formatTimestamp(int64_t epoch_seconds);
+void formatTimestamp(int64_t epoch_seconds, std::string& out);
+// Appends value with two decimals exactly as printf("%.2f") would
+void appendFixed2(std::string& out, double value);
+// The series as a Date,Open,High,Low,Close,Volume file, prices in shortest
+// round-trip form so loading it back gives the same doubles; false if it
+// could not be written
+bool writeBarsCSV(const std::string& path, const BarSeries& series);
+}
+
+#endif
@@ -4,106 +4,134 @@
 
 namespace TradingBot {
 BrokerSimulator::BrokerSimulator(double initial_balance)
-    : balance_(initial_balance), initial_balance_(initial_balance) {}
-bool BrokerSimulator::executeBuy(const std::string& symbol, int quantity, 
-                                  double price, const std::string& date) {
+    : balance_(initial_balance), initial_balance_(initial_balance), last_trade_symbol_(kInvalidSymbol),
+      trade_count_(0), verbose_(true) {
+    last_trade_.timestamp.reserve(32);
+}
+SymbolId BrokerSimulator::registerSymbol(const std::string& symbol) {
+    SymbolId id = symbols_.intern(symbol);
+    if (id >= positions_.size()) {
+        positions_.resize(id + 1);
+        positions_[id].symbol = symbol;
+        positions_[id].entry_date.reserve(32);  // so the first buy does not allocate
+    }
+    return id;
+}
+void BrokerSimulator::recordTrade(SymbolId id, Signal signal, int quantity, double price, double value,
+                                  double fees, const std::string& date) {
+    // Assignments reuse the strings' capacity, so steady-state fills don't allocate
+    last_trade_.timestamp = date;
+    if (id != last_trade_symbol_) {
+        last_trade_.symbol = symbols_.name(id);
+        last_trade_symbol_ = id;
+    }
+    last_trade_.signal = signal;
+    last_trade_.price = price;
+    last_trade_.quantity = quantity;
+    last_trade_.value = value;
+    last_trade_.balance_after = balance_;
+    last_trade_.fees = fees;
+    trade_count_++;
+}
+bool BrokerSimulator::executeBuy(SymbolId id, int quantity, double price, const std::string& date, double fees) {
     double cost = quantity * price;
-        if (cost > balance_) {
-        std::cout << "Insufficient balance for buy order. Required: INR " << cost 
+        if (cost + fees > balance_) {
+        if (verbose_) std::cout << "Insufficient balance for buy order. Required: INR " << cost + fees
                   << ", Available: INR " << balance_ << std::endl;
         return false;
     }
     
     // Execute the buy
-    balance_ -= cost;
+    balance_ -= cost + fees;
     
-    if (positions_.find(symbol) != positions_.end()) {
-        Position& pos = positions_[symbol];
+    Position& pos = positions_[id];
+    if (pos.quantity > 0) {
         double total_cost = (pos.quantity * pos.entry_price) + cost;
         pos.quantity += quantity;
         pos.entry_price = total_cost / pos.quantity;
     } else {
-        Position pos;
-        pos.symbol = symbol;
         pos.quantity = quantity;
         pos.entry_price = price;
         pos.entry_date = date;
-        positions_[symbol] = pos;
     }
     
     // Record the trade
-    last_trade_.timestamp = date;
-    last_trade_.symbol = symbol;
-    last_trade_.signal = Signal::BUY;
-    last_trade_.price = price;
-    last_trade_.quantity = quantity;
-    last_trade_.value = cost;
-    last_trade_.balance_after = balance_;
+    recordTrade(id, Signal::BUY, quantity, price, cost, fees, date);
     
-    std::cout << std::fixed << std::setprecision(2);
-    std::cout << "BUY executed: " << quantity << " shares @ INR " << price 
-              << " | Total: INR " << cost << " | Balance: INR " << balance_ << std::endl;
+    if (verbose_) {
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << "BUY executed: " << quantity << " shares @ INR " << price 
+                  << " | Total: INR " << cost;
+        if (fees > 0) std::cout << " | Fees: INR " << fees;
+        std::cout << " | Balance: INR " << balance_ << std::endl;
+    }
     
     return true;
 }
 
-bool BrokerSimulator::executeSell(const std::string& symbol, int quantity, 
-                                   double price, const std::string& date) {
+bool BrokerSimulator::executeSell(SymbolId id, int quantity, double price, const std::string& date, double fees) {
     // Check if we have a position
-    if (positions_.find(symbol) == positions_.end()) {
-        std::cout << "No position to sell for " << symbol << std::endl;
+    Position& pos = positions_[id];
+    if (pos.quantity <= 0) {
+        if (verbose_) std::cout << "No position to sell for " << symbols_.name(id) << std::endl;
         return false;
     }
     
-    Position& pos = positions_[symbol];
     if (quantity > pos.quantity) {
         quantity = pos.quantity; 
     }
     double revenue = quantity * price;
-    balance_ += revenue;
+    balance_ += revenue - fees;
     
     // Calculate profit/loss
-    double profit_loss = (price - pos.entry_price) * quantity;
+    double profit_loss = (price - pos.entry_price) * quantity - fees;
     
     // Update position
     pos.quantity -= quantity;
     if (pos.quantity == 0) {
-        positions_.erase(symbol);  
+        pos.entry_price = 0;
     }
     
     // Record the trade
-    last_trade_.timestamp = date;
-    last_trade_.symbol = symbol;
-    last_trade_.signal = Signal::SELL;
-    last_trade_.price = price;
-    last_trade_.quantity = quantity;
-    last_trade_.value = revenue;
-    last_trade_.balance_after = balance_;    
-    std::cout << std::fixed << std::setprecision(2);
-    std::cout << "SELL executed: " << quantity << " shares @ INR " << price 
-              << " | Total: INR " << revenue << " | P/L: INR " << profit_loss 
-              << " | Balance: INR " << balance_ << std::endl;    
+    recordTrade(id, Signal::SELL, quantity, price, revenue, fees, date);
+    if (verbose_) {
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << "SELL executed: " << quantity << " shares @ INR " << price 
+                  << " | Total: INR " << revenue;
+        if (fees > 0) std::cout << " | Fees: INR " << fees;
+        std::cout << " | P/L: INR " << profit_loss 
+                  << " | Balance: INR " << balance_ << std::endl;
+    }
     return true;
 }
 
+bool BrokerSimulator::executeBuy(const std::string& symbol, int quantity, 
+                                  double price, const std::string& date) {
+    return executeBuy(registerSymbol(symbol), quantity, price, date);
+}
+bool BrokerSimulator::executeSell(const std::string& symbol, int quantity, 
+                                   double price, const std::string& date) {
+    SymbolId id = symbolId(symbol);
+    if (id == kInvalidSymbol) {
+        if (verbose_) std::cout << "No position to sell for " << symbol << std::endl;
+        return false;
+    }
+    return executeSell(id, quantity, price, date);
+}
 Position BrokerSimulator::getPosition(const std::string& symbol) const {
-    auto it = positions_.find(symbol);
-    if (it != positions_.end()) {
-        return it->second;
+    SymbolId id = symbolId(symbol);
+    if (id != kInvalidSymbol && positions_[id].quantity > 0) {
+        return positions_[id];
     }
     return Position();
 }
 bool BrokerSimulator::hasPosition(const std::string& symbol) const {
-    return positions_.find(symbol) != positions_.end() && 
-           positions_.at(symbol).quantity > 0;
+    SymbolId id = symbolId(symbol);
+    return id != kInvalidSymbol && hasPosition(id);
 }
 double BrokerSimulator::getPortfolioValue(const std::string& symbol, double current_price) const {
-    double portfolio_value = balance_;    
-    if (hasPosition(symbol)) {
-        Position pos = getPosition(symbol);
-        portfolio_value += pos.quantity * current_price;
-    }    
-    return portfolio_value;
+    SymbolId id = symbolId(symbol);
+    return id != kInvalidSymbol ? getPortfolioValue(id, current_price) : balance_;
 }
 
-} 
+}
@@ -1,9 +1,11 @@
 #ifndef BROKER_SIMULATOR_H
 #define BROKER_SIMULATOR_H
 
-#include <map>
+#include <cstdint>
 #include <string>
+#include <vector>
 #include "Types.h"
+#include "SymbolTable.h"
 
 namespace TradingBot {
 
@@ -17,21 +19,49 @@ struct Position {
     Position() : quantity(0), entry_price(0) {}
 };
 
+// Positions live in a dense array indexed by SymbolId. Register symbols up
+// front and use the id overloads on hot paths: they are plain array
+// accesses with no string hashing, comparison or allocation. The string
+// overloads look the id up first and remain for convenience.
 class BrokerSimulator {
 public:
     BrokerSimulator(double initial_balance);
-    bool executeBuy(const std::string& symbol, int quantity, double price, const std::string& date); //buy order
-    bool executeSell(const std::string& symbol, int quantity, double price, const std::string& date); //sell order
-    double getBalance() const { return balance_; } //balance rn
-    Position getPosition(const std::string& symbol) const; //current position
-    bool hasPosition(const std::string& symbol) const; //open position
+    SymbolId registerSymbol(const std::string& symbol); // id for symbol, adding a flat position slot
+    SymbolId symbolId(const std::string& symbol) const { return symbols_.find(symbol); } // kInvalidSymbol if unknown
+    const std::string& symbolName(SymbolId id) const { return symbols_.name(id); }
+
+    // fees (brokerage/taxes) come out of the balance on top of the traded value
+    bool executeBuy(SymbolId id, int quantity, double price, const std::string& date, double fees = 0.0); //buy order
+    bool executeSell(SymbolId id, int quantity, double price, const std::string& date, double fees = 0.0); //sell order
+    bool hasPosition(SymbolId id) const { return positions_[id].quantity > 0; } //open position
+    const Position& position(SymbolId id) const { return positions_[id]; } //current position (quantity 0 = flat)
+    double getPortfolioValue(SymbolId id, double current_price) const {
+        return balance_ + positions_[id].quantity * current_price;
+    }
+
+    bool executeBuy(const std::string& symbol, int quantity, double price, const std::string& date);
+    bool executeSell(const std::string& symbol, int quantity, double price, const std::string& date);
+    Position getPosition(const std::string& symbol) const;
+    bool hasPosition(const std::string& symbol) const;
     double getPortfolioValue(const std::string& symbol, double current_price) const; //portfolio value
+
+    double getBalance() const { return balance_; } //balance rn
+    double getInitialBalance() const { return initial_balance_; }
+    const std::vector<Position>& getPositions() const { return positions_; } //indexed by SymbolId
     const Trade& getLastTrade() const { return last_trade_; }    //last trade
+    uint64_t tradeCount() const { return trade_count_; }          //trades booked so far
+    void setVerbose(bool verbose) { verbose_ = verbose; } // print fills to the console
 private:
     double balance_;
     double initial_balance_;
-    std::map<std::string, Position> positions_;
+    SymbolTable symbols_;
+    std::vector<Position> positions_;
     Trade last_trade_;
+    SymbolId last_trade_symbol_;    // last_trade_.symbol is only rewritten when this changes
+    uint64_t trade_count_;
+    bool verbose_;
+    void recordTrade(SymbolId id, Signal signal, int quantity, double price, double value, double fees,
+                     const std::string& date);
 };
 } 
 
@@ -1,7 +1,9 @@
 #include "Config.h"
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <sstream>
+#include <stdexcept>
 
 namespace TradingBot {
 Config::Config() {
@@ -14,10 +16,152 @@ void Config::setDefaults() {
     symbol_ = "NIFTY50";
     short_ma_period_ = 10;            // 10-day moving average
     long_ma_period_ = 50;             // 50-day moving average
+    rsi_period_ = 14;
+    rsi_upper_ = 70.0;                // overbought: no new buys above
+    rsi_lower_ = 30.0;                // oversold: no sells below
     mode_ = Mode::BACKTEST;
     // Defaults for live simulation
     live_iterations_ = 100;
     live_history_size_ = 200;
+    live_feed_rate_ = 2.0;            // one bar every 500 ms
+    live_print_bars_ = true;
+    latency_dump_file_.clear();
+    live_record_file_.clear();
+    replay_speed_ = 0;                // replay at live_feed_rate
+    replay_file_.clear();
+    load_threads_ = 0;                // 0 = use every core for large files
+    async_logging_ = true;            // trade log written by a background thread
+    log_flush_interval_ms_ = 100;
+    binary_trade_log_ = false;        // CSV trade logs
+    vectorized_signals_ = true;       // whole-series signal kernel in backtests
+    use_data_cache_ = true;           // binary sidecar next to the CSV
+    rebuild_cache_ = false;
+    // Defaults for order execution (costs only apply with the matching engine)
+    use_matching_engine_ = false;
+    execution_ = ExecutionSettings();
+    stop_loss_pct_ = 0;
+    // Defaults for parameter sweeps (single values = not swept)
+    sweep_short_ma_ = ParameterRange(5, 20, 5);
+    sweep_long_ma_ = ParameterRange(30, 60, 10);
+    sweep_rsi_period_ = ParameterRange(14);
+    sweep_rsi_upper_ = ParameterRange(70);
+    sweep_rsi_lower_ = ParameterRange(30);
+    sweep_risk_set_ = false;
+    sweep_threads_ = 0;               // 0 = all cores
+    sweep_top_ = 20;
+    // Defaults for portfolio runs (empty list = the single configured symbol)
+    portfolio_symbols_.clear();
+    portfolio_data_dir_ = "data";
+    portfolio_threads_ = 0;           // 0 = all cores
+    // Defaults for sharded live runs (shards = symbols x sweep combinations)
+    shard_symbols_ = 8;
+    shard_bars_ = 10000;
+    shard_threads_ = 0;               // 0 = all cores
+    shard_pin_threads_ = true;
+    shard_feed_rate_ = 0;             // unthrottled
+    // Defaults for walk-forward runs: half a year of daily bars to train, two months to test
+    walkforward_train_bars_ = 120;
+    walkforward_test_bars_ = 40;
+    walkforward_anchored_ = false;    // rolling train window
+    walkforward_objective_ = "pnl";
+    // Defaults for Monte Carlo runs: a month of daily bars per block, 5 bps mean slippage
+    monte_carlo_runs_ = 1000;
+    monte_carlo_seed_ = 42;
+    monte_carlo_block_bars_ = 20;
+    monte_carlo_slippage_bps_ = 5;
+    monte_carlo_threads_ = 0;         // 0 = all cores
+    // Defaults for synthetic bars: GBM at 0.5% per bar, fixed seed
+    generator_ = GeneratorParams();
+    bar_timeframes_.clear();          // trade the file's own bars
+}
+ParameterRange Config::getSweepRiskPercentage() const {
+    return sweep_risk_set_ ? sweep_risk_percentage_ : ParameterRange(risk_percentage_);
+}
+std::vector<SymbolSource> Config::getPortfolioSymbols() const {
+    std::vector<SymbolSource> sources;
+    std::stringstream list(portfolio_symbols_);
+    std::string item;
+    while (std::getline(list, item, ',')) {
+        item.erase(0, item.find_first_not_of(" \t"));
+        item.erase(item.find_last_not_of(" \t") + 1);
+        if (item.empty()) continue;
+        size_t colon = item.find(':');
+        if (colon == std::string::npos) {
+            sources.push_back(SymbolSource(item, portfolio_data_dir_ + "/" + item + ".csv"));
+        } else {
+            sources.push_back(SymbolSource(item.substr(0, colon), item.substr(colon + 1)));
+        }
+    }
+    if (sources.empty()) {
+        sources.push_back(SymbolSource(symbol_, data_file_path_));
+    }
+    return sources;
+}
+ParameterRange Config::parseRange(const std::string& value) {
+    size_t first = value.find(':');
+    if (first == std::string::npos) {
+        return ParameterRange(std::stod(value));
+    }
+    size_t second = value.find(':', first + 1);
+    double start = std::stod(value.substr(0, first));
+    double end = std::stod(value.substr(first + 1, second == std::string::npos ? std::string::npos : second - first - 1));
+    double step = second == std::string::npos ? 1.0 : std::stod(value.substr(second + 1));
+    return ParameterRange(start, end, step);
+}
+// "drift:volatility:switch_probability,..." per regime
+std::vector<MarketRegime> Config::parseRegimes(const std::string& value) {
+    std::vector<MarketRegime> regimes;
+    std::stringstream list(value);
+    std::string item;
+    while (std::getline(list, item, ',')) {
+        size_t first = item.find(':');
+        size_t second = first == std::string::npos ? std::string::npos : item.find(':', first + 1);
+        if (second == std::string::npos) {
+            throw std::invalid_argument("regime needs drift:volatility:switch_probability");
+        }
+        regimes.push_back(MarketRegime(std::stod(item.substr(0, first)),
+                                       std::stod(item.substr(first + 1, second - first - 1)),
+                                       std::stod(item.substr(second + 1))));
+    }
+    return regimes;
+}
+// "30s,5m,1h,1d,vol:50000,range:25": N seconds/minutes/hours/days, volume or range bars
+std::vector<BarSpec> Config::parseTimeframes(const std::string& value) {
+    std::vector<BarSpec> specs;
+    std::stringstream list(value);
+    std::string item;
+    while (std::getline(list, item, ',')) {
+        item.erase(0, item.find_first_not_of(" \t"));
+        item.erase(item.find_last_not_of(" \t") + 1);
+        if (item.empty()) continue;
+        size_t used = 0;
+        if (item.compare(0, 4, "vol:") == 0) {
+            long long volume = std::stoll(item.substr(4), &used);
+            if (volume <= 0 || used != item.size() - 4) throw std::invalid_argument("bad volume bar size");
+            specs.push_back(BarSpec::volumeBars(volume));
+        } else if (item.compare(0, 6, "range:") == 0) {
+            double range = std::stod(item.substr(6), &used);
+            if (!(range > 0) || used != item.size() - 6) throw std::invalid_argument("bad range bar size");
+            specs.push_back(BarSpec::rangeBars(range));
+        } else {
+            long long count = std::stoll(item, &used);
+            std::string unit = item.substr(used);
+            long long seconds = unit == "s" ? 1 : unit == "m" ? 60 : unit == "h" ? 3600 : unit == "d" ? 86400 : 0;
+            if (count <= 0 || seconds == 0) throw std::invalid_argument("timeframe needs a count and s/m/h/d");
+            specs.push_back(BarSpec::time(count * seconds));
+        }
+    }
+    return specs;
+}
+// "max" (unthrottled) -> infinity, "1000x" or "1000" -> 1000, "0" -> 0
+double Config::parseSpeed(const std::string& value) {
+    if (value == "max") return std::numeric_limits<double>::infinity();
+    size_t used = 0;
+    double speed = std::stod(value, &used);
+    if (speed < 0 || (used < value.size() && value.substr(used) != "x")) {
+        throw std::invalid_argument("speed needs a non-negative multiple or max");
+    }
+    return speed;
 }
 bool Config::loadFromFile(const std::string& filename) {
     std::ifstream file(filename);
@@ -51,12 +195,146 @@ bool Config::loadFromFile(const std::string& filename) {
                 short_ma_period_ = std::stoi(value);
             } else if (key == "long_ma_period") {
                 long_ma_period_ = std::stoi(value);
+            } else if (key == "rsi_period") {
+                try { rsi_period_ = std::stoi(value); } catch(...) {}
+            } else if (key == "rsi_upper") {
+                try { rsi_upper_ = std::stod(value); } catch(...) {}
+            } else if (key == "rsi_lower") {
+                try { rsi_lower_ = std::stod(value); } catch(...) {}
             } else if (key == "mode") {
-                mode_ = (value == "live") ? Mode::LIVE_SIM : Mode::BACKTEST;
+                mode_ = (value == "live") ? Mode::LIVE_SIM
+                      : (value == "replay") ? Mode::REPLAY
+                      : (value == "sweep") ? Mode::SWEEP
+                      : (value == "portfolio") ? Mode::PORTFOLIO
+                      : (value == "sharded") ? Mode::SHARDED
+                      : (value == "walkforward") ? Mode::WALK_FORWARD
+                      : (value == "montecarlo") ? Mode::MONTE_CARLO : Mode::BACKTEST;
             } else if (key == "live_iterations") {
                 try { live_iterations_ = std::stoi(value); } catch(...) {}
             } else if (key == "live_history_size") {
                 try { live_history_size_ = std::stoi(value); } catch(...) {}
+            } else if (key == "live_feed_rate") {
+                try { live_feed_rate_ = std::stod(value); } catch(...) {}
+            } else if (key == "live_print_bars") {
+                live_print_bars_ = (value == "true" || value == "1");
+            } else if (key == "latency_dump_file") {
+                latency_dump_file_ = value;
+            } else if (key == "live_record_file") {
+                live_record_file_ = value;
+            } else if (key == "replay_speed") {
+                try {
+                    replay_speed_ = parseSpeed(value);
+                } catch(...) {
+                    std::cerr << "Warning: Invalid value for " << key << ": " << value << "\n";
+                }
+            } else if (key == "replay_file") {
+                replay_file_ = value;
+            } else if (key == "async_logging") {
+                async_logging_ = (value == "true" || value == "1");
+            } else if (key == "log_flush_interval_ms") {
+                try { log_flush_interval_ms_ = std::stoi(value); } catch(...) {}
+            } else if (key == "trade_log_format") {
+                binary_trade_log_ = (value == "binary");
+            } else if (key == "load_threads") {
+                try { load_threads_ = std::stoi(value); } catch(...) {}
+            } else if (key == "signal_engine") {
+                vectorized_signals_ = (value != "streaming");
+            } else if (key == "use_data_cache") {
+                use_data_cache_ = (value == "true" || value == "1");
+            } else if (key == "execution_model") {
+                use_matching_engine_ = (value == "engine");
+            } else if (key == "intrabar_path") {
+                execution_.path = (value == "ohlc") ? IntrabarPath::OHLC
+                                : (value == "olhc") ? IntrabarPath::OLHC : IntrabarPath::NEAREST_FIRST;
+            } else if (key == "brokerage_per_order") {
+                try { execution_.brokerage_per_order = std::stod(value); } catch(...) {}
+            } else if (key == "brokerage_pct") {
+                try { execution_.brokerage_pct = std::stod(value); } catch(...) {}
+            } else if (key == "stt_buy_pct") {
+                try { execution_.stt_buy_pct = std::stod(value); } catch(...) {}
+            } else if (key == "stt_sell_pct") {
+                try { execution_.stt_sell_pct = std::stod(value); } catch(...) {}
+            } else if (key == "slippage_bps") {
+                try { execution_.slippage_bps = std::stod(value); } catch(...) {}
+            } else if (key == "volume_participation") {
+                try { execution_.volume_participation = std::stod(value); } catch(...) {}
+            } else if (key == "stop_loss_pct") {
+                try { stop_loss_pct_ = std::stod(value); } catch(...) {}
+            } else if (key == "portfolio_symbols") {
+                portfolio_symbols_ = value;
+            } else if (key == "portfolio_data_dir") {
+                portfolio_data_dir_ = value;
+            } else if (key == "portfolio_threads") {
+                try { portfolio_threads_ = std::stoi(value); } catch(...) {}
+            } else if (key == "shard_symbols") {
+                try { shard_symbols_ = std::stoi(value); } catch(...) {}
+            } else if (key == "shard_bars") {
+                try { shard_bars_ = std::stoi(value); } catch(...) {}
+            } else if (key == "shard_threads") {
+                try { shard_threads_ = std::stoi(value); } catch(...) {}
+            } else if (key == "shard_pin_threads") {
+                shard_pin_threads_ = (value == "true" || value == "1");
+            } else if (key == "shard_feed_rate") {
+                try { shard_feed_rate_ = std::stod(value); } catch(...) {}
+            } else if (key == "walkforward_train_bars") {
+                try { walkforward_train_bars_ = std::stoi(value); } catch(...) {}
+            } else if (key == "walkforward_test_bars") {
+                try { walkforward_test_bars_ = std::stoi(value); } catch(...) {}
+            } else if (key == "walkforward_anchored") {
+                walkforward_anchored_ = (value == "true" || value == "1");
+            } else if (key == "walkforward_objective") {
+                walkforward_objective_ = value;
+            } else if (key == "monte_carlo_runs") {
+                try { monte_carlo_runs_ = std::stoi(value); } catch(...) {}
+            } else if (key == "monte_carlo_seed") {
+                try { monte_carlo_seed_ = std::stoull(value); } catch(...) {}
+            } else if (key == "monte_carlo_block_bars") {
+                try { monte_carlo_block_bars_ = std::stoi(value); } catch(...) {}
+            } else if (key == "monte_carlo_slippage_bps") {
+                try { monte_carlo_slippage_bps_ = std::stod(value); } catch(...) {}
+            } else if (key == "monte_carlo_threads") {
+                try { monte_carlo_threads_ = std::stoi(value); } catch(...) {}
+            } else if (key == "bar_timeframes") {
+                try {
+                    bar_timeframes_ = parseTimeframes(value);
+                } catch(...) {
+                    std::cerr << "Warning: Invalid value for " << key << ": " << value << "\n";
+                }
+            } else if (key.compare(0, 10, "synthetic_") == 0) {
+                try {
+                    if (key == "synthetic_model") {
+                        generator_.model = (value == "jump") ? PriceModel::JUMP_DIFFUSION
+                                         : (value == "regime") ? PriceModel::REGIME_SWITCHING : PriceModel::GBM;
+                    }
+                    else if (key == "synthetic_seed") generator_.seed = std::stoull(value);
+                    else if (key == "synthetic_drift") generator_.drift = std::stod(value);
+                    else if (key == "synthetic_volatility") generator_.volatility = std::stod(value);
+                    else if (key == "synthetic_jump_probability") generator_.jump_probability = std::stod(value);
+                    else if (key == "synthetic_jump_mean") generator_.jump_mean = std::stod(value);
+                    else if (key == "synthetic_jump_volatility") generator_.jump_volatility = std::stod(value);
+                    else if (key == "synthetic_regimes") generator_.regimes = parseRegimes(value);
+                    else if (key == "synthetic_volume") generator_.base_volume = std::stod(value);
+                    else if (key == "synthetic_start_price") generator_.start_price = std::stod(value);
+                    else if (key == "synthetic_bar_seconds") generator_.bar_seconds = std::stoll(value);
+                } catch(...) {
+                    std::cerr << "Warning: Invalid value for " << key << ": " << value << "\n";
+                }
+            } else if (key.compare(0, 6, "sweep_") == 0) {
+                try {
+                    if (key == "sweep_short_ma") sweep_short_ma_ = parseRange(value);
+                    else if (key == "sweep_long_ma") sweep_long_ma_ = parseRange(value);
+                    else if (key == "sweep_rsi_period") sweep_rsi_period_ = parseRange(value);
+                    else if (key == "sweep_rsi_upper") sweep_rsi_upper_ = parseRange(value);
+                    else if (key == "sweep_rsi_lower") sweep_rsi_lower_ = parseRange(value);
+                    else if (key == "sweep_risk_percentage") {
+                        sweep_risk_percentage_ = parseRange(value);
+                        sweep_risk_set_ = true;
+                    }
+                    else if (key == "sweep_threads") sweep_threads_ = std::stoi(value);
+                    else if (key == "sweep_top") sweep_top_ = std::stoi(value);
+                } catch(...) {
+                    std::cerr << "Warning: Invalid value for " << key << ": " << value << "\n";
+                }
             }
         }
     }    
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <map>
+#include <vector>
 #include "Types.h"
 namespace TradingBot {
 class Config {
@@ -15,10 +16,75 @@ public:
     std::string getSymbol() const { return symbol_; }
     int getShortMA() const { return short_ma_period_; }
     int getLongMA() const { return long_ma_period_; }
+    // RSI filter: BUY only while RSI < rsi_upper, SELL only while RSI > rsi_lower
+    int getRSIPeriod() const { return rsi_period_; }
+    double getRSIUpper() const { return rsi_upper_; }
+    double getRSILower() const { return rsi_lower_; }
     Mode getMode() const { return mode_; }    
     // Live simulation parameters
     int getLiveIterations() const { return live_iterations_; }
     int getLiveHistorySize() const { return live_history_size_; }
+    double getLiveFeedRate() const { return live_feed_rate_; } // bars/s, 0 = unthrottled
+    bool getLivePrintBars() const { return live_print_bars_; }
+    std::string getLatencyDumpFile() const { return latency_dump_file_; } // empty = console report only
+    std::string getLiveRecordFile() const { return live_record_file_; }   // live bars saved as CSV; empty = off
+    // Replay pacing: a multiple of the recorded bar spacing ("1x", "1000x"),
+    // infinity for "max" (unthrottled), 0 = live_feed_rate bars per second
+    double getReplaySpeed() const { return replay_speed_; }
+    std::string getReplayFile() const { return replay_file_; }             // empty = data_file_path
+    // Trade log writing
+    bool getAsyncLogging() const { return async_logging_; }
+    int getLogFlushIntervalMs() const { return log_flush_interval_ms_; }
+    bool getBinaryTradeLog() const { return binary_trade_log_; } // trade_log_format=csv|binary
+    // Data loading
+    int getLoadThreads() const { return load_threads_; }
+    bool getVectorizedSignals() const { return vectorized_signals_; } // signal_engine=vectorized|streaming
+    bool getUseDataCache() const { return use_data_cache_; }
+    bool getRebuildCache() const { return rebuild_cache_; }
+    void setRebuildCache(bool rebuild) { rebuild_cache_ = rebuild; }
+    // Order execution: "close" fills signals at the bar close (default),
+    // "engine" routes them through the MatchingEngine with costs
+    bool getUseMatchingEngine() const { return use_matching_engine_; }
+    const ExecutionSettings& getExecutionSettings() const { return execution_; }
+    double getStopLossPct() const { return stop_loss_pct_; } // protective stop below entry; 0 = none
+    // Parameter sweep ranges ("start:end:step" or a single value)
+    const ParameterRange& getSweepShortMA() const { return sweep_short_ma_; }
+    const ParameterRange& getSweepLongMA() const { return sweep_long_ma_; }
+    const ParameterRange& getSweepRSIPeriod() const { return sweep_rsi_period_; }
+    const ParameterRange& getSweepRSIUpper() const { return sweep_rsi_upper_; }
+    const ParameterRange& getSweepRSILower() const { return sweep_rsi_lower_; }
+    ParameterRange getSweepRiskPercentage() const; // defaults to risk_percentage
+    int getSweepThreads() const { return sweep_threads_; }
+    int getSweepTop() const { return sweep_top_; }
+    // Portfolio mode: "SYMBOL[:path],..." (default path <portfolio_data_dir>/SYMBOL.csv);
+    // falls back to symbol/data_file_path when no list is given
+    std::vector<SymbolSource> getPortfolioSymbols() const;
+    int getPortfolioThreads() const { return portfolio_threads_; }
+    // Sharded live simulation: every sweep_* combination on each of
+    // shard_symbols synthetic symbols (SYN1..), shard_bars bars each
+    int getShardSymbols() const { return shard_symbols_; }
+    int getShardBars() const { return shard_bars_; }
+    int getShardThreads() const { return shard_threads_; }      // 0 = all cores
+    bool getShardPinThreads() const { return shard_pin_threads_; }
+    double getShardFeedRate() const { return shard_feed_rate_; } // rounds/s, 0 = unthrottled
+    // Walk-forward: optimise the sweep_* grid on train bars, trade the winner
+    // on the test bars after them, then move on by test_bars
+    int getWalkForwardTrainBars() const { return walkforward_train_bars_; }
+    int getWalkForwardTestBars() const { return walkforward_test_bars_; }
+    bool getWalkForwardAnchored() const { return walkforward_anchored_; }  // train from bar 0 every window
+    const std::string& getWalkForwardObjective() const { return walkforward_objective_; } // pnl | sharpe
+    // Monte Carlo: monte_carlo_runs scenarios each of trade bootstrap, block
+    // bootstrap and random slippage around the configured strategy
+    int getMonteCarloRuns() const { return monte_carlo_runs_; }
+    uint64_t getMonteCarloSeed() const { return monte_carlo_seed_; }
+    int getMonteCarloBlockBars() const { return monte_carlo_block_bars_; }
+    double getMonteCarloSlippageBps() const { return monte_carlo_slippage_bps_; } // mean extra per fill
+    int getMonteCarloThreads() const { return monte_carlo_threads_; }  // 0 = all cores
+    // Synthetic market (live bars and generated datasets): synthetic_* keys
+    const GeneratorParams& getGeneratorParams() const { return generator_; }
+    // Timeframes to resample the data file to ("5m,1h,vol:50000,range:25");
+    // the first is the one traded, empty = bars as loaded
+    const std::vector<BarSpec>& getBarTimeframes() const { return bar_timeframes_; }
 private:
     double initial_balance_;
     double risk_percentage_;
@@ -26,10 +92,61 @@ private:
     std::string symbol_;
     int short_ma_period_;
     int long_ma_period_;
+    int rsi_period_;
+    double rsi_upper_;
+    double rsi_lower_;
     Mode mode_;    
     int live_iterations_;
     int live_history_size_;
+    double live_feed_rate_;
+    bool live_print_bars_;
+    std::string latency_dump_file_;
+    std::string live_record_file_;
+    double replay_speed_;
+    std::string replay_file_;
+    int load_threads_;
+    bool async_logging_;
+    int log_flush_interval_ms_;
+    bool binary_trade_log_;
+    bool vectorized_signals_;
+    bool use_data_cache_;
+    bool rebuild_cache_;
+    bool use_matching_engine_;
+    ExecutionSettings execution_;
+    double stop_loss_pct_;
+    ParameterRange sweep_short_ma_;
+    ParameterRange sweep_long_ma_;
+    ParameterRange sweep_rsi_period_;
+    ParameterRange sweep_rsi_upper_;
+    ParameterRange sweep_rsi_lower_;
+    ParameterRange sweep_risk_percentage_;
+    bool sweep_risk_set_;
+    int sweep_threads_;
+    int sweep_top_;
+    std::string portfolio_symbols_;
+    std::string portfolio_data_dir_;
+    int portfolio_threads_;
+    int shard_symbols_;
+    int shard_bars_;
+    int shard_threads_;
+    bool shard_pin_threads_;
+    double shard_feed_rate_;
+    int walkforward_train_bars_;
+    int walkforward_test_bars_;
+    bool walkforward_anchored_;
+    std::string walkforward_objective_;
+    int monte_carlo_runs_;
+    uint64_t monte_carlo_seed_;
+    int monte_carlo_block_bars_;
+    double monte_carlo_slippage_bps_;
+    int monte_carlo_threads_;
+    GeneratorParams generator_;
+    std::vector<BarSpec> bar_timeframes_;
     void setDefaults();
+    static ParameterRange parseRange(const std::string& value);
+    static std::vector<MarketRegime> parseRegimes(const std::string& value);
+    static std::vector<BarSpec> parseTimeframes(const std::string& value);
+    static double parseSpeed(const std::string& value);
 };
 }
 
@@ -0,0 +1,192 @@
+#include "CsvParser.h"
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+namespace TradingBot {
+
+std::string_view trimView(std::string_view s) {
+    size_t first = 0;
+    while (first < s.size() && (s[first] == ' ' || s[first] == '\t' || s[first] == '\r' || s[first] == '\n')) {
+        first++;
+    }
+    size_t last = s.size();
+    while (last > first && (s[last - 1] == ' ' || s[last - 1] == '\t' || s[last - 1] == '\r' || s[last - 1] == '\n')) {
+        last--;
+    }
+    return s.substr(first, last - first);
+}
+
+static const double kPow10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// Clinger's fast path: when the decimal mantissa fits in 53 bits and the
+// power of ten is exact (|exp| <= 22), one multiply/divide is correctly
+// rounded, so results are bit-identical to strtod. Anything else (very long
+// mantissas, large exponents) falls back to strtod on a stack copy.
+bool parseDouble(std::string_view s, double& out) {
+    if (s.empty()) return false;
+    size_t i = 0;
+    bool negative = false;
+    if (s[i] == '+' || s[i] == '-') {
+        negative = (s[i] == '-');
+        i++;
+    }
+    uint64_t mantissa = 0;
+    int digits = 0;       // significant digits accumulated
+    int exponent = 0;
+    bool any_digit = false;
+    bool overflow = false;
+    for (; i < s.size() && s[i] >= '0' && s[i] <= '9'; ++i) {
+        any_digit = true;
+        if (digits < 19) {
+            mantissa = mantissa * 10 + static_cast<uint64_t>(s[i] - '0');
+            if (mantissa != 0) digits++;
+        } else {
+            exponent++;
+            overflow = true;
+        }
+    }
+    if (i < s.size() && s[i] == '.') {
+        i++;
+        for (; i < s.size() && s[i] >= '0' && s[i] <= '9'; ++i) {
+            any_digit = true;
+            if (digits < 19) {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(s[i] - '0');
+                if (mantissa != 0) digits++;
+                exponent--;
+            } else {
+                overflow = true;
+            }
+        }
+    }
+    if (!any_digit) return false;
+    if (i < s.size() && (s[i] == 'e' || s[i] == 'E')) {
+        i++;
+        bool exp_negative = false;
+        if (i < s.size() && (s[i] == '+' || s[i] == '-')) {
+            exp_negative = (s[i] == '-');
+            i++;
+        }
+        if (i >= s.size() || s[i] < '0' || s[i] > '9') return false;
+        int e = 0;
+        for (; i < s.size() && s[i] >= '0' && s[i] <= '9'; ++i) {
+            if (e < 100000) e = e * 10 + (s[i] - '0');
+        }
+        exponent += exp_negative ? -e : e;
+    }
+    if (i != s.size()) return false;  // trailing garbage
+
+    if (!overflow && mantissa <= (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22) {
+        double value = static_cast<double>(mantissa);
+        value = exponent < 0 ? value / kPow10[-exponent] : value * kPow10[exponent];
+        out = negative ? -value : value;
+        return true;
+    }
+    char buffer[128];
+    if (s.size() >= sizeof(buffer)) return false;
+    std::memcpy(buffer, s.data(), s.size());
+    buffer[s.size()] = '\0';
+    char* end = nullptr;
+    out = std::strtod(buffer, &end);
+    return end == buffer + s.size();
+}
+
+bool parseInt64(std::string_view s, int64_t& out) {
+    if (s.empty()) return false;
+    size_t i = 0;
+    bool negative = false;
+    if (s[i] == '+' || s[i] == '-') {
+        negative = (s[i] == '-');
+        i++;
+    }
+    if (i >= s.size() || s[i] < '0' || s[i] > '9') return false;
+    uint64_t value = 0;
+    for (; i < s.size() && s[i] >= '0' && s[i] <= '9'; ++i) {
+        uint64_t next = value * 10 + static_cast<uint64_t>(s[i] - '0');
+        if (next / 10 != value) return false;  // overflow
+        value = next;
+    }
+    if (value > static_cast<uint64_t>(INT64_MAX)) return false;
+    if (i < s.size() && s[i] == '.') {
+        for (++i; i < s.size() && s[i] >= '0' && s[i] <= '9'; ++i) {}
+    }
+    if (i != s.size()) return false;
+    out = negative ? -static_cast<int64_t>(value) : static_cast<int64_t>(value);
+    return true;
+}
+
+// Parse one trimmed, non-empty row; false means malformed
+static bool parseBarRow(std::string_view line, int64_t& timestamp, double& open, double& high,
+                        double& low, double& close, int64_t& volume) {
+    std::string_view fields[6];
+    size_t count = 0;
+    size_t start = 0;
+    while (count < 6) {
+        size_t comma = line.find(',', start);
+        if (comma == std::string_view::npos) {
+            fields[count++] = trimView(line.substr(start));
+            break;
+        }
+        fields[count++] = trimView(line.substr(start, comma - start));
+        start = comma + 1;
+    }
+    if (count < 5) return false;
+    volume = 0;  // a missing volume column is tolerated, as before
+    if (!parseTimestamp(fields[0], timestamp) ||
+        !parseDouble(fields[1], open) || !parseDouble(fields[2], high) ||
+        !parseDouble(fields[3], low) || !parseDouble(fields[4], close) ||
+        (count == 6 && !fields[5].empty() && !parseInt64(fields[5], volume))) {
+        return false;
+    }
+    return close > 0;
+}
+
+size_t parseBarRows(std::string_view text, size_t first_line_number, BarSeries& out, CsvLoadReport& report) {
+    size_t pos = 0;
+    size_t line_number = first_line_number;
+    while (pos < text.size()) {
+        const char* nl = static_cast<const char*>(std::memchr(text.data() + pos, '\n', text.size() - pos));
+        size_t end = nl ? static_cast<size_t>(nl - text.data()) : text.size();
+        std::string_view line = trimView(text.substr(pos, end - pos));
+        if (!line.empty()) {
+            report.lines++;
+            int64_t timestamp, volume;
+            double open, high, low, close;
+            if (parseBarRow(line, timestamp, open, high, low, close, volume)) {
+                out.append(timestamp, open, high, low, close, volume);
+                report.loaded++;
+            } else {
+                if (report.malformed == 0) report.first_malformed_line = line_number;
+                report.malformed++;
+            }
+        }
+        pos = end + 1;
+        line_number++;
+    }
+    return line_number - first_line_number;
+}
+
+size_t skipLine(std::string_view text) {
+    size_t nl = text.find('\n');
+    return nl == std::string_view::npos ? text.size() : nl + 1;
+}
+
+std::vector<size_t> splitAtLines(std::string_view text, size_t parts) {
+    std::vector<size_t> bounds;
+    bounds.push_back(0);
+    if (parts == 0) parts = 1;
+    size_t step = text.size() / parts;
+    for (size_t k = 1; k < parts && step > 0; ++k) {
+        // a piece starts right after the first newline at or past k*step - 1
+        size_t pos = std::max(bounds.back(), k * step);
+        size_t nl = text.find('\n', pos - 1);
+        if (nl == std::string_view::npos || nl + 1 >= text.size()) break;
+        if (nl + 1 > bounds.back()) bounds.push_back(nl + 1);
+    }
+    bounds.push_back(text.size());
+    return bounds;
+}
+}
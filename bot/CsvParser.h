@@ -0,0 +1,41 @@
+#ifndef CSV_PARSER_H
+#define CSV_PARSER_H
+
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "BarSeries.h"
+
+namespace TradingBot {
+
+// Outcome of parsing a block of Date,Open,High,Low,Close,Volume rows
+struct CsvLoadReport {
+    size_t lines;                  // non-empty data lines seen (header excluded)
+    size_t loaded;                 // rows appended to the series
+    size_t malformed;              // rows rejected (bad field, missing field, close <= 0)
+    size_t first_malformed_line;   // 1-based file line of the first rejected row, 0 if none
+    size_t bytes;
+    double seconds;
+    
+    CsvLoadReport() : lines(0), loaded(0), malformed(0), first_malformed_line(0), bytes(0), seconds(0) {}
+};
+
+// In-place field parsers: no allocation, no locale, no exceptions
+std::string_view trimView(std::string_view s);
+bool parseDouble(std::string_view s, double& out);
+bool parseInt64(std::string_view s, int64_t& out);   // accepts and truncates a fractional part, like stoll
+
+// Parse every line of `text` as a bar row and append the good ones to `out`.
+// `first_line_number` is the file line number of text's first line.
+// Returns the number of lines (including empty ones) consumed.
+size_t parseBarRows(std::string_view text, size_t first_line_number, BarSeries& out, CsvLoadReport& report);
+
+// Offset just past the first line (the CSV header)
+size_t skipLine(std::string_view text);
+// Split text into about `parts` pieces that each end on a line boundary;
+// returns the begin offsets of every piece plus text.size()
+std::vector<size_t> splitAtLines(std::string_view text, size_t parts);
+}
+
+#endif
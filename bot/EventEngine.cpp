@@ -0,0 +1,122 @@
+#include "EventEngine.h"
+
+namespace TradingBot {
+
+SeriesFeed::SeriesFeed(const BarSeries& series, SymbolId symbol, size_t begin, size_t end, bool full_bars)
+    : timestamps_(series.timestamps()), open_(series.open()), high_(series.high()), low_(series.low()),
+      close_(series.close()), volume_(series.volume()), symbol_(symbol), index_(begin),
+      end_(end < series.size() ? end : series.size()), full_bars_(full_bars) {}
+
+void EventHandler::onBarRun(const BarRun& run, EventEngine& engine) {
+    Event bar;
+    bar.symbol = run.symbol;
+    for (size_t i = 0; i < run.closes.size(); ++i) {
+        bar.timestamp = run.timestamps[i];
+        bar.bar = static_cast<uint32_t>(run.first_bar + i);
+        bar.price = run.closes[i];
+        onBarClose(bar, engine);
+    }
+}
+
+EventEngine::EventEngine() : latency_(nullptr), bars_(0), dispatched_(0) {
+    queue_.reserve(64);
+}
+
+void EventEngine::subscribe(EventType type, EventHandler* handler) {
+    handlers_[static_cast<int>(type)].push_back(handler);
+}
+
+void EventEngine::subscribeBarClose(EventHandler* handler) {
+    bar_close_.push_back(handler);
+}
+
+Event& EventEngine::emit(const Event& cause, EventType type) {
+    queue_.advanceTo(cause.timestamp, cause.bar);
+    Event& event = queue_.emplaceDue();
+    event.follow(cause, type);
+#if TRADINGBOT_LATENCY_PROBES
+    if (latency_) {
+        // stage_tick still holds the cause's stamp
+        uint64_t now = LatencyClock::now();
+        if (type == EventType::ORDER) latency_->record(kStageRisk, event.stage_tick, now);
+        else if (type == EventType::FILL) latency_->record(kStageFill, event.stage_tick, now);
+        event.stage_tick = now;
+    }
+#endif
+    return event;
+}
+
+void EventEngine::push(const Event& event) {
+#if TRADINGBOT_LATENCY_PROBES
+    if (latency_) {
+        Event stamped = event;
+        stamped.stage_tick = LatencyClock::now();
+        queue_.push(stamped);
+        return;
+    }
+#endif
+    queue_.push(event);
+}
+
+void EventEngine::dispatch(const Event& event) {
+    dispatched_++;
+    const std::vector<EventHandler*>& handlers = handlers_[static_cast<int>(event.type)];
+    for (size_t i = 0; i < handlers.size(); ++i) handlers[i]->onEvent(event, *this);
+#if TRADINGBOT_LATENCY_PROBES
+    if (latency_ && event.type == EventType::FILL) {
+        uint64_t now = LatencyClock::now();
+        latency_->record(kStageLog, event.stage_tick, now);
+        latency_->record(kStageTickToTrade, event.arrival_tick, now);
+    }
+#endif
+}
+
+void EventEngine::dispatchUntil(int64_t timestamp, uint32_t bar, bool inclusive) {
+    Event event;
+    for (;;) {
+        // Due events are handled where they sit; handlers may add more behind them
+        while (queue_.hasDue()) {
+            dispatch(queue_.frontDue());
+            queue_.popDue();
+        }
+        if (!queue_.scheduledBy(timestamp, bar, inclusive)) return;
+        queue_.popScheduled(event);
+        queue_.advanceTo(event.timestamp, event.bar);
+        dispatch(event);
+    }
+}
+
+// step() when events are waiting or latencies are recorded
+void EventEngine::stepQueued(const Event& bar) {
+    dispatchUntil(bar.timestamp, bar.bar, false);  // left over, or scheduled for a time the feed skipped
+    queue_.advanceTo(bar.timestamp, bar.bar);
+    bars_++;
+#if TRADINGBOT_LATENCY_PROBES
+    if (latency_) {
+        Event market = bar;
+        market.stage_tick = LatencyClock::now();
+        dispatch(market);
+        // Arrival -> strategy done, for every bar
+        latency_->record(kStageSignal, market.arrival_tick, LatencyClock::now());
+    } else {
+        dispatch(bar);
+    }
+#else
+    dispatch(bar);
+#endif
+    dispatchUntil(bar.timestamp, bar.bar, true);
+    closeBar(bar);
+}
+
+void EventEngine::close(const BarRun& run) {
+    size_t count = run.closes.size();
+    queue_.advanceTo(run.timestamps[count - 1], static_cast<uint32_t>(run.first_bar + count - 1));
+    bars_ += count;
+    dispatched_ += count;
+    for (size_t i = 0; i < bar_close_.size(); ++i) bar_close_[i]->onBarRun(run, *this);
+}
+
+void EventEngine::drain() {
+    dispatchUntil(INT64_MAX, UINT32_MAX, true);
+}
+}
@@ -0,0 +1,200 @@
+#ifndef EVENT_ENGINE_H
+#define EVENT_ENGINE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "EventQueue.h"
+#include "BarSeries.h"
+#include "LatencyHistogram.h"
+
+namespace TradingBot {
+
+class EventEngine;
+
+// Consecutive bars of one feed that cause no events: bars first_bar onwards,
+// one per element of the spans
+struct BarRun {
+    Span<const int64_t> timestamps;
+    Span<const double> closes;
+    size_t first_bar;
+    SymbolId symbol;
+};
+
+// A component of the event loop. A handler only receives the event types it
+// subscribed to, so components that do not care about a type add nothing to
+// its dispatch cost.
+class EventHandler {
+public:
+    virtual ~EventHandler() {}
+    virtual void onEvent(const Event& event, EventEngine& engine) = 0;
+    // After a bar and everything it caused at its timestamp has been handled
+    virtual void onBarClose(const Event& bar, EventEngine& engine) { (void)bar; (void)engine; }
+    // The bar-close of every bar in a run; override to take them in bulk
+    virtual void onBarRun(const BarRun& run, EventEngine& engine);
+};
+
+// Source of MARKET events in non-decreasing timestamp order
+class MarketFeed {
+public:
+    virtual ~MarketFeed() {}
+    virtual bool next(Event& bar) = 0;  // false once the feed is exhausted
+    // Takes the bars before time (timestamp, bar) as one run, if the feed can
+    virtual bool nextRun(int64_t timestamp, uint32_t bar, BarRun& run) {
+        (void)timestamp; (void)bar; (void)run;
+        return false;
+    }
+};
+
+// Bars [begin, end) of a series as MARKET events, or as runs. Without
+// `full_bars` only the timestamp and close are read (open/high/low/volume
+// are left 0), so a pass over the series streams two columns instead of six.
+// Final and inline so EventEngine::run over a SeriesFeed needs no virtual
+// call per bar.
+class SeriesFeed final : public MarketFeed {
+public:
+    SeriesFeed(const BarSeries& series, SymbolId symbol, size_t begin, size_t end, bool full_bars = true);
+    bool next(Event& bar) override {
+        if (index_ >= end_) return false;
+        // Every field a MARKET event uses is written; the rest keep whatever the caller's event held
+        bar.timestamp = timestamps_[index_];
+        bar.type = EventType::MARKET;
+        bar.side = Signal::HOLD;
+        bar.symbol = symbol_;
+        bar.bar = static_cast<uint32_t>(index_);
+        bar.quantity = 0;
+        bar.price = close_[index_];
+        if (full_bars_) {
+            bar.market.open = open_[index_];
+            bar.market.high = high_[index_];
+            bar.market.low = low_[index_];
+            bar.market.volume = volume_[index_];
+        } else {
+            bar.market = BarFields();
+        }
+        bar.arrival_tick = 0;
+        bar.stage_tick = 0;
+        index_++;
+        return true;
+    }
+    bool nextRun(int64_t timestamp, uint32_t bar, BarRun& run) override {
+        size_t end = index_;
+        if (bar < end_ && timestamps_[bar] == timestamp) {
+            // The time of one of this feed's own bars: the run ends right before it
+            end = bar > index_ ? bar : index_;
+        } else {
+            while (end < end_ && (timestamps_[end] < timestamp || (timestamps_[end] == timestamp && end < bar))) end++;
+        }
+        if (end == index_) return false;
+        run.timestamps = timestamps_.subspan(index_, end - index_);
+        run.closes = close_.subspan(index_, end - index_);
+        run.first_bar = index_;
+        run.symbol = symbol_;
+        index_ = end;
+        return true;
+    }
+private:
+    Span<const int64_t> timestamps_;
+    Span<const double> open_, high_, low_, close_;
+    Span<const int64_t> volume_;
+    SymbolId symbol_;
+    size_t index_;
+    size_t end_;
+    bool full_bars_;
+};
+
+// Single-threaded event loop shared by the backtest, live and replay drivers.
+//
+// Each bar from the feed is dispatched to the MARKET subscribers in the
+// order they subscribed; events they emit (signals, orders, fills) are
+// queued and dispatched in order before the next bar. Then every bar-close
+// subscriber sees the bar. Events pushed for a later time wait in the queue
+// until the feed reaches their bar, and run right after its MARKET
+// subscribers (before it, if they are for an earlier time the feed skipped).
+// Bars themselves bypass the queue, so a bar that causes nothing costs one
+// pass over its subscribers. With no MARKET subscribers and nothing due,
+// nothing can happen before the next scheduled event, so the bars up to it
+// are closed as one run (a backtest on a precomputed signal batch spends
+// most of its bars there).
+class EventEngine {
+public:
+    EventEngine();
+    void subscribe(EventType type, EventHandler* handler);
+    void subscribeBarClose(EventHandler* handler);
+    // A follow-up of `cause`, due now, for the caller to fill in before it
+    // emits or pushes anything else. Built in place in the queue.
+    Event& emit(const Event& cause, EventType type);
+    void push(const Event& event);     // a complete event, possibly for a later timestamp
+    // Every bar of the feed, then whatever is still queued. A template so a
+    // concrete feed type (SeriesFeed) is called directly.
+    template <typename Feed>
+    void run(Feed& feed) {
+        Event bar;
+        for (;;) {
+            if (handlers_[static_cast<int>(EventType::MARKET)].empty() && !queue_.hasDue() && !latency_) {
+                BarRun quiet;
+                int64_t timestamp;
+                uint32_t next_bar;
+                queue_.nextScheduled(timestamp, next_bar);
+                if (feed.nextRun(timestamp, next_bar, quiet)) {
+                    close(quiet);
+                    continue;
+                }
+            }
+            if (!feed.next(bar)) break;
+            step(bar);
+        }
+        drain();
+    }
+    // One bar (drivers that feed bars themselves)
+    void step(const Event& bar) {
+        if (queue_.hasDue() || queue_.scheduledBy(bar.timestamp, bar.bar, false) || latency_) {
+            stepQueued(bar);
+            return;
+        }
+        // Nothing overdue and nothing timed: the common case
+        queue_.advanceTo(bar.timestamp, bar.bar);
+        bars_++;
+        dispatched_++;
+        const std::vector<EventHandler*>& market = handlers_[static_cast<int>(EventType::MARKET)];
+        for (size_t i = 0; i < market.size(); ++i) market[i]->onEvent(bar, *this);
+        if (queue_.hasDue() || queue_.scheduledBy(bar.timestamp, bar.bar, true)) {
+            dispatchUntil(bar.timestamp, bar.bar, true);
+        }
+        closeBar(bar);
+    }
+    void drain();                      // dispatch everything queued
+    // For drivers that walk the bars themselves (runCloseChain): a bar, or a
+    // run of bars, straight to the bar-close subscribers, counted as run()
+    // counts them. Whatever the bar caused must have been dispatched first.
+    void close(const Event& bar) {
+        queue_.advanceTo(bar.timestamp, bar.bar);
+        bars_++;
+        dispatched_++;
+        closeBar(bar);
+    }
+    void close(const BarRun& run);
+    // Per-stage latencies of signal -> order -> fill -> handled fill chains
+    void setLatencyProfile(LatencyProfile* profile) { latency_ = profile; }
+    uint64_t bars() const { return bars_; }
+    uint64_t dispatched() const { return dispatched_; }  // events of every type
+    size_t pending() const { return queue_.size(); }
+private:
+    std::vector<EventHandler*> handlers_[kEventTypeCount];
+    std::vector<EventHandler*> bar_close_;
+    EventQueue queue_;
+    LatencyProfile* latency_;
+    uint64_t bars_;
+    uint64_t dispatched_;
+
+    void dispatch(const Event& event);
+    // Due events, then scheduled ones up to (or, without `inclusive`, before) the given time
+    void dispatchUntil(int64_t timestamp, uint32_t bar, bool inclusive);
+    void stepQueued(const Event& bar);
+    void closeBar(const Event& bar) {
+        for (size_t i = 0; i < bar_close_.size(); ++i) bar_close_[i]->onBarClose(bar, *this);
+    }
+};
+}
+
+#endif
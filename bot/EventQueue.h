@@ -0,0 +1,215 @@
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+#include "Types.h"
+#include "SymbolTable.h"
+#include "OrderBook.h"
+
+namespace TradingBot {
+
+enum class EventType : uint8_t {
+    MARKET,     // a new bar
+    SIGNAL,     // strategy verdict on a bar (BUY/SELL; HOLD is never sent)
+    ORDER,      // sized order for the execution handler
+    FILL        // executed and booked by the broker
+};
+const int kEventTypeCount = 4;
+
+// Type-specific fields; `price` and `quantity` in Event cover the rest
+struct BarFields {          // MARKET (price = close)
+    double open;
+    double high;
+    double low;
+    int64_t volume;
+};
+struct OrderFields {        // ORDER (price = close of the bar it was sized on)
+    OrderType type;
+    double limit_price;
+    double stop_price;
+};
+struct FillFields {         // FILL (price = execution price, slippage included)
+    double fees;
+    double balance_after;
+    OrderId order;          // kInvalidOrder for fills outside the matching engine
+    uint64_t trade;         // BrokerSimulator::tradeCount() right after booking
+};
+
+// Fixed-size, trivially copyable record; events are stored by value in the
+// queue and in SPSC rings, never behind pointers.
+struct Event {
+    int64_t timestamp;      // epoch seconds of the bar the event belongs to
+    uint64_t sequence;      // set by EventQueue::push; orders events scheduled for the same time
+    EventType type;
+    Signal side;            // SIGNAL, ORDER, FILL
+    SymbolId symbol;
+    uint32_t bar;           // index of the bar in its feed; orders bars with equal timestamps
+    int quantity;           // ORDER, FILL
+    double price;
+    union {
+        BarFields market;
+        OrderFields order;
+        FillFields fill;
+    };
+    uint64_t arrival_tick;  // LatencyClock stamp of the bar that started the chain
+    uint64_t stage_tick;    // stamp of the event this one follows, then of its own emit/push
+
+    Event() : timestamp(0), sequence(0), type(EventType::MARKET), side(Signal::HOLD), symbol(0), bar(0),
+              quantity(0), price(0), market(), arrival_tick(0), stage_tick(0) {}
+    // Turns this into a follow-up of `cause` on the same bar, symbol and latency chain
+    void follow(const Event& cause, EventType next_type) {
+        timestamp = cause.timestamp;
+        type = next_type;
+        side = cause.side;
+        symbol = cause.symbol;
+        bar = cause.bar;
+        price = cause.price;
+        arrival_tick = cause.arrival_tick;
+        stage_tick = cause.stage_tick;
+    }
+};
+static_assert(std::is_trivially_copyable<Event>::value, "events are copied through rings and the heap");
+
+// Min-priority queue of events by time, in two lanes behind one interface.
+//
+// Time is (timestamp, bar): a feed's bar index breaks ties between bars that
+// share a timestamp. Events at or before the current time (set by the engine
+// as it reaches each bar) are due: they go to a FIFO lane and are handed out
+// in push order, in place, without being copied out. That is the common
+// case, since a bar's signal, order and fill all carry the bar's time.
+// Events scheduled for later wait in an implicit 4-ary heap keyed by
+// (timestamp, bar, push order) over one contiguous vector: a sift touches
+// half the levels of a binary heap and the four children of a node sit next
+// to each other in memory.
+//
+// The due lane only grows until it empties. When it is full, its events move
+// to a bigger buffer and the old one stays alive until the lane empties, so
+// a reference to the event being handled survives the handler's own pushes.
+class EventQueue {
+public:
+    EventQueue() : now_(INT64_MIN), now_bar_(0), head_(0), next_sequence_(0) { due_.reserve(16); }
+    bool empty() const { return head_ == due_.size() && heap_.empty(); }
+    size_t size() const { return due_.size() - head_ + heap_.size(); }
+    void reserve(size_t n) { heap_.reserve(n); }
+    int64_t now() const { return now_; }
+    void advanceTo(int64_t timestamp, uint32_t bar) {
+        if (timestamp > now_ || (timestamp == now_ && bar > now_bar_)) {
+            now_ = timestamp;
+            now_bar_ = bar;
+        }
+    }
+    bool isDue(const Event& event) const {
+        return event.timestamp < now_ || (event.timestamp == now_ && event.bar <= now_bar_);
+    }
+
+    // A default event in the due lane for the caller to fill in
+    Event& emplaceDue() {
+        if (due_.size() == due_.capacity()) growDue();
+        due_.emplace_back();
+        return due_.back();
+    }
+    void push(const Event& event) {
+        if (isDue(event)) {
+            emplaceDue() = event;
+            return;
+        }
+        heap_.push_back(event);
+        heap_.back().sequence = next_sequence_++;
+        if (heap_.size() > 1) siftUp(heap_.size() - 1);
+    }
+
+    bool hasDue() const { return head_ < due_.size(); }
+    const Event& frontDue() const { return due_[head_]; }
+    void popDue() {
+        if (++head_ < due_.size()) return;
+        due_.clear();
+        head_ = 0;
+        if (!retired_.empty()) retired_.clear();
+    }
+
+    // The earliest scheduled event sorts before (or, with `inclusive`, at) the given time
+    bool scheduledBy(int64_t timestamp, uint32_t bar, bool inclusive) const {
+        if (heap_.empty()) return false;
+        const Event& top = heap_.front();
+        if (top.timestamp != timestamp) return top.timestamp < timestamp;
+        return inclusive ? top.bar <= bar : top.bar < bar;
+    }
+    // Time of the earliest scheduled event; INT64_MAX/UINT32_MAX when there is none
+    void nextScheduled(int64_t& timestamp, uint32_t& bar) const {
+        timestamp = heap_.empty() ? INT64_MAX : heap_.front().timestamp;
+        bar = heap_.empty() ? UINT32_MAX : heap_.front().bar;
+    }
+    void popScheduled(Event& out) {
+        out = heap_.front();
+        if (heap_.size() > 1) {
+            Event last = heap_.back();
+            heap_.pop_back();
+            siftDown(last);
+        } else {
+            heap_.pop_back();
+        }
+    }
+    void clear() {
+        due_.clear();
+        head_ = 0;
+        retired_.clear();
+        heap_.clear();
+    }
+private:
+    static const size_t kArity = 4;
+    int64_t now_;
+    uint32_t now_bar_;
+    std::vector<Event> due_;
+    size_t head_;                              // next due event to hand out
+    std::vector<std::vector<Event>> retired_;  // outgrown due buffers, freed once the lane empties
+    std::vector<Event> heap_;
+    uint64_t next_sequence_;
+
+    void growDue() {
+        std::vector<Event> bigger;
+        bigger.reserve(due_.capacity() * 2);
+        bigger.assign(due_.begin(), due_.end());
+        retired_.push_back(std::move(due_));
+        due_ = std::move(bigger);
+    }
+    static bool before(const Event& a, const Event& b) {
+        if (a.timestamp != b.timestamp) return a.timestamp < b.timestamp;
+        if (a.bar != b.bar) return a.bar < b.bar;
+        return a.sequence < b.sequence;
+    }
+    // Hole-based sifts: one copy per level instead of a swap
+    void siftUp(size_t index) {
+        Event moving = heap_[index];
+        while (index > 0) {
+            size_t parent = (index - 1) / kArity;
+            if (!before(moving, heap_[parent])) break;
+            heap_[index] = heap_[parent];
+            index = parent;
+        }
+        heap_[index] = moving;
+    }
+    // Places `moving` starting from the (vacated) root
+    void siftDown(const Event& moving) {
+        size_t size = heap_.size();
+        size_t index = 0;
+        for (;;) {
+            size_t first = index * kArity + 1;
+            if (first >= size) break;
+            size_t last = first + kArity < size ? first + kArity : size;
+            size_t best = first;
+            for (size_t child = first + 1; child < last; ++child) {
+                if (before(heap_[child], heap_[best])) best = child;
+            }
+            if (!before(heap_[best], moving)) break;
+            heap_[index] = heap_[best];
+            index = best;
+        }
+        heap_[index] = moving;
+    }
+};
+}
+
+#endif
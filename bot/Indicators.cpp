@@ -0,0 +1,213 @@
+#include "Indicators.h"
+#include <algorithm>
+#include <cmath>
+
+namespace TradingBot {
+
+RingBuffer::RingBuffer(size_t capacity)
+    : buffer_(std::max<size_t>(capacity, 1), 0.0), head_(0), size_(0) {}
+void RingBuffer::push(double value) {
+    buffer_[head_] = value;
+    head_ = (head_ + 1 == buffer_.size()) ? 0 : head_ + 1;
+    if (size_ < buffer_.size()) size_++;
+}
+double RingBuffer::oldest() const {
+    if (!full()) return 0.0;
+    return buffer_[head_];
+}
+double RingBuffer::at(size_t age) const {
+    size_t idx = (head_ + buffer_.size() - 1 - age) % buffer_.size();
+    return buffer_[idx];
+}
+void RingBuffer::clear() {
+    std::fill(buffer_.begin(), buffer_.end(), 0.0);
+    head_ = 0;
+    size_ = 0;
+}
+
+// Sum newest-first, the same order the batch functions use, so a resync
+// lands on exactly the value calculateSMA/calculateRSI would produce
+static double resum(const RingBuffer& window) {
+    double sum = 0.0;
+    for (size_t age = 0; age < window.size(); ++age) {
+        sum += window.at(age);
+    }
+    return sum;
+}
+
+RollingSMA::RollingSMA(int period)
+    : period_(std::max(period, 1)), window_(static_cast<size_t>(std::max(period, 1))),
+      sum_(0.0), since_resync_(0) {}
+void RollingSMA::update(double value) {
+    if (window_.full()) {
+        sum_ -= window_.oldest();
+    }
+    window_.push(value);
+    sum_ += value;
+    if (++since_resync_ >= window_.capacity()) {
+        sum_ = resum(window_);
+        since_resync_ = 0;
+    }
+}
+double RollingSMA::value() const {
+    if (!window_.full()) return 0.0;
+    return sum_ / period_;
+}
+void RollingSMA::reset() {
+    window_.clear();
+    sum_ = 0.0;
+    since_resync_ = 0;
+}
+
+RollingRSI::RollingRSI(int period)
+    : period_(std::max(period, 1)),
+      gains_(static_cast<size_t>(std::max(period, 1))),
+      losses_(static_cast<size_t>(std::max(period, 1))),
+      gain_sum_(0.0), loss_sum_(0.0), last_close_(0.0), has_last_(false), since_resync_(0) {}
+void RollingRSI::update(double close) {
+    if (!has_last_) {
+        last_close_ = close;
+        has_last_ = true;
+        return;
+    }
+    double change = close - last_close_;
+    last_close_ = close;
+    double gain = change > 0 ? change : 0.0;
+    double loss = change > 0 ? 0.0 : std::abs(change);
+    if (gains_.full()) {
+        gain_sum_ -= gains_.oldest();
+        loss_sum_ -= losses_.oldest();
+    }
+    gains_.push(gain);
+    losses_.push(loss);
+    gain_sum_ += gain;
+    loss_sum_ += loss;
+    if (++since_resync_ >= gains_.capacity()) {
+        gain_sum_ = resum(gains_);
+        loss_sum_ = resum(losses_);
+        since_resync_ = 0;
+    }
+}
+double RollingRSI::value() const {
+    if (!gains_.full()) return 50.0;  // Neutral RSI
+    double avg_gain = gain_sum_ / period_;
+    double avg_loss = loss_sum_ / period_;
+    if (avg_loss <= 0) return 100.0;
+    double rs = avg_gain / avg_loss;
+    return 100.0 - (100.0 / (1.0 + rs));
+}
+void RollingRSI::reset() {
+    gains_.clear();
+    losses_.clear();
+    gain_sum_ = 0.0;
+    loss_sum_ = 0.0;
+    has_last_ = false;
+    since_resync_ = 0;
+}
+
+WilderRSI::WilderRSI(int period)
+    : period_(std::max(period, 1)), count_(0), avg_gain_(0.0), avg_loss_(0.0),
+      last_close_(0.0), has_last_(false) {}
+void WilderRSI::update(double close) {
+    if (!has_last_) {
+        last_close_ = close;
+        has_last_ = true;
+        return;
+    }
+    double change = close - last_close_;
+    last_close_ = close;
+    double gain = change > 0 ? change : 0.0;
+    double loss = change > 0 ? 0.0 : -change;
+    if (count_ < period_) {
+        // Seed phase: plain average of the first `period` changes
+        avg_gain_ += gain / period_;
+        avg_loss_ += loss / period_;
+        count_++;
+    } else {
+        avg_gain_ = (avg_gain_ * (period_ - 1) + gain) / period_;
+        avg_loss_ = (avg_loss_ * (period_ - 1) + loss) / period_;
+    }
+}
+double WilderRSI::value() const {
+    if (!isReady()) return 50.0;
+    if (avg_loss_ <= 0) return 100.0;
+    double rs = avg_gain_ / avg_loss_;
+    return 100.0 - (100.0 / (1.0 + rs));
+}
+void WilderRSI::reset() {
+    count_ = 0;
+    avg_gain_ = 0.0;
+    avg_loss_ = 0.0;
+    has_last_ = false;
+}
+
+EMA::EMA(int period)
+    : period_(std::max(period, 1)), alpha_(2.0 / (std::max(period, 1) + 1.0)),
+      count_(0), value_(0.0), seed_sum_(0.0) {}
+void EMA::update(double value) {
+    if (count_ < period_) {
+        seed_sum_ += value;
+        count_++;
+        if (count_ == period_) value_ = seed_sum_ / period_;
+        return;
+    }
+    value_ += alpha_ * (value - value_);
+}
+void EMA::reset() {
+    count_ = 0;
+    value_ = 0.0;
+    seed_sum_ = 0.0;
+}
+
+BollingerBands::BollingerBands(int period, double num_stddev)
+    : period_(std::max(period, 1)), num_stddev_(num_stddev),
+      window_(static_cast<size_t>(std::max(period, 1))),
+      shift_(0.0), sum_(0.0), sum_sq_(0.0), since_resync_(0) {}
+void BollingerBands::update(double value) {
+    // Sums are kept relative to a shift so the variance doesn't cancel
+    // catastrophically at index-level prices; the shift moves on resync
+    if (window_.size() == 0) shift_ = value;
+    if (window_.full()) {
+        double old = window_.oldest() - shift_;
+        sum_ -= old;
+        sum_sq_ -= old * old;
+    }
+    window_.push(value);
+    sum_ += value - shift_;
+    sum_sq_ += (value - shift_) * (value - shift_);
+    if (++since_resync_ >= window_.capacity()) {
+        shift_ = value;
+        sum_ = 0.0;
+        sum_sq_ = 0.0;
+        for (size_t age = 0; age < window_.size(); ++age) {
+            double v = window_.at(age) - shift_;
+            sum_ += v;
+            sum_sq_ += v * v;
+        }
+        since_resync_ = 0;
+    }
+}
+double BollingerBands::middle() const {
+    if (!window_.full()) return 0.0;
+    return shift_ + sum_ / period_;
+}
+double BollingerBands::stddev() const {
+    if (!window_.full()) return 0.0;
+    double mean = sum_ / period_;
+    double variance = sum_sq_ / period_ - mean * mean;
+    return variance > 0 ? std::sqrt(variance) : 0.0;
+}
+double BollingerBands::upper() const {
+    return middle() + num_stddev_ * stddev();
+}
+double BollingerBands::lower() const {
+    return middle() - num_stddev_ * stddev();
+}
+void BollingerBands::reset() {
+    window_.clear();
+    shift_ = 0.0;
+    sum_ = 0.0;
+    sum_sq_ = 0.0;
+    since_resync_ = 0;
+}
+}
@@ -0,0 +1,126 @@
+#ifndef INDICATORS_H
+#define INDICATORS_H
+
+#include <vector>
+#include <cstddef>
+
+namespace TradingBot {
+
+// Streaming indicators: every update() is O(1) regardless of the window length.
+//
+// Rolling sums drift from a fresh re-summation by a few ULPs per update, so the
+// windowed indicators re-sum their ring buffer once per full wrap (amortised
+// O(1)). Values then agree with the batch Strategy::calculateSMA/calculateRSI
+// to within ~1e-12 relative; crossover decisions are identical in practice.
+
+// Fixed-capacity ring buffer holding the last `capacity` values
+class RingBuffer {
+public:
+    explicit RingBuffer(size_t capacity = 1);
+    void push(double value);          // overwrites the oldest value once full
+    double oldest() const;            // value that the next push() will evict
+    double at(size_t age) const;      // age 0 = newest
+    size_t size() const { return size_; }
+    size_t capacity() const { return buffer_.size(); }
+    bool full() const { return size_ == buffer_.size(); }
+    void clear();
+private:
+    std::vector<double> buffer_;
+    size_t head_;   // next write position
+    size_t size_;
+};
+
+// Simple moving average over a rolling sum
+class RollingSMA {
+public:
+    explicit RollingSMA(int period);
+    void update(double value);
+    double value() const;             // 0.0 until `period` values are seen (matches calculateSMA)
+    bool isReady() const { return window_.full(); }
+    int period() const { return period_; }
+    void reset();
+private:
+    int period_;
+    RingBuffer window_;
+    double sum_;
+    size_t since_resync_;
+};
+
+// RSI over the simple average of the last `period` gains/losses. This is the
+// definition Strategy::calculateRSI uses, so it is the one the strategy runs on.
+class RollingRSI {
+public:
+    explicit RollingRSI(int period = 14);
+    void update(double close);
+    double value() const;             // 50.0 until `period` changes are seen
+    bool isReady() const { return gains_.full(); }
+    int period() const { return period_; }
+    void reset();
+private:
+    int period_;
+    RingBuffer gains_;
+    RingBuffer losses_;
+    double gain_sum_;
+    double loss_sum_;
+    double last_close_;
+    bool has_last_;
+    size_t since_resync_;
+};
+
+// Wilder-smoothed RSI (seeded with a simple average, then alpha = 1/period).
+// Differs from RollingRSI by design; it is not a drop-in for calculateRSI.
+class WilderRSI {
+public:
+    explicit WilderRSI(int period = 14);
+    void update(double close);
+    double value() const;             // 50.0 until seeded
+    bool isReady() const { return count_ >= period_; }
+    void reset();
+private:
+    int period_;
+    int count_;
+    double avg_gain_;
+    double avg_loss_;
+    double last_close_;
+    bool has_last_;
+};
+
+// Exponential moving average seeded with the SMA of the first `period` values
+class EMA {
+public:
+    explicit EMA(int period);
+    void update(double value);
+    double value() const { return value_; }
+    bool isReady() const { return count_ >= period_; }
+    void reset();
+private:
+    int period_;
+    double alpha_;
+    int count_;
+    double value_;
+    double seed_sum_;
+};
+
+// Bollinger bands: SMA +/- k population standard deviations over a ring buffer
+class BollingerBands {
+public:
+    BollingerBands(int period = 20, double num_stddev = 2.0);
+    void update(double value);
+    double middle() const;
+    double upper() const;
+    double lower() const;
+    double stddev() const;
+    bool isReady() const { return window_.full(); }
+    void reset();
+private:
+    int period_;
+    double num_stddev_;
+    RingBuffer window_;
+    double shift_;
+    double sum_;
+    double sum_sq_;
+    size_t since_resync_;
+};
+}
+
+#endif
@@ -0,0 +1,128 @@
+#include "LatencyHistogram.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+
+namespace TradingBot {
+
+double LatencyClock::nsPerTick() {
+#if defined(TRADINGBOT_HAS_RDTSC) && !defined(TRADINGBOT_LATENCY_STEADY_CLOCK)
+    // Busy-wait ~10 ms and compare the TSC with steady_clock
+    static const double ns_per_tick = []() {
+        auto wall_start = std::chrono::steady_clock::now();
+        uint64_t tick_start = __rdtsc();
+        while (std::chrono::steady_clock::now() - wall_start < std::chrono::milliseconds(10)) {}
+        uint64_t ticks = __rdtsc() - tick_start;
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - wall_start).count();
+        return ticks > 0 ? ns / static_cast<double>(ticks) : 1.0;
+    }();
+    return ns_per_tick;
+#else
+    return 1.0;
+#endif
+}
+
+LatencyHistogram::LatencyHistogram() : counts_(kBuckets, 0) {
+    clear();
+}
+void LatencyHistogram::clear() {
+    std::fill(counts_.begin(), counts_.end(), 0);
+    count_ = 0;
+    total_ = 0;
+    min_ = std::numeric_limits<uint64_t>::max();
+    max_ = 0;
+}
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < kBuckets; ++i) {
+        counts_[i] += other.counts_[i];
+    }
+    count_ += other.count_;
+    total_ += other.total_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+}
+uint64_t LatencyHistogram::lowerBound(size_t index) {
+    if (index < (size_t(1) << (kSubBucketBits + 1))) return index;
+    size_t shift = (index >> kSubBucketBits) - 1;
+    uint64_t sub = index - (shift << kSubBucketBits);
+    return sub << shift;
+}
+uint64_t LatencyHistogram::upperBound(size_t index) {
+    if (index < (size_t(1) << (kSubBucketBits + 1))) return index;
+    size_t shift = (index >> kSubBucketBits) - 1;
+    return lowerBound(index) + (uint64_t(1) << shift) - 1;
+}
+uint64_t LatencyHistogram::percentile(double percent) const {
+    if (count_ == 0) return 0;
+    double wanted = std::min(std::max(percent, 0.0), 100.0) / 100.0 * static_cast<double>(count_);
+    uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(wanted)));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBuckets; ++i) {
+        seen += counts_[i];
+        if (seen >= target) return std::min(upperBound(i), max_);
+    }
+    return max_;
+}
+void LatencyHistogram::writeBuckets(std::ostream& out, const std::string& name) const {
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBuckets; ++i) {
+        if (counts_[i] == 0) continue;
+        seen += counts_[i];
+        out << name << "," << lowerBound(i) << "," << upperBound(i) << "," << counts_[i] << ","
+            << std::setprecision(6) << static_cast<double>(seen) / count_ << "\n";
+    }
+}
+
+#if TRADINGBOT_LATENCY_PROBES
+LatencyProfile::LatencyProfile() : ns_per_tick_(LatencyClock::nsPerTick()) {}
+#else
+LatencyProfile::LatencyProfile() : ns_per_tick_(1.0) {}  // nothing is recorded; skip the calibration
+#endif
+
+const char* LatencyProfile::stageName(LatencyStage stage) {
+    switch (stage) {
+        case kStageSignal: return "arrival -> signal";
+        case kStageRisk: return "signal -> risk";
+        case kStageFill: return "risk -> fill";
+        case kStageLog: return "fill -> logged";
+        case kStageTickToTrade: return "tick -> trade";
+        default: return "?";
+    }
+}
+void LatencyProfile::printReport() const {
+    std::cout << "\n" << std::string(72, '=') << "\n";
+    std::cout << "            LATENCY (microseconds)\n";
+    std::cout << std::string(72, '=') << "\n";
+#if TRADINGBOT_LATENCY_PROBES
+    std::cout << "  Stage                 Count       p50       p99     p99.9       Max\n";
+    std::cout << std::fixed << std::setprecision(2);
+    for (int s = 0; s < kLatencyStageCount; ++s) {
+        const LatencyHistogram& h = stages_[s];
+        std::cout << "  " << std::left << std::setw(18) << stageName(static_cast<LatencyStage>(s)) << std::right
+                  << std::setw(10) << h.count()
+                  << std::setw(10) << h.percentile(50.0) / 1000.0
+                  << std::setw(10) << h.percentile(99.0) / 1000.0
+                  << std::setw(10) << h.percentile(99.9) / 1000.0
+                  << std::setw(10) << h.max() / 1000.0 << "\n";
+    }
+#else
+    std::cout << "  Latency probes were compiled out (TRADINGBOT_LATENCY_PROBES=0)\n";
+#endif
+    std::cout << std::string(72, '=') << "\n";
+}
+bool LatencyProfile::writeCSV(const std::string& filename) const {
+    std::ofstream out(filename);
+    if (!out.is_open()) {
+        std::cerr << "Warning: Could not write latency histogram file " << filename << std::endl;
+        return false;
+    }
+    out << "Stage,LowerNs,UpperNs,Count,CumulativeFraction\n";
+    for (int s = 0; s < kLatencyStageCount; ++s) {
+        stages_[s].writeBuckets(out, stageName(static_cast<LatencyStage>(s)));
+    }
+    return true;
+}
+}
@@ -0,0 +1,129 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <cstdint>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define TRADINGBOT_HAS_RDTSC 1
+#endif
+#include <chrono>
+
+// Build with -DTRADINGBOT_LATENCY_PROBES=0 to compile every probe out
+#ifndef TRADINGBOT_LATENCY_PROBES
+#define TRADINGBOT_LATENCY_PROBES 1
+#endif
+
+namespace TradingBot {
+
+// Cheap monotonic timestamps for hot-path probes. On x86 this is the TSC
+// (invariant on every CPU this runs on, and consistent across cores), so a
+// stamp costs a couple of dozen cycles; elsewhere it is steady_clock.
+// Ticks are converted to nanoseconds only when a sample is recorded.
+class LatencyClock {
+public:
+    static uint64_t now() {
+#if defined(TRADINGBOT_HAS_RDTSC) && !defined(TRADINGBOT_LATENCY_STEADY_CLOCK)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+    // Calibrated against steady_clock on first call (~10 ms); call it before timing starts
+    static double nsPerTick();
+};
+
+// Fixed-memory log-linear histogram of nanosecond latencies (HdrHistogram
+// layout): values below 256 ns are exact, above that every power of two is
+// split into 128 equal sub-buckets, so any reported value is within 0.8% of
+// the true one. 4352 counters cover 1 ns .. 2^40 ns (~18 minutes); larger
+// samples are clamped into the top bucket, but max() stays exact.
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+    void record(uint64_t ns) {
+        counts_[indexOf(ns)]++;
+        count_++;
+        total_ += ns;
+        if (ns > max_) max_ = ns;
+        if (ns < min_) min_ = ns;
+    }
+    void merge(const LatencyHistogram& other);
+    void clear();
+
+    uint64_t count() const { return count_; }
+    uint64_t min() const { return count_ ? min_ : 0; }
+    uint64_t max() const { return max_; }
+    double mean() const { return count_ ? static_cast<double>(total_) / count_ : 0.0; }
+    // Smallest recorded value v such that `percent`% of samples are <= v
+    // (reported as the top of its bucket, capped at max())
+    uint64_t percentile(double percent) const;
+
+    // Non-empty buckets as "name,lower_ns,upper_ns,count,cumulative_fraction" rows
+    void writeBuckets(std::ostream& out, const std::string& name) const;
+private:
+    static const int kSubBucketBits = 7;
+    static const int kMaxMagnitude = 40;
+    static const size_t kBuckets = (kMaxMagnitude - kSubBucketBits + 1) << kSubBucketBits;
+    std::vector<uint64_t> counts_;
+    uint64_t count_;
+    uint64_t total_;
+    uint64_t min_;
+    uint64_t max_;
+
+    static size_t indexOf(uint64_t ns) {
+        const uint64_t limit = (uint64_t(1) << kMaxMagnitude) - 1;
+        if (ns > limit) ns = limit;
+        if (ns < (uint64_t(1) << (kSubBucketBits + 1))) return static_cast<size_t>(ns);
+        int magnitude = 63 - __builtin_clzll(ns);
+        int shift = magnitude - kSubBucketBits;
+        return (static_cast<size_t>(shift) << kSubBucketBits) + static_cast<size_t>(ns >> shift);
+    }
+    static uint64_t lowerBound(size_t index);
+    static uint64_t upperBound(size_t index);  // inclusive
+};
+
+// Stamps taken for one bar on its way from arrival to a logged trade
+enum LatencyStage {
+    kStageSignal,       // data arrival -> signal computed
+    kStageRisk,         // signal computed -> risk check done
+    kStageFill,         // risk check done -> order filled
+    kStageLog,          // order filled -> trade logged
+    kStageTickToTrade,  // data arrival -> trade logged
+    kLatencyStageCount
+};
+
+// One histogram per stage. Each stage must be recorded from a single thread
+// (different stages may be recorded from different threads).
+class LatencyProfile {
+public:
+    LatencyProfile();
+    void record(LatencyStage stage, uint64_t from_tick, uint64_t to_tick) {
+        uint64_t ticks = to_tick > from_tick ? to_tick - from_tick : 0;
+        stages_[stage].record(static_cast<uint64_t>(ticks * ns_per_tick_));
+    }
+    const LatencyHistogram& stage(LatencyStage stage) const { return stages_[stage]; }
+    void printReport() const;                          // p50/p99/p99.9/max per stage
+    bool writeCSV(const std::string& filename) const;  // every non-empty bucket per stage
+    static const char* stageName(LatencyStage stage);
+private:
+    LatencyHistogram stages_[kLatencyStageCount];
+    double ns_per_tick_;
+};
+}
+
+// Probe macros; they expand to nothing when probes are compiled out
+#if TRADINGBOT_LATENCY_PROBES
+#define TRADINGBOT_LATENCY_STAMP(var) var = ::TradingBot::LatencyClock::now()
+#define TRADINGBOT_LATENCY_RECORD(profile, stage, from, to) (profile).record((stage), (from), (to))
+#else
+#define TRADINGBOT_LATENCY_STAMP(var) ((void)0)
+#define TRADINGBOT_LATENCY_RECORD(profile, stage, from, to) ((void)0)
+#endif
+
+#endif
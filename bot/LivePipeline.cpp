@@ -0,0 +1,183 @@
+#include "LivePipeline.h"
+#include "AllocationStats.h"
+#include "TradingHandlers.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+namespace TradingBot {
+
+namespace {
+
+// MARKET events popped from the feed ring; waits while the ring is empty
+class RingFeed : public MarketFeed {
+public:
+    RingFeed(SpscQueue<Event>& ring, const std::atomic<bool>& done) : ring_(ring), done_(done) {}
+    bool next(Event& bar) override {
+        Backoff backoff;
+        for (;;) {
+            // Read the flag before popping so a bar pushed just before it was set is not missed
+            bool done = done_.load(std::memory_order_acquire);
+            if (ring_.tryPop(bar)) return true;
+            if (done) return false;
+            backoff.pause();
+        }
+    }
+private:
+    SpscQueue<Event>& ring_;
+    const std::atomic<bool>& done_;
+};
+}
+
+LivePipeline::LivePipeline(MarketDataHandler& feed, Strategy& strategy, RiskManager& risk,
+                           BrokerSimulator& broker, TradeLogger& logger, const LivePipelineOptions& options)
+    : feed_(feed), strategy_(strategy), risk_(risk), broker_(broker), logger_(logger), options_(options),
+      bars_(options.queue_capacity), feed_done_(false), last_price_(0), elapsed_seconds_(0),
+      bars_processed_(0), symbol_id_(broker.registerSymbol(options.symbol)),
+      feed_allocations_(0), engine_allocations_(0), bar_signal_(Signal::HOLD), bar_filled_(false),
+      paced_(options.speed > 0 || options.feed_rate > 0) {
+    logger.performance().registerSymbol(options.symbol);
+}
+
+void LivePipeline::run(const OHLCV& last_bar, int64_t last_timestamp, int64_t interval_seconds) {
+    OHLCV previous = last_bar;
+    int64_t timestamp = last_timestamp;
+    last_price_ = last_bar.close;
+    // Sharpe/Sortino are annualised for one bar every interval_seconds
+    logger_.performance().setPeriodsPerYear(PerformanceTracker::periodsPerYear(last_timestamp,
+                                                                               last_timestamp + interval_seconds, 2));
+    feedLoop([&](Event& bar) {
+        previous = feed_.generateLiveData(previous);
+        timestamp += interval_seconds;
+        bar.timestamp = timestamp;
+        bar.price = previous.close;
+        bar.market.open = previous.open;
+        bar.market.high = previous.high;
+        bar.market.low = previous.low;
+        bar.market.volume = previous.volume;
+        return true;
+    });
+}
+
+void LivePipeline::replay(const BarSeries& series, size_t begin, size_t end) {
+    SeriesFeed recorded(series, symbol_id_, begin, end);
+    last_price_ = begin > 0 && begin <= series.size() ? series.close()[begin - 1] : 0.0;
+    // Annualised at the recorded bar spacing, as a backtest of the same bars would be
+    end = std::min(end, series.size());
+    if (end > begin) {
+        Span<const int64_t> timestamps = series.timestamps();
+        logger_.performance().setPeriodsPerYear(PerformanceTracker::periodsPerYear(timestamps[begin],
+                                                                                   timestamps[end - 1], end - begin));
+    }
+    feedLoop([&](Event& bar) { return recorded.next(bar); });
+}
+
+template <typename NextBar>
+void LivePipeline::feedLoop(NextBar next_bar) {
+    feed_done_.store(false);
+    auto start = std::chrono::steady_clock::now();
+    std::thread feed_thread([this, &next_bar]() {
+        // Each bar is due at an offset from the first: its timestamp distance
+        // over `speed`, or iteration / feed_rate
+        AllocationScope allocations;
+        bool by_timestamp = options_.speed > 0;
+        double seconds_per_bar = options_.feed_rate > 0 ? 1.0 / options_.feed_rate : 0.0;
+        int64_t first_timestamp = 0;
+        pacing_.start();
+        for (int iteration = 0; iteration < options_.iterations; ++iteration) {
+            if (options_.stop_flag && options_.stop_flag->load(std::memory_order_relaxed)) break;
+            Event bar;
+            if (!next_bar(bar)) break;
+            if (paced_ && iteration == 0) {
+                first_timestamp = bar.timestamp;
+            } else if (paced_) {
+                double due = by_timestamp ? (bar.timestamp - first_timestamp) / options_.speed
+                                          : iteration * seconds_per_bar;
+                auto offset = std::chrono::duration_cast<PaceTimer::Clock::duration>(
+                    std::chrono::duration<double>(due));
+                if (!pacing_.waitUntil(offset, options_.stop_flag)) break;
+            }
+            if (options_.record) {
+                options_.record->append(bar.timestamp, bar.market.open, bar.market.high, bar.market.low, bar.price,
+                                        bar.market.volume);
+            }
+            bar.type = EventType::MARKET;
+            bar.symbol = symbol_id_;
+            bar.bar = static_cast<uint32_t>(iteration);
+            TRADINGBOT_LATENCY_STAMP(bar.arrival_tick);
+            pushBlocking(bars_, bar);
+        }
+        feed_allocations_ = allocations.allocations();
+        feed_done_.store(true, std::memory_order_release);
+    });
+    engineLoop();
+    feed_thread.join();
+    elapsed_seconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void LivePipeline::engineLoop() {
+    CloseExecution execution(broker_);
+    SignalHandler signals(strategy_);
+    RiskHandler risk(risk_, broker_, execution);
+    TradeRecorder recorder(logger_, broker_);
+    EventEngine events;
+    attachTradingChain(events, signals, risk, execution, recorder);
+    events.subscribe(EventType::SIGNAL, this);
+    events.subscribe(EventType::FILL, this);
+    events.subscribeBarClose(this);
+#if TRADINGBOT_LATENCY_PROBES
+    events.setLatencyProfile(&latency_);  // without it the engine keeps its quiet-bar fast paths
+#endif
+    RingFeed feed(bars_, feed_done_);
+    AllocationScope allocations;
+    events.run(feed);
+    engine_allocations_ = allocations.allocations();
+}
+
+void LivePipeline::onEvent(const Event& event, EventEngine&) {
+    if (event.type == EventType::SIGNAL) {
+        bar_signal_ = event.side;
+    } else {
+        bar_filled_ = true;
+        bar_fill_ = event;
+    }
+}
+
+void LivePipeline::onBarClose(const Event& bar, EventEngine&) {
+    bars_processed_++;
+    last_price_ = bar.price;
+    if (options_.print_bars) {
+        double equity = broker_.getPortfolioValue(symbol_id_, bar.price);
+        std::cout << "\n--- Iteration " << bar.bar << " ---\n";
+        std::cout << "Current Price: INR " << bar.price << " | Signal: "
+                  << (bar_signal_ == Signal::BUY ? "BUY" : bar_signal_ == Signal::SELL ? "SELL" : "HOLD") << "\n";
+        if (bar_filled_) {
+            std::cout << (bar_fill_.side == Signal::BUY ? "BUY" : "SELL") << " executed: " << bar_fill_.quantity
+                      << " shares @ INR " << bar_fill_.price << " | Total: INR " << bar_fill_.quantity * bar_fill_.price
+                      << " | Balance: INR " << bar_fill_.fill.balance_after << "\n";
+        }
+        std::cout << "Portfolio Value: INR " << equity << "\n";
+        Statistics stats = logger_.performance().snapshot(broker_.getInitialBalance(), equity);
+        std::cout << "Running: " << stats.total_trades << " trades | Win Rate " << stats.win_rate
+                  << "% | P/L INR " << stats.total_profit_loss << " | Max DD " << stats.max_drawdown_pct
+                  << "% | Sharpe " << stats.sharpe_ratio << "\n";
+    }
+    bar_signal_ = Signal::HOLD;
+    bar_filled_ = false;
+}
+void LivePipeline::printLatencyReport() const {
+    latency_.printReport();
+    std::cout << std::fixed << std::setprecision(2);
+    double seconds = elapsed_seconds_ > 0 ? elapsed_seconds_ : 1.0;
+    std::cout << "  Throughput: " << bars_processed_ / seconds << " bars/s over "
+              << elapsed_seconds_ << " s\n";
+    if (paced_) {
+        const LatencyHistogram& late = pacing_.lateness();
+        std::cout << "  Feed timer (us late): p50 " << late.percentile(50.0) / 1000.0 << " | p99 "
+                  << late.percentile(99.0) / 1000.0 << " | max " << late.max() / 1000.0 << " | "
+                  << pacing_.behind() << " of " << late.count() << " bars already overdue\n";
+    }
+}
+}
@@ -0,0 +1,89 @@
+#ifndef LIVE_PIPELINE_H
+#define LIVE_PIPELINE_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include "Types.h"
+#include "SpscQueue.h"
+#include "LatencyHistogram.h"
+#include "PaceTimer.h"
+#include "EventEngine.h"
+#include "MarketDataHandler.h"
+#include "Strategy.h"
+#include "RiskManager.h"
+#include "BrokerSimulator.h"
+#include "TradeLogger.h"
+
+namespace TradingBot {
+
+struct LivePipelineOptions {
+    int iterations;
+    double feed_rate;        // bars per second; 0 = as fast as the pipeline drains
+    double speed;            // > 0: bars paced by their timestamps at speed x real time (overrides feed_rate)
+    bool print_bars;         // per-bar console lines on the engine thread
+    size_t queue_capacity;
+    std::string symbol;
+    const std::atomic<bool>* stop_flag;  // optional; the feed stops early once it is set
+    BarSeries* record;                   // optional; every bar fed is appended (read it after run/replay)
+
+    LivePipelineOptions() : iterations(100), feed_rate(2.0), speed(0), print_bars(true), queue_capacity(1024),
+                            symbol("NIFTY50"), stop_flag(nullptr), record(nullptr) {}
+};
+
+// Live and replay drivers for the EventEngine:
+//   feed thread  --MARKET events-->  engine thread (strategy, risk, execution, logging)
+// connected by a lock-free SPSC ring. The feed either simulates new bars
+// (run) or plays back recorded ones (replay); the caller's thread runs the
+// engine with the same handler chain a backtest uses, so live trades follow
+// the backtest's rules. A full ring blocks the feed (back-pressure), so no
+// bar is ever dropped.
+class LivePipeline : private EventHandler {
+public:
+    LivePipeline(MarketDataHandler& feed, Strategy& strategy, RiskManager& risk,
+                 BrokerSimulator& broker, TradeLogger& logger, const LivePipelineOptions& options);
+    // options.iterations simulated bars continuing from `last_bar`, spaced
+    // `interval_seconds` after `last_timestamp`; returns when all are executed
+    void run(const OHLCV& last_bar, int64_t last_timestamp, int64_t interval_seconds);
+    // Bars [begin, end) of a recorded series at options.speed or options.feed_rate
+    void replay(const BarSeries& series, size_t begin, size_t end);
+    void printLatencyReport() const;
+    const LatencyProfile& latency() const { return latency_; }
+    double lastPrice() const { return last_price_; }
+    double elapsedSeconds() const { return elapsed_seconds_; }
+    size_t barsProcessed() const { return static_cast<size_t>(bars_processed_); }
+    uint64_t loopAllocations() const { return feed_allocations_ + engine_allocations_; } // inside both loops
+    uint64_t feedAllocations() const { return feed_allocations_; } // all of the feed thread's; it is only a loop
+private:
+    MarketDataHandler& feed_;
+    Strategy& strategy_;
+    RiskManager& risk_;
+    BrokerSimulator& broker_;
+    TradeLogger& logger_;
+    LivePipelineOptions options_;
+    SpscQueue<Event> bars_;
+    std::atomic<bool> feed_done_;
+    double last_price_;
+    double elapsed_seconds_;
+    uint64_t bars_processed_;
+    SymbolId symbol_id_;
+    uint64_t feed_allocations_;     // each written by its own thread, read after join
+    uint64_t engine_allocations_;
+    Signal bar_signal_;             // what the current bar produced, for the console line
+    bool bar_filled_;
+    Event bar_fill_;
+    // Stage latencies include the time a bar waits in the ring
+    LatencyProfile latency_;
+    PaceTimer pacing_;              // feed thread only, read after join
+    bool paced_;
+
+    template <typename NextBar>
+    void feedLoop(NextBar next_bar);
+    void engineLoop();
+    // Console output per bar, off the timed path
+    void onEvent(const Event& event, EventEngine& engine) override;
+    void onBarClose(const Event& bar, EventEngine& engine) override;
+};
+}
+
+#endif
@@ -0,0 +1,93 @@
+#include "MappedFile.h"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace TradingBot {
+
+#ifdef _WIN32
+MappedFile::MappedFile()
+    : data_(nullptr), size_(0), is_open_(false), file_handle_(nullptr), mapping_handle_(nullptr) {}
+#else
+MappedFile::MappedFile() : data_(nullptr), size_(0), is_open_(false), fd_(-1) {}
+#endif
+MappedFile::~MappedFile() {
+    close();
+}
+
+#ifdef _WIN32
+bool MappedFile::open(const std::string& filename) {
+    close();
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size)) {
+        CloseHandle(file);
+        return false;
+    }
+    file_handle_ = file;
+    size_ = static_cast<size_t>(file_size.QuadPart);
+    is_open_ = true;
+    if (size_ == 0) return true;  // nothing to map
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        close();
+        return false;
+    }
+    mapping_handle_ = mapping;
+    data_ = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (data_ == nullptr) {
+        close();
+        return false;
+    }
+    return true;
+}
+void MappedFile::close() {
+    if (data_) UnmapViewOfFile(data_);
+    if (mapping_handle_) CloseHandle(static_cast<HANDLE>(mapping_handle_));
+    if (file_handle_) CloseHandle(static_cast<HANDLE>(file_handle_));
+    data_ = nullptr;
+    mapping_handle_ = nullptr;
+    file_handle_ = nullptr;
+    size_ = 0;
+    is_open_ = false;
+}
+#else
+bool MappedFile::open(const std::string& filename) {
+    close();
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+    fd_ = fd;
+    size_ = static_cast<size_t>(st.st_size);
+    is_open_ = true;
+    if (size_ == 0) return true;  // mmap rejects zero-length mappings
+    void* addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+        close();
+        return false;
+    }
+    madvise(addr, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const char*>(addr);
+    return true;
+}
+void MappedFile::close() {
+    if (data_) munmap(const_cast<char*>(data_), size_);
+    if (fd_ >= 0) ::close(fd_);
+    data_ = nullptr;
+    fd_ = -1;
+    size_ = 0;
+    is_open_ = false;
+}
+#endif
+}
@@ -0,0 +1,37 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+namespace TradingBot {
+
+// Read-only memory mapping of a whole file (mmap / MapViewOfFile)
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& filename); // false if missing/unreadable; an empty file maps to size 0
+    void close();
+    bool isOpen() const { return is_open_; }
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+    std::string_view view() const { return std::string_view(data_, size_); }
+private:
+    const char* data_;
+    size_t size_;
+    bool is_open_;
+#ifdef _WIN32
+    void* file_handle_;
+    void* mapping_handle_;
+#else
+    int fd_;
+#endif
+};
+}
+
+#endif
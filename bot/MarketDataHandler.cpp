@@ -1,92 +1,149 @@
 #include "MarketDataHandler.h"
+#include "MappedFile.h"
+#include "BarCache.h"
+#include "ThreadPool.h"
 #include <iostream>
-#include <sstream>
 #include <algorithm>
-#include <random>
 #include <chrono>
 
 namespace TradingBot {
 
-MarketDataHandler::MarketDataHandler() {}
+MarketDataHandler::MarketDataHandler() : load_threads_(0), use_cache_(false), rebuild_cache_(false), verbose_(true) {}
 MarketDataHandler::~MarketDataHandler() {}
-std::string MarketDataHandler::trim(const std::string& str) {
-    size_t first = str.find_first_not_of(" \t\r\n");
-    if (first == std::string::npos) return "";
-    size_t last = str.find_last_not_of(" \t\r\n");
-    return str.substr(first, (last - first + 1));
-}
-OHLCV MarketDataHandler::parseCSVLine(const std::string& line) {
-    OHLCV data;
-    std::stringstream ss(line);
-    std::string token;
-    int field = 0;
-    
-    while (std::getline(ss, token, ',')) {
-        token = trim(token);        
-        try {
-            switch (field) {
-                case 0: data.date = token; break;
-                case 1: data.open = std::stod(token); break;
-                case 2: data.high = std::stod(token); break;
-                case 3: data.low = std::stod(token); break;
-                case 4: data.close = std::stod(token); break;
-                case 5: data.volume = std::stoll(token); break;
-            }
-        } catch (const std::exception& e) {
-            std::cerr << "Error parsing field " << field << ": " << token << std::endl;
-        }
-        field++;
-    }    
-    return data;
-}
 bool MarketDataHandler::loadFromCSV(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
+    auto start = std::chrono::steady_clock::now();
+    other_timeframes_.clear();
+    if (use_cache_ && !rebuild_cache_ && BarCache::load(filename, data_)) {
+        last_report_ = CsvLoadReport();
+        last_report_.lines = last_report_.loaded = data_.size();
+        last_report_.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (verbose_) std::cout << "Loaded " << data_.size() << " data points from "
+                                << BarCache::cachePathFor(filename) << " (binary cache)" << std::endl;
+        resample();
+        return !data_.empty();
+    }
+    MappedFile file;
+    if (!file.open(filename)) {
         std::cerr << "Error: Could not open data file: " << filename << std::endl;
         return false;
     }    
-    std::string line;
-    bool first_line = true;    
-    while (std::getline(file, line)) {
-        if (first_line) {
-            first_line = false;
-            continue;
-        }        
-        if (line.empty()) continue;        
-        OHLCV data = parseCSVLine(line);
-        if (data.close > 0) { 
-            data_.push_back(data);
-        }
-    }    
-    file.close();    
-    std::cout << "Loaded " << data_.size() << " data points from " << filename << std::endl;
+    std::string_view text = file.view();
+    last_report_ = CsvLoadReport();
+    last_report_.bytes = text.size();
+    data_.clear();
+    if (isTickHeader(text.substr(0, skipLine(text)))) return loadTicks(filename, text, start);
+
+    // Size the columns from the line length of the first block of the file,
+    // with a little headroom so a slightly shorter tail doesn't reallocate
+    size_t sample = std::min<size_t>(text.size(), 64 * 1024);
+    size_t sample_lines = static_cast<size_t>(std::count(text.begin(), text.begin() + sample, '\n'));
+    if (sample_lines > 0) {
+        size_t estimate = text.size() / (sample / sample_lines) + 1;
+        data_.reserve(estimate + estimate / 16);
+    }
+
+    std::string_view body = text.substr(skipLine(text));  // header
+    size_t threads = load_threads_ == 0 ? ThreadPool::defaultThreadCount() : load_threads_;
+    if (threads > 1 && body.size() >= kParallelLoadThreshold) {
+        parseParallel(body, threads);
+    } else {
+        parseBarRows(body, 2, data_, last_report_);
+    }
+    if (!data_.isSorted()) {
+        std::cerr << "Warning: data in " << filename << " is not chronologically sorted; sorting "
+                  << data_.size() << " rows" << std::endl;
+        data_.sortByTime();
+    }
+    last_report_.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (verbose_) std::cout << "Loaded " << data_.size() << " data points from " << filename << std::endl;
+    if (last_report_.malformed > 0) {
+        std::cerr << "Warning: skipped " << last_report_.malformed << " malformed rows (first at line "
+                  << last_report_.first_malformed_line << ")" << std::endl;
+    }
+    if (use_cache_ && !data_.empty() && !BarCache::save(filename, data_)) {
+        std::cerr << "Warning: Could not write data cache " << BarCache::cachePathFor(filename) << std::endl;
+    }
+    resample();
     return !data_.empty();
 }
-const OHLCV& MarketDataHandler::getDataAt(size_t index) const {
+// Ticks go straight from the mapped file into the aggregators; only the
+// bars are kept (and no binary cache is written)
+bool MarketDataHandler::loadTicks(const std::string& filename, std::string_view text,
+                                  std::chrono::steady_clock::time_point start) {
+    MultiTimeframeAggregator aggregator(timeframes_.empty() ? std::vector<BarSpec>(1, BarSpec::time(60)) : timeframes_);
+    aggregateTickRows(text.substr(skipLine(text)), 2, aggregator, last_report_);
+    aggregator.flush();
+    last_report_.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (verbose_) std::cout << "Loaded " << last_report_.loaded << " ticks from " << filename << std::endl;
+    if (last_report_.malformed > 0) {
+        std::cerr << "Warning: skipped " << last_report_.malformed << " malformed ticks (first at line "
+                  << last_report_.first_malformed_line << ")" << std::endl;
+    }
+    takeTimeframes(aggregator);
+    return !data_.empty();
+}
+void MarketDataHandler::resample() {
+    if (timeframes_.empty() || data_.empty()) return;
+    MultiTimeframeAggregator aggregator(timeframes_);
+    aggregator.addBars(data_);
+    aggregator.flush();
+    takeTimeframes(aggregator);
+}
+void MarketDataHandler::takeTimeframes(MultiTimeframeAggregator& aggregator) {
+    aggregator[0].takeBars(data_);
+    other_timeframes_.resize(aggregator.size() - 1);
+    for (size_t i = 1; i < aggregator.size(); ++i) aggregator[i].takeBars(other_timeframes_[i - 1]);
+    if (!verbose_) return;
+    std::cout << "Resampled to";
+    for (size_t i = 0; i < aggregator.size(); ++i) {
+        std::cout << (i ? ", " : " ") << describeBarSpec(aggregator[i].spec()) << " (" << getSeries(i).size()
+                  << " bars)";
+    }
+    std::cout << std::endl;
+}
+void MarketDataHandler::parseParallel(std::string_view body, size_t threads) {
+    // A few chunks per thread keeps the tail short when rows vary in length
+    std::vector<size_t> bounds = splitAtLines(body, threads * 4);
+    size_t chunks = bounds.size() - 1;
+    std::vector<BarSeries> parts(chunks);
+    std::vector<CsvLoadReport> reports(chunks);
+    std::vector<size_t> line_counts(chunks, 0);
+    ThreadPool pool(std::min(threads, chunks));
+    parallelFor(pool, chunks, [&](size_t k) {
+        std::string_view chunk = body.substr(bounds[k], bounds[k + 1] - bounds[k]);
+        parts[k].reserve(chunk.size() / 32);
+        // line numbers are chunk-relative here and rebased while stitching
+        line_counts[k] = parseBarRows(chunk, 0, parts[k], reports[k]);
+    });
+
+    // Stitch the chunks back together in file order
+    size_t total = 0;
+    for (const auto& part : parts) total += part.size();
+    data_.reserve(total);
+    size_t first_line = 2;
+    for (size_t k = 0; k < chunks; ++k) {
+        data_.append(parts[k]);
+        last_report_.lines += reports[k].lines;
+        last_report_.loaded += reports[k].loaded;
+        if (reports[k].malformed > 0 && last_report_.malformed == 0) {
+            last_report_.first_malformed_line = first_line + reports[k].first_malformed_line;
+        }
+        last_report_.malformed += reports[k].malformed;
+        first_line += line_counts[k];
+        BarSeries().swap(parts[k]);  // release the chunk's memory as we go
+    }
+}
+OHLCV MarketDataHandler::getDataAt(size_t index) const {
     if (index >= data_.size()) {
         throw std::out_of_range("Index out of range in market data");
     }
-    return data_[index];
+    return data_.barAt(index);
 }
 OHLCV MarketDataHandler::generateLiveData(const OHLCV& previous) {
-    
-    // Simulate random price movement for live mode
-    static std::random_device rd;
-    static std::mt19937 gen(static_cast<unsigned int>(
-        rd() ^ static_cast<unsigned int>(std::chrono::high_resolution_clock::now().time_since_epoch().count())));
-
-    // Uses a normal distribution for percent change (in basis points)
-    static std::normal_distribution<> price_change(0.0, 0.5);  // Mean 0, StdDev 0.5%
-    std::normal_distribution<> vol_change_dist(0.0, 200000.0);
-
-    OHLCV live_data;
-    double change_percent = price_change(gen) / 100.0;    
-    live_data.open = previous.close;
-    live_data.close = previous.close * (1.0 + change_percent);
-    live_data.high = std::max(live_data.open, live_data.close) * 1.002;
-    live_data.low = std::min(live_data.open, live_data.close) * 0.998;
-    long long vdelta = static_cast<long long>(std::llround(vol_change_dist(gen)));
-    live_data.volume = std::max<long long>(0, static_cast<long long>(previous.volume) + vdelta);
-    return live_data;
+    return live_generator_.nextBar(previous);
+}
+void MarketDataHandler::setGeneratorParams(const GeneratorParams& params, uint64_t stream) {
+    live_generator_ = MarketGenerator(params, stream);
+}
 }
-} 
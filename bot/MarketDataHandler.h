@@ -1,10 +1,14 @@
 #ifndef MARKET_DATA_HANDLER_H
 #define MARKET_DATA_HANDLER_H
 
+#include <chrono>
 #include <string>
 #include <vector>
-#include <fstream>
 #include "Types.h"
+#include "BarSeries.h"
+#include "CsvParser.h"
+#include "BarAggregator.h"
+#include "MarketGenerator.h"
 
 namespace TradingBot {
 class MarketDataHandler {
@@ -12,15 +16,43 @@ public:
     MarketDataHandler();
     ~MarketDataHandler();
     bool loadFromCSV(const std::string& filename); //load csv
-    const OHLCV& getDataAt(size_t index) const;
+    const CsvLoadReport& getLoadReport() const { return last_report_; } // stats of the last load
+    void setLoadThreads(size_t threads) { load_threads_ = threads; } // 0 = all cores, 1 = serial
+    void setUseCache(bool use_cache) { use_cache_ = use_cache; } // read/write the <csv>.bars sidecar
+    void setRebuildCache(bool rebuild) { rebuild_cache_ = rebuild; } // ignore an existing sidecar
+    void setVerbose(bool verbose) { verbose_ = verbose; } // "Loaded N data points" lines
+    // Resample what is loaded (bars or ticks) to these timeframes in one
+    // pass; the first becomes the series, empty = bars as loaded (ticks
+    // become 1-minute bars)
+    void setTimeframes(const std::vector<BarSpec>& timeframes) { timeframes_ = timeframes; }
+    OHLCV getDataAt(size_t index) const;
     size_t getDataSize() const { return data_.size(); }
-    const std::vector<OHLCV>& getAllData() const { return data_; }    
+    const BarSeries& getSeries() const { return data_; }    
+    size_t getTimeframeCount() const { return 1 + other_timeframes_.size(); }
+    const BarSeries& getSeries(size_t timeframe) const {   // 0 = getSeries()
+        return timeframe == 0 ? data_ : other_timeframes_[timeframe - 1];
+    }
+    // Synthetic live bars: the next bar after `previous` from a seeded
+    // generator (same seed, same bars)
     OHLCV generateLiveData(const OHLCV& previous);
+    void setGeneratorParams(const GeneratorParams& params, uint64_t stream = 0);
     
 private:
-    std::vector<OHLCV> data_;    
-    OHLCV parseCSVLine(const std::string& line);  // Helper function to parse CSV line
-    std::string trim(const std::string& str);
+    BarSeries data_;    
+    std::vector<BarSpec> timeframes_;
+    std::vector<BarSeries> other_timeframes_;   // timeframes_[1..]
+    CsvLoadReport last_report_;
+    MarketGenerator live_generator_;
+    size_t load_threads_;
+    bool use_cache_;
+    bool rebuild_cache_;
+    bool verbose_;
+    static const size_t kParallelLoadThreshold = 8 * 1024 * 1024;  // smaller files parse serially
+    void parseParallel(std::string_view body, size_t threads);
+    bool loadTicks(const std::string& filename, std::string_view text,
+                   std::chrono::steady_clock::time_point start);
+    void resample();    // data_ to timeframes_
+    void takeTimeframes(MultiTimeframeAggregator& aggregator);
 };
 }
 
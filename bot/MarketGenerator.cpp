@@ -0,0 +1,196 @@
+#include "MarketGenerator.h"
+#include <algorithm>
+
+namespace TradingBot {
+
+namespace {
+const double kZigguratEdge = 3.442619855899;    // start of the tail
+const double kZigguratArea = 9.91256303526217e-3;
+}
+
+ZigguratTables::ZigguratTables() {
+    const double m = 2147483648.0;
+    double edge = kZigguratEdge;
+    double previous = edge;
+    double q = kZigguratArea / std::exp(-0.5 * edge * edge);
+    k[0] = static_cast<uint32_t>((edge / q) * m);
+    k[1] = 0;
+    w[0] = q / m;
+    w[127] = edge / m;
+    f[0] = 1.0;
+    f[127] = std::exp(-0.5 * edge * edge);
+    for (int i = 126; i >= 1; --i) {
+        edge = std::sqrt(-2.0 * std::log(kZigguratArea / edge + std::exp(-0.5 * edge * edge)));
+        k[i + 1] = static_cast<uint32_t>((edge / previous) * m);
+        previous = edge;
+        f[i] = std::exp(-0.5 * edge * edge);
+        w[i] = edge / m;
+    }
+}
+const ZigguratTables kZiggurat;
+
+void Philox::block(const uint32_t key[2], const uint32_t counter[4], uint32_t out[4]) {
+    uint32_t k0 = key[0], k1 = key[1];
+    uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+    for (int round = 0; round < 10; ++round) {
+        uint64_t p0 = static_cast<uint64_t>(0xD2511F53u) * c0;
+        uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57u) * c2;
+        c0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+        c1 = static_cast<uint32_t>(p1);
+        c2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+        c3 = static_cast<uint32_t>(p0);
+        k0 += 0x9E3779B9u;
+        k1 += 0xBB67AE85u;
+    }
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+void Philox::refill() {
+    // block() on kBlocks consecutive counters, lane by lane
+    uint32_t c0[kBlocks], c1[kBlocks], c2[kBlocks], c3[kBlocks];
+    for (int b = 0; b < kBlocks; ++b) {
+        uint64_t counter = block_index_ + b;
+        c0[b] = static_cast<uint32_t>(counter);
+        c1[b] = static_cast<uint32_t>(counter >> 32);
+        c2[b] = stream_[0];
+        c3[b] = stream_[1];
+    }
+    uint32_t k0 = key_[0], k1 = key_[1];
+    for (int round = 0; round < 10; ++round) {
+        // Kept a loop so it vectorises: -O3 would otherwise unroll it
+        // completely first and lose half the throughput
+#if defined(__GNUC__)
+#pragma GCC unroll 1
+#endif
+        for (int b = 0; b < kBlocks; ++b) {
+            uint64_t p0 = static_cast<uint64_t>(0xD2511F53u) * c0[b];
+            uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57u) * c2[b];
+            c0[b] = static_cast<uint32_t>(p1 >> 32) ^ c1[b] ^ k0;
+            c1[b] = static_cast<uint32_t>(p1);
+            c2[b] = static_cast<uint32_t>(p0 >> 32) ^ c3[b] ^ k1;
+            c3[b] = static_cast<uint32_t>(p0);
+        }
+        k0 += 0x9E3779B9u;
+        k1 += 0xBB67AE85u;
+    }
+    for (int b = 0; b < kBlocks; ++b) {
+        words_[4 * b] = c0[b];
+        words_[4 * b + 1] = c1[b];
+        words_[4 * b + 2] = c2[b];
+        words_[4 * b + 3] = c3[b];
+    }
+    block_index_ += kBlocks;
+    index_ = 0;
+}
+
+// Wedges between the layer rectangles and the curve, and the tail beyond the edge
+double Philox::normalSlow(uint32_t layer, int32_t value) {
+    for (;;) {
+        double x = value * kZiggurat.w[layer];
+        if (layer == 0) {
+            double tail, y;
+            do {
+                tail = -std::log(uniform()) / kZigguratEdge;
+                y = -std::log(uniform());
+            } while (y + y < tail * tail);
+            return value > 0 ? kZigguratEdge + tail : -kZigguratEdge - tail;
+        }
+        if (kZiggurat.f[layer] + uniform() * (kZiggurat.f[layer - 1] - kZiggurat.f[layer]) < std::exp(-0.5 * x * x)) {
+            return x;
+        }
+        layer = next() & 127;
+        value = static_cast<int32_t>(next());
+        uint32_t magnitude = value < 0 ? 0u - static_cast<uint32_t>(value) : static_cast<uint32_t>(value);
+        if (magnitude < kZiggurat.k[layer]) return value * kZiggurat.w[layer];
+    }
+}
+
+MarketGenerator::MarketGenerator(const GeneratorParams& params, uint64_t stream)
+    : params_(params), rng_(params.seed, stream), price_(params.start_price), timestamp_(params.start_timestamp),
+      regime_(0), jump_compensation_(0) {
+    if (params_.model == PriceModel::REGIME_SWITCHING && params_.regimes.empty()) {
+        // Calm and drifting up, volatile and selling off; the drifts cancel
+        // over the time spent in each (100 vs 20 bars on average)
+        params_.regimes.push_back(MarketRegime(0.00001, 0.003, 0.01));
+        params_.regimes.push_back(MarketRegime(-0.00005, 0.012, 0.05));
+    }
+    if (params_.model == PriceModel::JUMP_DIFFUSION) {
+        jump_compensation_ = params_.jump_probability * params_.jump_mean;
+    }
+}
+
+double MarketGenerator::nextReturn(double& volatility, double& shock) {
+    double drift = params_.drift;
+    volatility = params_.volatility;
+    if (params_.model == PriceModel::REGIME_SWITCHING) {
+        // Leave the regime with its switch probability, for one of the others at random
+        size_t count = params_.regimes.size();
+        double u = rng_.uniform();
+        double leave = params_.regimes[regime_].switch_probability;
+        if (count > 1 && u < leave) {
+            size_t step = 1 + std::min(static_cast<size_t>(u / leave * (count - 1)), count - 2);
+            regime_ = (regime_ + step) % count;
+        }
+        drift = params_.regimes[regime_].drift;
+        volatility = params_.regimes[regime_].volatility;
+    }
+    shock = rng_.normal();
+    double log_return = drift + volatility * shock;
+    if (params_.model == PriceModel::JUMP_DIFFUSION) {
+        log_return -= jump_compensation_;
+        if (rng_.uniform() < params_.jump_probability) {
+            double jump = params_.jump_mean + params_.jump_volatility * rng_.normal();
+            log_return += jump;
+            if (volatility > 0) shock += jump / volatility;
+        }
+    }
+    return log_return;
+}
+
+void MarketGenerator::generate(size_t count, int64_t* timestamps, double* open, double* high, double* low,
+                               double* close, int64_t* volume) {
+    for (size_t i = 0; i < count; ++i) {
+        double volatility, shock;
+        double bar_open = price_;
+        price_ *= std::exp(nextReturn(volatility, shock));
+        // Wicks reach up to one volatility beyond the body (16 bits each of
+        // one draw); volume grows with the move
+        uint32_t wicks = rng_.next();
+        double wick_up = ((wicks >> 16) + 0.5) * (1.0 / 65536.0) * volatility;
+        double wick_down = ((wicks & 0xFFFF) + 0.5) * (1.0 / 65536.0) * volatility;
+        double bar_volume = params_.base_volume * (0.5 + rng_.uniform()) * (0.5 + 0.5 * std::abs(shock));
+        if (timestamps) timestamps[i] = timestamp_;
+        if (open) open[i] = bar_open;
+        if (high) high[i] = std::max(bar_open, price_) * (1.0 + wick_up);
+        if (low) low[i] = std::min(bar_open, price_) * (1.0 - wick_down);
+        if (close) close[i] = price_;
+        if (volume) volume[i] = static_cast<int64_t>(bar_volume);
+        timestamp_ += params_.bar_seconds;
+    }
+}
+
+void MarketGenerator::generate(size_t count, BarSeries& out) {
+    static const size_t kChunk = 4096;
+    int64_t timestamps[kChunk], volume[kChunk];
+    double open[kChunk], high[kChunk], low[kChunk], close[kChunk];
+    out.reserve(out.size() + count);
+    for (size_t done = 0; done < count; done += kChunk) {
+        size_t n = std::min(kChunk, count - done);
+        generate(n, timestamps, open, high, low, close, volume);
+        for (size_t i = 0; i < n; ++i) out.append(timestamps[i], open[i], high[i], low[i], close[i], volume[i]);
+    }
+}
+
+OHLCV MarketGenerator::nextBar(const OHLCV& previous) {
+    price_ = previous.close;
+    int64_t timestamp;
+    int64_t bar_volume;
+    OHLCV bar;
+    generate(1, &timestamp, &bar.open, &bar.high, &bar.low, &bar.close, &bar_volume);
+    bar.volume = bar_volume;
+    return bar;
+}
+}
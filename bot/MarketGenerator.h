@@ -0,0 +1,116 @@
+#ifndef MARKET_GENERATOR_H
+#define MARKET_GENERATOR_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include "Types.h"
+#include "BarSeries.h"
+
+namespace TradingBot {
+
+// Layer tables of the 128-layer ziggurat for standard normals (Marsaglia and
+// Tsang, 2000), built once at start-up
+struct ZigguratTables {
+    uint32_t k[128];        // |x| below k[i] is inside layer i's rectangle
+    double w[128];          // scale from a 32-bit integer to x in layer i
+    double f[128];          // density at the layer edges
+    ZigguratTables();
+};
+extern const ZigguratTables kZiggurat;
+
+// Philox4x32-10 counter-based generator (Salmon et al., "Parallel random
+// numbers: as easy as 1, 2, 3", SC'11). Output block n of a stream is a
+// pure function of (seed, stream, n): ten rounds of two 32x32->64
+// multiplies over a 128-bit counter. Streams never overlap and any position
+// can be reached in O(1) with seek(), so every thread, symbol or partition
+// gets its own independent sequence without coordination. Blocks are
+// computed eight at a time: one block is a serial chain of multiplies, eight
+// independent ones keep the multiplier busy (and vectorise).
+//
+// An instance is not shared between threads; give each its own stream.
+class Philox {
+public:
+    Philox(uint64_t seed, uint64_t stream) : block_index_(0), index_(kWords) {
+        key_[0] = static_cast<uint32_t>(seed);
+        key_[1] = static_cast<uint32_t>(seed >> 32);
+        stream_[0] = static_cast<uint32_t>(stream);
+        stream_[1] = static_cast<uint32_t>(stream >> 32);
+    }
+    uint32_t next() {
+        if (index_ == kWords) refill();
+        return words_[index_++];
+    }
+    // Uniform in (0, 1), never exactly 0 or 1
+    double uniform() { return (next() + 0.5) * (1.0 / 4294967296.0); }
+    // Standard normal by the ziggurat: a table lookup and a multiply on
+    // ~99% of calls. The layer comes from its own word so it is
+    // independent of the value bits.
+    double normal() {
+        uint32_t layer = next() & 127;
+        int32_t value = static_cast<int32_t>(next());
+        uint32_t magnitude = value < 0 ? 0u - static_cast<uint32_t>(value) : static_cast<uint32_t>(value);
+        if (magnitude < kZiggurat.k[layer]) return value * kZiggurat.w[layer];
+        return normalSlow(layer, value);
+    }
+    // Jump to output block `index` of this stream
+    void seek(uint64_t index) {
+        block_index_ = index;
+        index_ = kWords;
+    }
+    // One Philox4x32-10 block
+    static void block(const uint32_t key[2], const uint32_t counter[4], uint32_t out[4]);
+private:
+    static const int kBlocks = 8;
+    static const int kWords = 4 * kBlocks;
+    uint32_t key_[2];
+    uint32_t stream_[2];        // high half of the counter
+    uint64_t block_index_;      // low half: next block to compute
+    uint32_t words_[kWords];
+    int index_;                 // next unused word
+
+    void refill();
+    double normalSlow(uint32_t layer, int32_t value);
+};
+
+// Deterministic synthetic bars for stress datasets and repeatable live
+// simulations. The price follows GeneratorParams::model in log returns
+// (exact GBM discretisation; the mean jump is taken off the drift so
+// `drift` stays the mean log return), each bar opens at the previous
+// close, and high/low/volume are
+// drawn around the move. Everything comes from one Philox stream, so a
+// (seed, stream) pair always produces the same bars however many
+// generators run beside it.
+//
+// No shared state: one generator per thread, each on its own stream
+// (streamId(symbol, partition) for generators that must not overlap).
+class MarketGenerator {
+public:
+    explicit MarketGenerator(const GeneratorParams& params = GeneratorParams(), uint64_t stream = 0);
+    static uint64_t streamId(uint32_t symbol, uint32_t partition) {
+        return (static_cast<uint64_t>(symbol) << 32) | partition;
+    }
+    // The next `count` bars into caller-owned columns (any may be null)
+    void generate(size_t count, int64_t* timestamps, double* open, double* high, double* low, double* close,
+                  int64_t* volume);
+    void generate(size_t count, BarSeries& out);    // appended to `out`
+    // One bar continuing from `previous` (its close becomes the open); the
+    // date is left empty for the caller to stamp
+    OHLCV nextBar(const OHLCV& previous);
+    double price() const { return price_; }
+    int64_t timestamp() const { return timestamp_; }    // of the next bar
+    size_t regime() const { return regime_; }
+private:
+    GeneratorParams params_;
+    Philox rng_;
+    double price_;
+    int64_t timestamp_;
+    size_t regime_;
+    double jump_compensation_;  // jump_probability * jump_mean, taken off the drift
+
+    // Log return of the next bar; `shock` gets the size of the move in standard deviations
+    double nextReturn(double& volatility, double& shock);
+};
+}
+
+#endif
@@ -0,0 +1,253 @@
+#include "MatchingEngine.h"
+#include <algorithm>
+#include <limits>
+
+namespace TradingBot {
+
+namespace {
+// Price-time priority: does `existing` stay ahead of `node`?
+bool buyLimitAhead(const OrderNode* existing, const OrderNode* node) {
+    return existing->limit_price > node->limit_price ||
+           (existing->limit_price == node->limit_price && existing->sequence < node->sequence);
+}
+bool sellLimitAhead(const OrderNode* existing, const OrderNode* node) {
+    return existing->limit_price < node->limit_price ||
+           (existing->limit_price == node->limit_price && existing->sequence < node->sequence);
+}
+bool buyStopAhead(const OrderNode* existing, const OrderNode* node) {
+    return existing->stop_price < node->stop_price ||
+           (existing->stop_price == node->stop_price && existing->sequence < node->sequence);
+}
+bool sellStopAhead(const OrderNode* existing, const OrderNode* node) {
+    return existing->stop_price > node->stop_price ||
+           (existing->stop_price == node->stop_price && existing->sequence < node->sequence);
+}
+}
+
+OrderRequest OrderRequest::market(SymbolId symbol, Signal side, int quantity) {
+    OrderRequest request;
+    request.symbol = symbol;
+    request.side = side;
+    request.type = OrderType::MARKET;
+    request.quantity = quantity;
+    return request;
+}
+OrderRequest OrderRequest::limit(SymbolId symbol, Signal side, int quantity, double limit_price) {
+    OrderRequest request = market(symbol, side, quantity);
+    request.type = OrderType::LIMIT;
+    request.limit_price = limit_price;
+    return request;
+}
+OrderRequest OrderRequest::stop(SymbolId symbol, Signal side, int quantity, double stop_price) {
+    OrderRequest request = market(symbol, side, quantity);
+    request.type = OrderType::STOP;
+    request.stop_price = stop_price;
+    return request;
+}
+OrderRequest OrderRequest::stopLimit(SymbolId symbol, Signal side, int quantity, double stop_price, double limit_price) {
+    OrderRequest request = market(symbol, side, quantity);
+    request.type = OrderType::STOP_LIMIT;
+    request.stop_price = stop_price;
+    request.limit_price = limit_price;
+    return request;
+}
+
+MatchingEngine::MatchingEngine(const ExecutionSettings& settings) : settings_(settings), next_sequence_(0) {}
+
+void MatchingEngine::reserve(size_t symbols, size_t orders) {
+    if (symbols > books_.size()) books_.resize(symbols);
+    pool_.reserve(orders);
+}
+
+OrderId MatchingEngine::submit(const OrderRequest& request) {
+    if (request.quantity <= 0 || request.side == Signal::HOLD || request.symbol == kInvalidSymbol) return kInvalidOrder;
+    bool needs_limit = request.type == OrderType::LIMIT || request.type == OrderType::STOP_LIMIT;
+    bool needs_stop = request.type == OrderType::STOP || request.type == OrderType::STOP_LIMIT;
+    if ((needs_limit && !(request.limit_price > 0)) || (needs_stop && !(request.stop_price > 0))) return kInvalidOrder;
+    if (request.symbol >= books_.size()) books_.resize(request.symbol + 1);
+
+    OrderNode* node = pool_.acquire();
+    node->id = (static_cast<OrderId>(node->generation) << 32) | node->slot;
+    node->sequence = next_sequence_++;
+    node->symbol = request.symbol;
+    node->side = request.side;
+    node->type = request.type;
+    node->quantity = request.quantity;
+    node->filled = 0;
+    node->limit_price = request.limit_price;
+    node->stop_price = request.stop_price;
+    enqueue(books_[request.symbol], node);
+    return node->id;
+}
+
+bool MatchingEngine::cancel(OrderId id) {
+    OrderNode* node = pool_.find(id);
+    if (!node) return false;
+    Book& book = books_[node->symbol];
+    listFor(book, node).remove(node);
+    release(book, node);
+    return true;
+}
+
+void MatchingEngine::cancelAll(SymbolId symbol) {
+    if (!hasOrders(symbol)) return;
+    Book& book = books_[symbol];
+    OrderList* lists[] = {&book.market, &book.buy_limits, &book.sell_limits, &book.buy_stops, &book.sell_stops};
+    for (OrderList* list : lists) {
+        while (OrderNode* node = list->front()) {
+            list->remove(node);
+            release(book, node);
+        }
+    }
+}
+
+OrderList& MatchingEngine::listFor(Book& book, const OrderNode* node) {
+    bool buy = node->side == Signal::BUY;
+    switch (node->type) {
+        case OrderType::MARKET: return book.market;
+        case OrderType::LIMIT: return buy ? book.buy_limits : book.sell_limits;
+        default: return buy ? book.buy_stops : book.sell_stops;
+    }
+}
+
+void MatchingEngine::enqueue(Book& book, OrderNode* node) {
+    bool buy = node->side == Signal::BUY;
+    switch (node->type) {
+        case OrderType::MARKET:
+            book.market.pushBack(node);
+            break;
+        case OrderType::LIMIT:
+            if (buy) book.buy_limits.insert(node, buyLimitAhead);
+            else book.sell_limits.insert(node, sellLimitAhead);
+            break;
+        default:
+            if (buy) book.buy_stops.insert(node, buyStopAhead);
+            else book.sell_stops.insert(node, sellStopAhead);
+            break;
+    }
+    book.count++;
+}
+
+void MatchingEngine::release(Book& book, OrderNode* node) {
+    book.count--;
+    pool_.release(node);
+}
+
+double MatchingEngine::fees(Signal side, int quantity, double price) const {
+    double value = quantity * price;
+    double brokerage = value * settings_.brokerage_pct / 100.0;
+    if (settings_.brokerage_per_order > 0) {
+        brokerage = settings_.brokerage_pct > 0 ? std::min(brokerage, settings_.brokerage_per_order)
+                                                : settings_.brokerage_per_order;
+    }
+    double stt = value * (side == Signal::BUY ? settings_.stt_buy_pct : settings_.stt_sell_pct) / 100.0;
+    return brokerage + stt;
+}
+
+double MatchingEngine::slipped(Signal side, double price) const {
+    double slip = price * settings_.slippage_bps / 10000.0;
+    return side == Signal::BUY ? price + slip : price - slip;
+}
+
+bool MatchingEngine::fill(Book& book, OrderNode* node, double price, int64_t& capacity, std::vector<Fill>& fills) {
+    if (capacity <= 0) return false;
+    int quantity = static_cast<int>(std::min<int64_t>(node->quantity, capacity));
+    capacity -= quantity;
+    node->quantity -= quantity;
+    node->filled += quantity;
+    Fill fill;
+    fill.order = node->id;
+    fill.symbol = node->symbol;
+    fill.side = node->side;
+    fill.quantity = quantity;
+    fill.price = price;
+    fill.fees = fees(node->side, quantity, price);
+    fill.done = node->quantity == 0;
+    fills.push_back(fill);
+    if (fill.done) {
+        listFor(book, node).remove(node);
+        release(book, node);
+    }
+    return true;
+}
+
+void MatchingEngine::trigger(Book& book, OrderNode* node, double price, int64_t& capacity, std::vector<Fill>& fills) {
+    listFor(book, node).remove(node);
+    book.count--;  // enqueue() counts it again
+    if (node->type == OrderType::STOP) {
+        // Becomes a market order; whatever the volume cap leaves fills at the next open
+        node->type = OrderType::MARKET;
+        enqueue(book, node);
+        fill(book, node, slipped(node->side, price), capacity, fills);
+        return;
+    }
+    node->type = OrderType::LIMIT;
+    enqueue(book, node);
+    bool marketable = node->side == Signal::BUY ? price <= node->limit_price : price >= node->limit_price;
+    if (marketable) fill(book, node, price, capacity, fills);
+}
+
+// Price rising from `from` to `to`: sell limits and buy stops at or below
+// `to`, lowest level first
+void MatchingEngine::walkUp(Book& book, double from, double to, int64_t& capacity, std::vector<Fill>& fills) {
+    bool limits_open = true;
+    for (;;) {
+        OrderNode* limit = limits_open ? book.sell_limits.front() : nullptr;
+        if (limit && limit->limit_price > to) limit = nullptr;
+        OrderNode* stop = book.buy_stops.front();
+        if (stop && stop->stop_price > to) stop = nullptr;
+        if (!limit && !stop) break;
+        if (limit && (!stop || limit->limit_price <= stop->stop_price)) {
+            if (!fill(book, limit, std::max(limit->limit_price, from), capacity, fills)) limits_open = false;
+        } else {
+            trigger(book, stop, std::max(stop->stop_price, from), capacity, fills);
+        }
+    }
+}
+
+// Price falling from `from` to `to`: buy limits and sell stops at or above
+// `to`, highest level first
+void MatchingEngine::walkDown(Book& book, double from, double to, int64_t& capacity, std::vector<Fill>& fills) {
+    bool limits_open = true;
+    for (;;) {
+        OrderNode* limit = limits_open ? book.buy_limits.front() : nullptr;
+        if (limit && limit->limit_price < to) limit = nullptr;
+        OrderNode* stop = book.sell_stops.front();
+        if (stop && stop->stop_price < to) stop = nullptr;
+        if (!limit && !stop) break;
+        if (limit && (!stop || limit->limit_price >= stop->stop_price)) {
+            if (!fill(book, limit, std::min(limit->limit_price, from), capacity, fills)) limits_open = false;
+        } else {
+            trigger(book, stop, std::min(stop->stop_price, from), capacity, fills);
+        }
+    }
+}
+
+size_t MatchingEngine::match(SymbolId symbol, const BarRange& bar, std::vector<Fill>& fills) {
+    if (!hasOrders(symbol)) return 0;
+    Book& book = books_[symbol];
+    size_t before = fills.size();
+    int64_t capacity = std::numeric_limits<int64_t>::max();
+    if (settings_.volume_participation > 0) {
+        // No volume, nothing to take part in: a zero-volume bar fills nothing
+        capacity = static_cast<int64_t>(static_cast<double>(std::max<int64_t>(bar.volume, 0)) *
+                                        settings_.volume_participation);
+    }
+
+    while (OrderNode* node = book.market.front()) {
+        if (!fill(book, node, slipped(node->side, bar.open), capacity, fills)) break;
+    }
+    // Levels the open has already gapped through
+    walkUp(book, bar.open, bar.open, capacity, fills);
+    walkDown(book, bar.open, bar.open, capacity, fills);
+
+    bool high_first = settings_.path == IntrabarPath::OHLC ||
+                      (settings_.path == IntrabarPath::NEAREST_FIRST && bar.high - bar.open < bar.open - bar.low);
+    double path[4] = {bar.open, high_first ? bar.high : bar.low, high_first ? bar.low : bar.high, bar.close};
+    for (int leg = 0; leg < 3; ++leg) {
+        if (path[leg + 1] > path[leg]) walkUp(book, path[leg], path[leg + 1], capacity, fills);
+        else if (path[leg + 1] < path[leg]) walkDown(book, path[leg], path[leg + 1], capacity, fills);
+    }
+    return fills.size() - before;
+}
+}
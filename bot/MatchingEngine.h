@@ -0,0 +1,105 @@
+#ifndef MATCHING_ENGINE_H
+#define MATCHING_ENGINE_H
+
+#include <cstdint>
+#include <vector>
+#include "Types.h"
+#include "SymbolTable.h"
+#include "OrderBook.h"
+
+namespace TradingBot {
+
+struct OrderRequest {
+    SymbolId symbol;
+    Signal side;            // BUY or SELL
+    OrderType type;
+    int quantity;
+    double limit_price;     // LIMIT, STOP_LIMIT
+    double stop_price;      // STOP, STOP_LIMIT
+
+    OrderRequest() : symbol(0), side(Signal::BUY), type(OrderType::MARKET), quantity(0), limit_price(0), stop_price(0) {}
+    static OrderRequest market(SymbolId symbol, Signal side, int quantity);
+    static OrderRequest limit(SymbolId symbol, Signal side, int quantity, double limit_price);
+    static OrderRequest stop(SymbolId symbol, Signal side, int quantity, double stop_price);
+    static OrderRequest stopLimit(SymbolId symbol, Signal side, int quantity, double stop_price, double limit_price);
+};
+
+// The part of a bar the matching engine needs
+struct BarRange {
+    double open;
+    double high;
+    double low;
+    double close;
+    int64_t volume;
+};
+
+struct Fill {
+    OrderId order;
+    SymbolId symbol;
+    Signal side;
+    int quantity;
+    double price;           // slippage included
+    double fees;            // brokerage + STT for this fill
+    bool done;              // the order has no quantity left
+};
+
+// Per-symbol order books filled against bars.
+//
+// Orders wait in price-time priority: buy limits highest first, sell limits
+// lowest first, stops nearest-to-trigger first, ties by arrival. match()
+// plays one bar through them: market orders fill at the open, then the
+// price is walked along the configured intrabar path (open, first extreme,
+// second extreme, close) and every limit or stop level the walk crosses
+// executes in the order it is reached. A level already beyond the open fills
+// at the open (gap). Stops fill like market orders once triggered;
+// stop-limits turn into limits at the trigger. With a volume participation
+// cap, orders fill partially and keep their queue position for the next bar;
+// a bar with no volume fills nothing.
+//
+// Nodes come from an OrderPool and live in intrusive lists, so in steady
+// state submit/cancel/match do not allocate (the fills vector is the
+// caller's and can be reused).
+class MatchingEngine {
+public:
+    explicit MatchingEngine(const ExecutionSettings& settings = ExecutionSettings());
+    OrderId submit(const OrderRequest& request);  // kInvalidOrder for a malformed request
+    bool cancel(OrderId id);                      // false if already filled or cancelled
+    void cancelAll(SymbolId symbol);
+    // Plays one bar of `symbol`; appends fills in execution order, returns how many
+    size_t match(SymbolId symbol, const BarRange& bar, std::vector<Fill>& fills);
+    bool hasOrders(SymbolId symbol) const { return symbol < books_.size() && books_[symbol].count > 0; }
+    const OrderNode* order(OrderId id) const { return pool_.find(id); }
+    size_t openOrders() const { return pool_.live(); }
+    size_t poolCapacity() const { return pool_.capacity(); }
+    // Books for symbols below `symbols` and room for `orders` live orders up
+    // front, so the first submits do not allocate
+    void reserve(size_t symbols, size_t orders);
+    double fees(Signal side, int quantity, double price) const;
+    const ExecutionSettings& settings() const { return settings_; }
+private:
+    struct Book {
+        OrderList market;       // FIFO, filled at the next open
+        OrderList buy_limits;
+        OrderList sell_limits;
+        OrderList buy_stops;
+        OrderList sell_stops;
+        size_t count;
+        Book() : count(0) {}
+    };
+    ExecutionSettings settings_;
+    OrderPool pool_;
+    std::vector<Book> books_;
+    uint64_t next_sequence_;
+
+    OrderList& listFor(Book& book, const OrderNode* node);
+    void enqueue(Book& book, OrderNode* node);
+    void release(Book& book, OrderNode* node);
+    double slipped(Signal side, double price) const;
+    bool fill(Book& book, OrderNode* node, double price, int64_t& capacity, std::vector<Fill>& fills);
+    void trigger(Book& book, OrderNode* node, double price, int64_t& capacity, std::vector<Fill>& fills);
+    void walkUp(Book& book, double from, double to, int64_t& capacity, std::vector<Fill>& fills);
+    void walkDown(Book& book, double from, double to, int64_t& capacity, std::vector<Fill>& fills);
+};
+}
+
+#endif
@@ -0,0 +1,335 @@
+#include "MonteCarlo.h"
+#include "MarketGenerator.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+
+namespace TradingBot {
+
+MonteCarloSpec MonteCarloSpec::fromConfig(const Config& config) {
+    MonteCarloSpec spec;
+    spec.runs = static_cast<size_t>(std::max(config.getMonteCarloRuns(), 0));
+    spec.seed = config.getMonteCarloSeed();
+    spec.block_bars = static_cast<size_t>(std::max(config.getMonteCarloBlockBars(), 1));
+    spec.slippage_bps = std::max(config.getMonteCarloSlippageBps(), 0.0);
+    return spec;
+}
+
+Distribution Distribution::of(std::vector<double> values) {
+    Distribution d;
+    if (values.empty()) return d;
+    std::sort(values.begin(), values.end());
+    double sum = 0;
+    for (double v : values) sum += v;
+    d.mean = sum / values.size();
+    // Linear interpolation between the closest ranks
+    auto percentile = [&values](double p) {
+        double rank = p * (values.size() - 1);
+        size_t below = static_cast<size_t>(rank);
+        size_t above = std::min(below + 1, values.size() - 1);
+        return values[below] + (rank - below) * (values[above] - values[below]);
+    };
+    d.p5 = percentile(0.05);
+    d.p25 = percentile(0.25);
+    d.p50 = percentile(0.50);
+    d.p75 = percentile(0.75);
+    d.p95 = percentile(0.95);
+    return d;
+}
+
+size_t MonteCarloResult::scenarios() const {
+    size_t total = 0;
+    for (const std::vector<ScenarioOutcome>& kind : outcomes) total += kind.size();
+    return total;
+}
+
+struct MonteCarlo::Workspace {
+    BarSeries series;
+    SignalKernel kernel;
+    RunArena arena;
+    uint64_t allocations;
+    uint64_t loop_allocations;
+    size_t bars;
+
+    Workspace() : kernel(Span<const double>()), arena(64 * 1024), allocations(0), loop_allocations(0), bars(0) {}
+};
+
+MonteCarlo::MonteCarlo(const BarSeries& series, const BacktestParams& params, const MonteCarloSpec& spec)
+    : series_(series), params_(params), spec_(spec) {
+    Span<const double> open = series.open(), high = series.high(), low = series.low(), close = series.close();
+    size_t n = series.size();
+    for (std::vector<double>* ratios : {&open_ratio_, &high_ratio_, &low_ratio_, &close_ratio_}) {
+        ratios->reserve(n > 0 ? n - 1 : 0);
+    }
+    for (size_t i = 1; i < n; ++i) {
+        double previous = close[i - 1] > 0 ? close[i - 1] : close[i];  // a bad print repeats the bar
+        open_ratio_.push_back(previous > 0 ? open[i] / previous : 1);
+        high_ratio_.push_back(previous > 0 ? high[i] / previous : 1);
+        low_ratio_.push_back(previous > 0 ? low[i] / previous : 1);
+        close_ratio_.push_back(previous > 0 ? close[i] / previous : 1);
+    }
+}
+
+const char* MonteCarlo::kindName(ScenarioKind kind) {
+    switch (kind) {
+        case ScenarioKind::TRADE_BOOTSTRAP: return "trade_bootstrap";
+        case ScenarioKind::BLOCK_BOOTSTRAP: return "block_bootstrap";
+        case ScenarioKind::SLIPPAGE: return "slippage";
+    }
+    return "unknown";
+}
+
+void MonteCarlo::collectRoundTrips(const std::vector<Trade>& fills) {
+    // FIFO lots, as PerformanceTracker matches them; one trip per closing fill
+    struct Lot {
+        int quantity;
+        double price;       // per share, buy fees included
+        double fill_price;
+    };
+    std::vector<Lot> lots;
+    size_t head = 0;
+    double equity_before = params_.initial_balance;
+    trips_.clear();
+    for (const Trade& fill : fills) {
+        if (fill.quantity <= 0) continue;
+        if (fill.signal == Signal::BUY) {
+            if (head == lots.size()) equity_before = fill.balance_after + fill.value + fill.fees;
+            lots.push_back({fill.quantity, (fill.value + fill.fees) / fill.quantity, fill.price});
+            continue;
+        }
+        if (fill.signal != Signal::SELL) continue;
+        int remaining = fill.quantity;
+        int matched = 0;
+        double cost = 0, entry_value = 0;
+        while (remaining > 0 && head < lots.size()) {
+            Lot& lot = lots[head];
+            int take = std::min(remaining, lot.quantity);
+            cost += take * lot.price;
+            entry_value += take * lot.fill_price;
+            matched += take;
+            remaining -= take;
+            lot.quantity -= take;
+            if (lot.quantity == 0) head++;
+        }
+        if (matched == 0) continue;
+        RoundTrip trip;
+        trip.profit = matched * fill.price - cost - fill.fees * matched / fill.quantity;
+        trip.equity_before = equity_before;
+        trip.entry_value = entry_value;
+        trip.exit_value = matched * fill.price;
+        trips_.push_back(trip);
+    }
+}
+
+namespace {
+
+// Trade-by-trade equity: each trip's return compounds on the running equity
+struct TripCurve {
+    double equity;
+    double peak;
+    double max_drawdown_pct;
+    int wins;
+    int trips;
+
+    explicit TripCurve(double initial) : equity(initial), peak(initial), max_drawdown_pct(0), wins(0), trips(0) {}
+    void add(double profit, double equity_before) {
+        double r = equity_before > 0 ? profit / equity_before : 0;
+        equity *= 1 + r;
+        peak = std::max(peak, equity);
+        if (peak > 0) max_drawdown_pct = std::max(max_drawdown_pct, (peak - equity) / peak * 100);
+        if (profit > 0) wins++;
+        trips++;
+    }
+    ScenarioOutcome outcome(double initial) const {
+        ScenarioOutcome o;
+        o.profit_loss = equity - initial;
+        o.max_drawdown_pct = max_drawdown_pct;
+        o.win_rate = trips > 0 ? 100.0 * wins / trips : 0;
+        o.round_trips = trips;
+        return o;
+    }
+};
+
+uint64_t streamOf(ScenarioKind kind, uint64_t run) {
+    return (static_cast<uint64_t>(kind) + 1) << 40 | run;
+}
+}
+
+ScenarioOutcome MonteCarlo::tradeBootstrap(uint64_t run) const {
+    Philox rng(spec_.seed, streamOf(ScenarioKind::TRADE_BOOTSTRAP, run));
+    TripCurve curve(params_.initial_balance);
+    size_t n = trips_.size();
+    for (size_t i = 0; i < n; ++i) {
+        const RoundTrip& trip = trips_[std::min(static_cast<size_t>(rng.uniform() * n), n - 1)];
+        curve.add(trip.profit, trip.equity_before);
+    }
+    return curve.outcome(params_.initial_balance);
+}
+
+ScenarioOutcome MonteCarlo::slippage(uint64_t run) const {
+    Philox rng(spec_.seed, streamOf(ScenarioKind::SLIPPAGE, run));
+    // |N(0, sigma)| has mean sigma * sqrt(2 / pi)
+    double sigma = spec_.slippage_bps / 10000.0 * std::sqrt(std::acos(-1.0) / 2);
+    TripCurve curve(params_.initial_balance);
+    for (const RoundTrip& trip : trips_) {
+        double extra = trip.entry_value * std::abs(rng.normal()) * sigma +
+                       trip.exit_value * std::abs(rng.normal()) * sigma;
+        curve.add(trip.profit - extra, trip.equity_before);
+    }
+    return curve.outcome(params_.initial_balance);
+}
+
+ScenarioOutcome MonteCarlo::blockBootstrap(uint64_t run, Workspace& workspace) const {
+    Philox rng(spec_.seed, streamOf(ScenarioKind::BLOCK_BOOTSTRAP, run));
+    size_t n = series_.size();
+    size_t m = close_ratio_.size();
+    Span<const int64_t> timestamps = series_.timestamps();
+    Span<const int64_t> volume = series_.volume();
+    BarSeries& bars = workspace.series;
+    bars.clear();
+    bars.reserve(n);
+    if (n > 0) {
+        bars.append(timestamps[0], series_.open()[0], series_.high()[0], series_.low()[0], series_.close()[0],
+                    volume[0]);
+    }
+    // Blocks start anywhere and wrap around the end (circular block bootstrap)
+    double previous = n > 0 ? series_.close()[0] : 0;
+    for (size_t k = 1; k < n && m > 0;) {
+        size_t at = std::min(static_cast<size_t>(rng.uniform() * m), m - 1);
+        for (size_t j = 0; j < spec_.block_bars && k < n; ++j, ++k) {
+            size_t r = (at + j) % m;
+            double close = previous * close_ratio_[r];
+            bars.append(timestamps[k], previous * open_ratio_[r], previous * high_ratio_[r],
+                        previous * low_ratio_[r], close, volume[r + 1]);
+            previous = close;
+        }
+    }
+    workspace.kernel.rebuild(bars.close());
+    workspace.arena.reset();
+    Backtester backtester(bars, params_, &workspace.kernel);
+    backtester.setArena(&workspace.arena);
+    BacktestResult result = backtester.run();
+    workspace.allocations += result.allocations;
+    workspace.loop_allocations += result.loop_allocations;
+    workspace.bars += result.bars;
+
+    ScenarioOutcome o;
+    o.profit_loss = result.stats.total_profit_loss;
+    o.max_drawdown_pct = result.stats.max_drawdown_pct;
+    o.win_rate = result.stats.win_rate;
+    o.round_trips = result.stats.winning_trades + result.stats.losing_trades;
+    return o;
+}
+
+MonteCarloResult MonteCarlo::run(size_t threads) {
+    auto start = std::chrono::steady_clock::now();
+    MonteCarloResult result;
+    {
+        SignalKernel kernel(series_.close());
+        std::vector<Trade> fills;
+        Backtester backtester(series_, params_, &kernel);
+        backtester.setFills(&fills);
+        result.base = backtester.run();
+        collectRoundTrips(fills);
+    }
+    result.round_trips = trips_.size();
+    TripCurve closed(params_.initial_balance);
+    for (const RoundTrip& trip : trips_) closed.add(trip.profit, trip.equity_before);
+    result.closed_trade_drawdown_pct = closed.max_drawdown_pct;
+    for (std::vector<ScenarioOutcome>& kind : result.outcomes) kind.resize(spec_.runs);
+
+    ThreadPool pool(threads);
+    std::unique_ptr<Workspace[]> workspaces(new Workspace[pool.size() + 1]);
+    parallelFor(pool, kScenarioKindCount * spec_.runs, [&](size_t i) {
+        ScenarioKind kind = static_cast<ScenarioKind>(i / spec_.runs);
+        uint64_t run = i % spec_.runs;
+        ScenarioOutcome& out = result.outcomes[static_cast<size_t>(kind)][run];
+        if (kind == ScenarioKind::TRADE_BOOTSTRAP) {
+            out = tradeBootstrap(run);
+        } else if (kind == ScenarioKind::SLIPPAGE) {
+            out = slippage(run);
+        } else {
+            out = blockBootstrap(run, workspaces[pool.workerIndex()]);
+        }
+    });
+    for (size_t w = 0; w < pool.size() + 1; ++w) {
+        result.allocations += workspaces[w].allocations;
+        result.loop_allocations += workspaces[w].loop_allocations;
+        result.bars += workspaces[w].bars;
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+void MonteCarlo::printReport(const MonteCarloResult& result) {
+    const char* titles[kScenarioKindCount] = {"Trade bootstrap", "Block bootstrap", "Random slippage"};
+    const Statistics& base = result.base.stats;
+    std::cout << "\n" << std::string(92, '=') << "\n";
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Backtest: P/L INR " << base.total_profit_loss << ", max drawdown " << base.max_drawdown_pct
+              << "% (closed-trade " << result.closed_trade_drawdown_pct << "%), win rate " << base.win_rate
+              << "% over " << result.round_trips << " round trips\n";
+    for (size_t k = 0; k < kScenarioKindCount; ++k) {
+        const std::vector<ScenarioOutcome>& outcomes = result.outcomes[k];
+        if (outcomes.empty()) continue;
+        std::vector<double> pnl, drawdown, win_rate;
+        pnl.reserve(outcomes.size());
+        drawdown.reserve(outcomes.size());
+        win_rate.reserve(outcomes.size());
+        size_t losses = 0;
+        for (const ScenarioOutcome& o : outcomes) {
+            pnl.push_back(o.profit_loss);
+            drawdown.push_back(o.max_drawdown_pct);
+            win_rate.push_back(o.win_rate);
+            if (o.profit_loss < 0) losses++;
+        }
+        std::cout << std::string(92, '-') << "\n";
+        std::cout << titles[k] << " (" << outcomes.size() << " runs, " << std::setprecision(1)
+                  << 100.0 * losses / outcomes.size() << "% lose money)\n";
+        const char* columns[] = {"Mean", "5%", "25%", "50%", "75%", "95%"};
+        std::cout << std::string(25, ' ');
+        for (const char* column : columns) std::cout << std::setw(12) << column;
+        std::cout << "\n";
+        // Round-trip scenarios never see the bars inside a trade, so their drawdown says so
+        const char* drawdown_label = closedTradeDrawdown(static_cast<ScenarioKind>(k)) ? "  Closed-trade drawdown %"
+                                                                                         : "  Max drawdown %         ";
+        const char* labels[] = {"  P/L (INR)              ", drawdown_label, "  Win rate %             "};
+        Distribution rows[] = {Distribution::of(pnl), Distribution::of(drawdown), Distribution::of(win_rate)};
+        std::cout << std::setprecision(2);
+        for (size_t r = 0; r < 3; ++r) {
+            const Distribution& d = rows[r];
+            std::cout << labels[r] << std::setw(12) << d.mean << std::setw(12) << d.p5 << std::setw(12) << d.p25
+                      << std::setw(12) << d.p50 << std::setw(12) << d.p75 << std::setw(12) << d.p95 << "\n";
+        }
+    }
+    std::cout << std::string(92, '=') << "\n";
+}
+
+bool MonteCarlo::writeCSV(const std::string& filename, const MonteCarloResult& result) {
+    std::ofstream out(filename);
+    if (!out.is_open()) {
+        std::cerr << "Warning: Could not create Monte Carlo results file " << filename << std::endl;
+        return false;
+    }
+    // A scenario fills one of the two drawdown columns (closedTradeDrawdown)
+    out << "Scenario,Run,ProfitLoss,MaxDrawdownPct,ClosedTradeDrawdownPct,WinRate,RoundTrips\n";
+    out << std::fixed << std::setprecision(2);
+    for (size_t k = 0; k < kScenarioKindCount; ++k) {
+        const char* name = kindName(static_cast<ScenarioKind>(k));
+        bool closed = closedTradeDrawdown(static_cast<ScenarioKind>(k));
+        for (size_t i = 0; i < result.outcomes[k].size(); ++i) {
+            const ScenarioOutcome& o = result.outcomes[k][i];
+            out << name << "," << (i + 1) << "," << o.profit_loss << ",";
+            if (closed) out << "," << o.max_drawdown_pct << ",";
+            else out << o.max_drawdown_pct << ",,";
+            out << o.win_rate << "," << o.round_trips << "\n";
+        }
+    }
+    return true;
+}
+}
@@ -0,0 +1,114 @@
+#ifndef MONTE_CARLO_H
+#define MONTE_CARLO_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Types.h"
+#include "BarSeries.h"
+#include "Backtester.h"
+#include "Config.h"
+
+namespace TradingBot {
+
+enum class ScenarioKind {
+    TRADE_BOOTSTRAP,    // the backtest's round trips drawn with replacement
+    BLOCK_BOOTSTRAP,    // the strategy re-run on bars rebuilt from blocks of historical returns
+    SLIPPAGE,           // the backtest's round trips in order, each fill with random extra slippage
+};
+const size_t kScenarioKindCount = 3;
+
+struct MonteCarloSpec {
+    size_t runs;                // scenarios of each kind
+    uint64_t seed;              // same seed, same scenarios, whatever the thread count
+    size_t block_bars;          // length of the blocks of returns
+    double slippage_bps;        // mean extra slippage per fill (half-normal)
+
+    MonteCarloSpec() : runs(1000), seed(42), block_bars(20), slippage_bps(5) {}
+    static MonteCarloSpec fromConfig(const Config& config);
+};
+
+struct ScenarioOutcome {
+    double profit_loss;
+    // Block bootstrap: over every bar, marked to market like the backtest's.
+    // Trade bootstrap and slippage: over closed-trade equity only (closedTradeDrawdown)
+    double max_drawdown_pct;
+    double win_rate;            // % of round trips closed at a profit
+    int round_trips;
+};
+
+// Mean and percentiles of one metric over the scenarios of a kind
+struct Distribution {
+    double mean;
+    double p5, p25, p50, p75, p95;
+
+    Distribution() : mean(0), p5(0), p25(0), p50(0), p75(0), p95(0) {}
+    static Distribution of(std::vector<double> values);
+};
+
+struct MonteCarloResult {
+    BacktestResult base;                    // the backtest on the real bars
+    size_t round_trips;                     // of the base backtest
+    double closed_trade_drawdown_pct;       // of the base backtest's round trips, in order
+    std::vector<ScenarioOutcome> outcomes[kScenarioKindCount];  // by ScenarioKind, in run order
+    // Block-bootstrap backtests (the only scenarios that run the bar loop)
+    uint64_t allocations;
+    uint64_t loop_allocations;
+    size_t bars;
+    double seconds;
+
+    MonteCarloResult()
+        : round_trips(0), closed_trade_drawdown_pct(0), allocations(0), loop_allocations(0), bars(0), seconds(0) {}
+    size_t scenarios() const;
+};
+
+// Robustness of one parameter set: distributions of P/L, max drawdown and
+// win rate over resampled histories instead of the single backtest.
+//
+// The real bars are backtested once. Trade-bootstrap and slippage
+// scenarios only re-walk its round trips (compounding each one's return
+// on the equity before it), so they read a few hundred doubles and
+// allocate nothing. Block-bootstrap scenarios rebuild a whole series from
+// randomly placed blocks of the historical bar-to-bar ratios (OHLC
+// relative to the previous close, so the gaps and ranges come along) and
+// run the full Backtester on it; each worker keeps one series, one
+// SignalKernel and one RunArena and overwrites them in place, so after its
+// first scenario a worker allocates only the per-run setup, never per bar.
+//
+// Scenario i of a kind draws from Philox stream (kind, i), so results do
+// not depend on the thread count or on which worker ran what.
+class MonteCarlo {
+public:
+    MonteCarlo(const BarSeries& series, const BacktestParams& params, const MonteCarloSpec& spec);
+    MonteCarloResult run(size_t threads = 0);
+
+    static const char* kindName(ScenarioKind kind);
+    // The kind's drawdown only sees equity between round trips, not the bars inside them
+    static bool closedTradeDrawdown(ScenarioKind kind) { return kind != ScenarioKind::BLOCK_BOOTSTRAP; }
+    static void printReport(const MonteCarloResult& result);
+    static bool writeCSV(const std::string& filename, const MonteCarloResult& result);  // one row per scenario
+private:
+    struct RoundTrip {
+        double profit;          // net of the fees of both sides
+        double equity_before;   // balance before the trip was opened
+        double entry_value;     // shares x price, for the slippage scenarios
+        double exit_value;
+    };
+    // Scratch for block-bootstrap runs; one per worker
+    struct Workspace;
+
+    const BarSeries& series_;
+    BacktestParams params_;
+    MonteCarloSpec spec_;
+    std::vector<RoundTrip> trips_;
+    // Bar i + 1 relative to the close of bar i
+    std::vector<double> open_ratio_, high_ratio_, low_ratio_, close_ratio_;
+
+    void collectRoundTrips(const std::vector<Trade>& fills);
+    ScenarioOutcome tradeBootstrap(uint64_t run) const;
+    ScenarioOutcome slippage(uint64_t run) const;
+    ScenarioOutcome blockBootstrap(uint64_t run, Workspace& workspace) const;
+};
+}
+
+#endif
@@ -0,0 +1,130 @@
+#ifndef ORDER_BOOK_H
+#define ORDER_BOOK_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Types.h"
+#include "SymbolTable.h"
+
+namespace TradingBot {
+
+enum class OrderType {
+    MARKET,
+    LIMIT,
+    STOP,
+    STOP_LIMIT
+};
+
+// Handle returned by MatchingEngine::submit: pool slot in the low 32 bits,
+// the slot's reuse generation in the high bits, so a stale id never
+// reaches a recycled order. 0 is never a valid id.
+typedef uint64_t OrderId;
+const OrderId kInvalidOrder = 0;
+
+// A resting order. Nodes link themselves into exactly one OrderList (or the
+// pool's free list), so queueing and dequeuing never allocate.
+struct OrderNode {
+    OrderNode* prev;
+    OrderNode* next;
+    OrderId id;
+    uint64_t sequence;      // arrival order, the time part of price-time priority
+    SymbolId symbol;
+    Signal side;            // BUY or SELL
+    OrderType type;
+    int quantity;           // still open
+    int filled;
+    double limit_price;
+    double stop_price;
+    uint32_t slot;
+    uint32_t generation;
+};
+
+// Intrusive doubly-linked list of orders kept in priority order
+class OrderList {
+public:
+    OrderList() : head_(nullptr), tail_(nullptr) {}
+    OrderNode* front() const { return head_; }
+    bool empty() const { return head_ == nullptr; }
+    void pushBack(OrderNode* node) {
+        node->next = nullptr;
+        node->prev = tail_;
+        if (tail_) tail_->next = node; else head_ = node;
+        tail_ = node;
+    }
+    // Inserts behind every order that `ahead(existing, node)` ranks first.
+    // New orders usually land at or near the back, so the scan starts there.
+    template <typename Ahead>
+    void insert(OrderNode* node, Ahead ahead) {
+        OrderNode* after = tail_;
+        while (after && !ahead(after, node)) after = after->prev;
+        node->prev = after;
+        node->next = after ? after->next : head_;
+        if (node->next) node->next->prev = node; else tail_ = node;
+        if (after) after->next = node; else head_ = node;
+    }
+    void remove(OrderNode* node) {
+        if (node->prev) node->prev->next = node->next; else head_ = node->next;
+        if (node->next) node->next->prev = node->prev; else tail_ = node->prev;
+        node->prev = node->next = nullptr;
+    }
+private:
+    OrderNode* head_;
+    OrderNode* tail_;
+};
+
+// Fixed-size order nodes carved from chunks that are never freed; released
+// nodes go to a free list and are reused first. After warm-up the pool
+// stops allocating altogether.
+class OrderPool {
+public:
+    explicit OrderPool(size_t chunk_size = 4096) : chunk_size_(chunk_size ? chunk_size : 1), free_(nullptr), live_(0) {}
+    OrderNode* acquire() {
+        if (!free_) grow();
+        OrderNode* node = free_;
+        free_ = node->next;
+        node->prev = node->next = nullptr;
+        if (++node->generation == 0) node->generation = 1;  // keeps ids non-zero
+        live_++;
+        return node;
+    }
+    void release(OrderNode* node) {
+        node->id = kInvalidOrder;
+        node->next = free_;
+        free_ = node;
+        live_--;
+    }
+    // The live node an id refers to, or nullptr if it was filled/cancelled
+    OrderNode* find(OrderId id) const {
+        uint32_t slot = static_cast<uint32_t>(id & 0xFFFFFFFFu);
+        if (id == kInvalidOrder || slot >= chunks_.size() * chunk_size_) return nullptr;
+        OrderNode* node = &chunks_[slot / chunk_size_][slot % chunk_size_];
+        return node->id == id ? node : nullptr;
+    }
+    size_t live() const { return live_; }
+    size_t capacity() const { return chunks_.size() * chunk_size_; }
+    void reserve(size_t nodes) {
+        while (capacity() < nodes) grow();
+    }
+private:
+    size_t chunk_size_;
+    std::vector<std::unique_ptr<OrderNode[]>> chunks_;
+    OrderNode* free_;
+    size_t live_;
+    void grow() {
+        std::unique_ptr<OrderNode[]> chunk(new OrderNode[chunk_size_]());
+        uint32_t base = static_cast<uint32_t>(chunks_.size() * chunk_size_);
+        // Thread the new nodes onto the free list in slot order
+        for (size_t i = chunk_size_; i-- > 0;) {
+            chunk[i].slot = base + static_cast<uint32_t>(i);
+            chunk[i].generation = 0;
+            chunk[i].id = kInvalidOrder;
+            chunk[i].next = free_;
+            free_ = &chunk[i];
+        }
+        chunks_.push_back(std::move(chunk));
+    }
+};
+}
+
+#endif
@@ -0,0 +1,50 @@
+#include "PaceTimer.h"
+#include "SpscQueue.h"
+#include <algorithm>
+#include <thread>
+
+namespace TradingBot {
+
+namespace {
+
+const PaceTimer::Clock::duration kMinMargin = std::chrono::microseconds(20);
+const PaceTimer::Clock::duration kMaxMargin = std::chrono::milliseconds(2);
+const PaceTimer::Clock::duration kMaxNap = std::chrono::milliseconds(100);
+
+uint64_t nanoseconds(PaceTimer::Clock::duration d) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+}
+}
+
+PaceTimer::PaceTimer() : start_(Clock::now()), margin_(std::chrono::microseconds(200)), behind_(0) {}
+
+void PaceTimer::start() {
+    start_ = Clock::now();
+}
+
+bool PaceTimer::waitUntil(Clock::duration offset, const std::atomic<bool>* stop) {
+    Clock::time_point deadline = start_ + offset;
+    Clock::time_point now = Clock::now();
+    if (now >= deadline) {
+        behind_++;
+        lateness_.record(nanoseconds(now - deadline));
+        return true;
+    }
+    // Sleep in naps of at most kMaxNap so a stop request is not held up
+    while (deadline - now > margin_) {
+        if (stop && stop->load(std::memory_order_relaxed)) return false;
+        Clock::time_point wake = std::min(deadline - margin_, now + kMaxNap);
+        std::this_thread::sleep_until(wake);
+        now = Clock::now();
+        // Keep the margin at about twice the recent overshoot (1/8 weight per sleep)
+        Clock::duration target = std::max(kMinMargin, std::min(kMaxMargin, 2 * (now - wake)));
+        margin_ += (target - margin_) / 8;
+    }
+    while (now < deadline) {
+        TRADINGBOT_CPU_RELAX();
+        now = Clock::now();
+    }
+    lateness_.record(nanoseconds(now - deadline));
+    return true;
+}
+}
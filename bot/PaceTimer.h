@@ -0,0 +1,37 @@
+#ifndef PACE_TIMER_H
+#define PACE_TIMER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "LatencyHistogram.h"
+
+namespace TradingBot {
+
+// Wakes the calling thread at offsets from start(). Each wait sleeps until a
+// margin before its deadline and spins the rest of the way, which lands
+// within a microsecond or two where a plain sleep overshoots by the
+// scheduler's tens of microseconds. The margin follows the sleep overshoot
+// actually seen. Deadlines count from start(), not from the last wake-up,
+// so a late bar is caught up on instead of shifting every later one.
+class PaceTimer {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    PaceTimer();
+    void start();
+    // Waits until `offset` after start(); returns at once when that has
+    // passed. False when `stop` was set first (checked every 100 ms)
+    bool waitUntil(Clock::duration offset, const std::atomic<bool>* stop = nullptr);
+    // Wake-up minus deadline per wait, in ns
+    const LatencyHistogram& lateness() const { return lateness_; }
+    uint64_t behind() const { return behind_; }   // waits whose deadline had already passed
+private:
+    Clock::time_point start_;
+    Clock::duration margin_;
+    LatencyHistogram lateness_;
+    uint64_t behind_;
+};
+}
+
+#endif
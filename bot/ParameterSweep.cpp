@@ -0,0 +1,122 @@
+#include "ParameterSweep.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+
+namespace TradingBot {
+
+SweepSpec SweepSpec::fromConfig(const Config& config) {
+    SweepSpec spec;
+    spec.short_ma = config.getSweepShortMA();
+    spec.long_ma = config.getSweepLongMA();
+    spec.rsi_period = config.getSweepRSIPeriod();
+    spec.rsi_upper = config.getSweepRSIUpper();
+    spec.rsi_lower = config.getSweepRSILower();
+    spec.risk_percentage = config.getSweepRiskPercentage();
+    return spec;
+}
+
+ParameterSweep::ParameterSweep(const BarSeries& series, const BacktestParams& base, const SweepSpec& spec)
+    : series_(series), base_(base), spec_(spec), last_run_seconds_(0) {}
+
+std::vector<BacktestParams> ParameterSweep::grid(const BacktestParams& base, const SweepSpec& spec) {
+    std::vector<BacktestParams> combos;
+    for (double short_ma : spec.short_ma.values()) {
+        for (double long_ma : spec.long_ma.values()) {
+            if (std::lround(short_ma) >= std::lround(long_ma) || short_ma < 1) continue;
+            for (double rsi_period : spec.rsi_period.values()) {
+                for (double rsi_upper : spec.rsi_upper.values()) {
+                    for (double rsi_lower : spec.rsi_lower.values()) {
+                        for (double risk : spec.risk_percentage.values()) {
+                            BacktestParams params = base;
+                            params.short_ma_period = static_cast<int>(std::lround(short_ma));
+                            params.long_ma_period = static_cast<int>(std::lround(long_ma));
+                            params.rsi_period = static_cast<int>(std::lround(rsi_period));
+                            params.rsi_upper = rsi_upper;
+                            params.rsi_lower = rsi_lower;
+                            params.risk_percentage = risk;
+                            combos.push_back(params);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return combos;
+}
+
+std::vector<BacktestResult> ParameterSweep::run(size_t threads) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<BacktestParams> combos = combinations();
+    std::vector<BacktestResult> results(combos.size());
+    // Prefix sums are built once and shared by every combination
+    SignalKernel kernel(series_.close());
+    {
+        // Each task builds its own Strategy/RiskManager/BrokerSimulator inside
+        // Backtester::run; the only shared state is the read-only series and kernel.
+        // Scratch buffers come from one arena per worker, rewound between runs.
+        ThreadPool pool(threads);
+        std::unique_ptr<RunArena[]> arenas(new RunArena[pool.size() + 1]);
+        parallelFor(pool, combos.size(), [&](size_t i) {
+            RunArena& arena = arenas[pool.workerIndex()];
+            arena.reset();
+            Backtester backtester(series_, combos[i], &kernel);
+            backtester.setArena(&arena);
+            results[i] = backtester.run();
+        });
+    }
+    std::stable_sort(results.begin(), results.end(), [](const BacktestResult& a, const BacktestResult& b) {
+        return a.stats.total_profit_loss > b.stats.total_profit_loss;
+    });
+    last_run_seconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return results;
+}
+
+void ParameterSweep::printTable(const std::vector<BacktestResult>& results, size_t top) {
+    std::cout << "\n" << std::string(78, '=') << "\n";
+    std::cout << "  Rank  Short  Long  RSI  Upper  Lower  Risk%  Trades   Win%        P/L (INR)\n";
+    std::cout << std::string(78, '-') << "\n";
+    std::cout << std::fixed;
+    size_t n = std::min(top, results.size());
+    for (size_t i = 0; i < n; ++i) {
+        const BacktestResult& r = results[i];
+        std::cout << std::setw(6) << (i + 1)
+                  << std::setw(7) << r.params.short_ma_period
+                  << std::setw(6) << r.params.long_ma_period
+                  << std::setw(5) << r.params.rsi_period
+                  << std::setprecision(1)
+                  << std::setw(7) << r.params.rsi_upper
+                  << std::setw(7) << r.params.rsi_lower
+                  << std::setw(7) << r.params.risk_percentage
+                  << std::setw(8) << r.stats.total_trades
+                  << std::setw(7) << r.stats.win_rate
+                  << std::setprecision(2)
+                  << std::setw(17) << r.stats.total_profit_loss << "\n";
+    }
+    std::cout << std::string(78, '=') << "\n";
+}
+
+bool ParameterSweep::writeCSV(const std::string& filename, const std::vector<BacktestResult>& results) {
+    std::ofstream out(filename);
+    if (!out.is_open()) {
+        std::cerr << "Warning: Could not create sweep results file " << filename << std::endl;
+        return false;
+    }
+    out << "Rank,ShortMA,LongMA,RSIPeriod,RSIUpper,RSILower,RiskPercentage,Trades,WinRate,ProfitFactor,MaxDrawdownPct,Sharpe,ProfitLoss,FinalBalance\n";
+    out << std::fixed << std::setprecision(2);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BacktestResult& r = results[i];
+        out << (i + 1) << "," << r.params.short_ma_period << "," << r.params.long_ma_period << ","
+            << r.params.rsi_period << "," << r.params.rsi_upper << "," << r.params.rsi_lower << ","
+            << r.params.risk_percentage << "," << r.stats.total_trades << "," << r.stats.win_rate << ","
+            << r.stats.profit_factor << "," << r.stats.max_drawdown_pct << "," << r.stats.sharpe_ratio << ","
+            << r.stats.total_profit_loss << "," << r.final_balance << "\n";
+    }
+    return true;
+}
+}
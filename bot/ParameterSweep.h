@@ -0,0 +1,46 @@
+#ifndef PARAMETER_SWEEP_H
+#define PARAMETER_SWEEP_H
+
+#include <string>
+#include <vector>
+#include "Types.h"
+#include "BarSeries.h"
+#include "Backtester.h"
+#include "Config.h"
+
+namespace TradingBot {
+
+// Ranges for every swept parameter; unswept ones are single values
+struct SweepSpec {
+    ParameterRange short_ma;
+    ParameterRange long_ma;
+    ParameterRange rsi_period;
+    ParameterRange rsi_upper;
+    ParameterRange rsi_lower;
+    ParameterRange risk_percentage;
+    
+    static SweepSpec fromConfig(const Config& config);
+};
+
+// Grid search: one quiet Backtester per combination, all reading the same
+// immutable BarSeries, spread over a work-stealing ThreadPool
+class ParameterSweep {
+public:
+    ParameterSweep(const BarSeries& series, const BacktestParams& base, const SweepSpec& spec);
+    std::vector<BacktestParams> combinations() const { return grid(base_, spec_); }
+    // Every combination of the ranges on top of `base`; short >= long pairs are skipped
+    static std::vector<BacktestParams> grid(const BacktestParams& base, const SweepSpec& spec);
+    std::vector<BacktestResult> run(size_t threads = 0);  // ranked best P/L first
+    double lastRunSeconds() const { return last_run_seconds_; }
+
+    static void printTable(const std::vector<BacktestResult>& results, size_t top);
+    static bool writeCSV(const std::string& filename, const std::vector<BacktestResult>& results);
+private:
+    const BarSeries& series_;
+    BacktestParams base_;
+    SweepSpec spec_;
+    double last_run_seconds_;
+};
+}
+
+#endif
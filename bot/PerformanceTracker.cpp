@@ -0,0 +1,246 @@
+#include "PerformanceTracker.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace TradingBot {
+
+PerformanceTracker::PerformanceTracker() : arena_(16 * 1024), lot_pool_(arena_) {
+    reset();
+}
+
+void PerformanceTracker::reset() {
+    for (auto& entry : open_lots_) entry.second = LotQueue();
+    lot_pool_.reset();
+    arena_.reset();
+    last_symbol_.clear();
+    last_lots_ = nullptr;
+    fills_ = 0;
+    winning_ = 0;
+    losing_ = 0;
+    gross_profit_ = 0;
+    gross_loss_ = 0;
+    largest_win_ = 0;
+    largest_loss_ = 0;
+    periods_per_year_ = 252.0;
+    marks_ = 0;
+    marks_in_market_ = 0;
+    last_equity_ = 0;
+    peak_equity_ = 0;
+    max_drawdown_ = 0;
+    max_drawdown_pct_ = 0;
+    returns_ = 0;
+    return_mean_ = 0;
+    return_m2_ = 0;
+    downside_sq_sum_ = 0;
+}
+
+void PerformanceTracker::onFill(const Trade& trade) {
+    onFill(trade.symbol, trade.signal, trade.quantity, trade.price, trade.fees);
+}
+
+void PerformanceTracker::onFill(const std::string& symbol, Signal signal, int quantity, double price, double fees) {
+    fills_++;
+    if (!last_lots_ || symbol != last_symbol_) {
+        last_lots_ = &open_lots_[symbol];
+        last_symbol_ = symbol;
+    }
+    LotQueue& lots = *last_lots_;
+    if (signal == Signal::BUY) {
+        Lot* lot = lot_pool_.acquire();
+        lot->quantity = quantity;
+        lot->price = quantity > 0 ? price + fees / quantity : price;
+        if (lots.tail) lots.tail->next = lot; else lots.head = lot;
+        lots.tail = lot;
+        return;
+    }
+    // A sell closes the oldest lots first; the whole sell is one round trip
+    int remaining = quantity;
+    int matched = 0;
+    double cost = 0;
+    while (remaining > 0 && lots.head) {
+        Lot* lot = lots.head;
+        int take = std::min(remaining, lot->quantity);
+        cost += take * lot->price;
+        matched += take;
+        remaining -= take;
+        lot->quantity -= take;
+        if (lot->quantity == 0) {
+            lots.head = lot->next;
+            if (!lots.head) lots.tail = nullptr;
+            lot_pool_.release(lot);
+        }
+    }
+    if (matched == 0) return;  // nothing open to close
+    double profit = matched * price - cost - fees * matched / quantity;
+    if (profit > 0) {
+        winning_++;
+        gross_profit_ += profit;
+        largest_win_ = std::max(largest_win_, profit);
+    } else {
+        losing_++;
+        gross_loss_ -= profit;
+        largest_loss_ = std::min(largest_loss_, profit);
+    }
+}
+
+void PerformanceTracker::onMark(double equity, bool in_market) {
+    if (marks_ > 0 && last_equity_ > 0) {
+        double r = equity / last_equity_ - 1.0;
+        returns_++;
+        double delta = r - return_mean_;
+        return_mean_ += delta / returns_;
+        return_m2_ += delta * (r - return_mean_);
+        if (r < 0) downside_sq_sum_ += r * r;
+    }
+    marks_++;
+    if (in_market) marks_in_market_++;
+    last_equity_ = equity;
+    if (marks_ == 1 || equity > peak_equity_) peak_equity_ = equity;
+    double drawdown = peak_equity_ - equity;
+    max_drawdown_ = std::max(max_drawdown_, drawdown);
+    if (peak_equity_ > 0) max_drawdown_pct_ = std::max(max_drawdown_pct_, drawdown / peak_equity_ * 100.0);
+}
+
+void PerformanceTracker::onMarks(const double* equity, const uint8_t* in_market, size_t count) {
+    // Chunks of returns are folded with Chan et al.'s pairwise update, so the
+    // per-bar divisions are independent and pipeline instead of forming the
+    // serial chain onMark has
+    static const size_t kChunk = 256;
+    double returns[kChunk];
+    for (size_t base = 0; base < count; base += kChunk) {
+        size_t n = std::min(kChunk, count - base);
+        const double* e = equity + base;
+        // A bar has a return unless it is the first mark or follows a non-positive equity
+        double lowest = last_equity_;
+        for (size_t i = 0; i + 1 < n; ++i) lowest = std::min(lowest, e[i]);
+        size_t m = 0;
+        if (marks_ > 0 && lowest > 0) {
+            returns[0] = e[0] / last_equity_ - 1.0;
+            for (size_t i = 1; i < n; ++i) returns[i] = e[i] / e[i - 1] - 1.0;
+            m = n;
+        } else {
+            double previous = last_equity_;
+            bool has_previous = marks_ > 0;
+            for (size_t i = 0; i < n; ++i) {
+                if (has_previous && previous > 0) returns[m++] = e[i] / previous - 1.0;
+                previous = e[i];
+                has_previous = true;
+            }
+        }
+        if (m > 0) foldReturns(returns, m);
+
+        // Peak and drawdown; the percentage is only divided out when it can be a new maximum
+        double peak = marks_ > 0 ? peak_equity_ : e[0];
+        double max_drawdown = max_drawdown_;
+        double max_drawdown_pct = max_drawdown_pct_;
+        long long in = 0;
+        for (size_t i = 0; i < n; ++i) {
+            in += in_market[base + i] != 0;
+            peak = std::max(peak, e[i]);
+            double drawdown = peak - e[i];
+            max_drawdown = std::max(max_drawdown, drawdown);
+            if (peak > 0 && drawdown * 100.0 > max_drawdown_pct * peak) {
+                max_drawdown_pct = std::max(max_drawdown_pct, drawdown / peak * 100.0);
+            }
+        }
+        peak_equity_ = peak;
+        max_drawdown_ = max_drawdown;
+        max_drawdown_pct_ = max_drawdown_pct;
+        marks_ += static_cast<long long>(n);
+        marks_in_market_ += in;
+        last_equity_ = e[n - 1];
+    }
+}
+
+void PerformanceTracker::onMarks(double equity, bool in_market, size_t count) {
+    if (count == 0) return;
+    onMark(equity, in_market);
+    long long repeats = static_cast<long long>(count) - 1;
+    if (repeats == 0) return;
+    // The repeats have a return of exactly 0 (when they have one at all) and
+    // leave peak and drawdown where the first mark put them
+    if (equity > 0) {
+        long long total = returns_ + repeats;
+        double delta = -return_mean_;
+        return_mean_ += delta * repeats / total;
+        return_m2_ += delta * delta * (static_cast<double>(returns_) * repeats / total);
+        returns_ = total;
+    }
+    marks_ += repeats;
+    if (in_market) marks_in_market_ += repeats;
+}
+
+// Merges the moments of `count` returns into the running ones
+void PerformanceTracker::foldReturns(const double* returns, size_t count) {
+    // Four partial sums each, so the additions do not wait on one another
+    double sum[4] = {0, 0, 0, 0};
+    size_t j = 0;
+    for (; j + 4 <= count; j += 4) {
+        for (size_t k = 0; k < 4; ++k) sum[k] += returns[j + k];
+    }
+    for (; j < count; ++j) sum[0] += returns[j];
+    double mean = (sum[0] + sum[1] + sum[2] + sum[3]) / count;
+    double m2[4] = {0, 0, 0, 0};
+    double downside[4] = {0, 0, 0, 0};
+    for (j = 0; j + 4 <= count; j += 4) {
+        for (size_t k = 0; k < 4; ++k) {
+            double r = returns[j + k];
+            double d = r - mean;
+            m2[k] += d * d;
+            downside[k] += r < 0 ? r * r : 0.0;
+        }
+    }
+    for (; j < count; ++j) {
+        double r = returns[j];
+        m2[0] += (r - mean) * (r - mean);
+        downside[0] += r < 0 ? r * r : 0.0;
+    }
+    long long total = returns_ + static_cast<long long>(count);
+    double delta = mean - return_mean_;
+    return_mean_ += delta * count / total;
+    return_m2_ += (m2[0] + m2[1] + m2[2] + m2[3]) + delta * delta * (static_cast<double>(returns_) * count / total);
+    downside_sq_sum_ += downside[0] + downside[1] + downside[2] + downside[3];
+    returns_ = total;
+}
+
+Statistics PerformanceTracker::snapshot(double initial_balance, double current_balance) const {
+    Statistics stats;
+    stats.total_trades = fills_;
+    stats.winning_trades = winning_;
+    stats.losing_trades = losing_;
+    stats.total_profit_loss = current_balance - initial_balance;
+    if (roundTrips() > 0) {
+        stats.win_rate = static_cast<double>(winning_) / roundTrips() * 100.0;
+    }
+    stats.largest_win = largest_win_;
+    stats.largest_loss = largest_loss_;
+    stats.gross_profit = gross_profit_;
+    stats.gross_loss = gross_loss_;
+    if (gross_loss_ > 0) {
+        stats.profit_factor = gross_profit_ / gross_loss_;
+    } else if (gross_profit_ > 0) {
+        stats.profit_factor = std::numeric_limits<double>::infinity();
+    }
+    stats.marked_bars = marks_;
+    stats.max_drawdown = max_drawdown_;
+    stats.max_drawdown_pct = max_drawdown_pct_;
+    if (marks_ > 0) {
+        stats.exposure_pct = static_cast<double>(marks_in_market_) / marks_ * 100.0;
+    }
+    if (returns_ > 1) {
+        double stdev = std::sqrt(return_m2_ / (returns_ - 1));
+        double downside = std::sqrt(downside_sq_sum_ / returns_);
+        double annualise = std::sqrt(periods_per_year_);
+        if (stdev > 0) stats.sharpe_ratio = return_mean_ / stdev * annualise;
+        if (downside > 0) stats.sortino_ratio = return_mean_ / downside * annualise;
+    }
+    return stats;
+}
+
+double PerformanceTracker::periodsPerYear(int64_t first_timestamp, int64_t last_timestamp, size_t bars) {
+    const double seconds_per_year = 365.25 * 86400.0;
+    if (bars < 2 || last_timestamp <= first_timestamp) return 252.0;
+    return static_cast<double>(bars - 1) * seconds_per_year / static_cast<double>(last_timestamp - first_timestamp);
+}
+}
@@ -0,0 +1,84 @@
+#ifndef PERFORMANCE_TRACKER_H
+#define PERFORMANCE_TRACKER_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include "Types.h"
+#include "RunArena.h"
+
+namespace TradingBot {
+
+// Incremental trading statistics. Memory does not grow with the number of
+// trades or bars: fills are matched FIFO against the open lots of their
+// symbol (so only open lots are stored), and the equity curve is folded
+// into running peak/drawdown and return moments as it is marked.
+//
+//   onFill()  - every executed trade
+//   onMark()  - once per bar with the current equity (cash + positions)
+//   onMarks() - the same for a run of bars at once; cheaper per bar
+//
+// snapshot() can be taken at any time, e.g. for running stats in live mode.
+class PerformanceTracker {
+public:
+    PerformanceTracker();
+    PerformanceTracker(const PerformanceTracker&) = delete;
+    PerformanceTracker& operator=(const PerformanceTracker&) = delete;
+    void reset();  // registered symbols stay registered
+    // Symbols known before the run: their first fill then finds its lot
+    // queue without allocating
+    void registerSymbol(const std::string& symbol) { open_lots_[symbol]; }
+    // Bars per year used to annualise Sharpe/Sortino (default 252, daily bars)
+    void setPeriodsPerYear(double periods) { periods_per_year_ = periods; }
+    void onFill(const Trade& trade);
+    void onFill(const std::string& symbol, Signal signal, int quantity, double price, double fees = 0.0);
+    void onMark(double equity, bool in_market);
+    void onMarks(const double* equity, const uint8_t* in_market, size_t count);
+    void onMarks(double equity, bool in_market, size_t count);  // the same equity `count` times
+    Statistics snapshot(double initial_balance, double current_balance) const;
+    int roundTrips() const { return winning_ + losing_; }
+    // Bars per year implied by a series' first/last timestamp (252 if unknown)
+    static double periodsPerYear(int64_t first_timestamp, int64_t last_timestamp, size_t bars);
+private:
+    struct Lot {
+        int quantity;
+        double price;   // per share, buy fees included
+        Lot* next;
+    };
+    struct LotQueue {   // oldest first
+        Lot* head;
+        Lot* tail;
+        LotQueue() : head(nullptr), tail(nullptr) {}
+    };
+    // Lots are pooled in an arena, so steady-state fills don't touch the heap
+    RunArena arena_;
+    ArenaPool<Lot> lot_pool_;
+    std::unordered_map<std::string, LotQueue> open_lots_;
+    std::string last_symbol_;           // runs of one symbol skip the hash lookup
+    LotQueue* last_lots_;               // map nodes are stable, so this stays valid
+    int fills_;
+    int winning_;
+    int losing_;
+    double gross_profit_;
+    double gross_loss_;
+    double largest_win_;
+    double largest_loss_;
+
+    // Equity curve
+    double periods_per_year_;
+    long long marks_;
+    long long marks_in_market_;
+    double last_equity_;
+    double peak_equity_;
+    double max_drawdown_;
+    double max_drawdown_pct_;
+    long long returns_;        // Welford over per-bar returns
+    double return_mean_;
+    double return_m2_;
+    double downside_sq_sum_;
+
+    void foldReturns(const double* returns, size_t count);
+};
+}
+
+#endif
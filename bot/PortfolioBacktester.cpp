@@ -0,0 +1,222 @@
+#include "PortfolioBacktester.h"
+#include "SignalKernel.h"
+#include "Strategy.h"
+#include "RiskManager.h"
+#include "BrokerSimulator.h"
+#include "ThreadPool.h"
+#include "PerformanceTracker.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+namespace TradingBot {
+
+PortfolioBacktester::PortfolioBacktester(const BacktestParams& params, bool vectorized_signals)
+    : params_(params), vectorized_(vectorized_signals), verbose_(false) {}
+
+void PortfolioBacktester::addSymbol(const std::string& symbol, const BarSeries& series) {
+    Instrument instrument;
+    instrument.symbol = symbol;
+    instrument.series = &series;
+    instruments_.push_back(instrument);
+}
+
+void PortfolioBacktester::collectOrders(uint32_t symbol, std::vector<Order>& orders) const {
+    const BarSeries& series = *instruments_[symbol].series;
+    size_t total_bars = series.size();
+    if (total_bars == 0) return;
+    Span<const int64_t> timestamps = series.timestamps();
+    size_t start = std::min(static_cast<size_t>(std::max(params_.long_ma_period, 0)), total_bars);
+
+    std::vector<int8_t> signals(total_bars - start, kSignalHold);
+    if (vectorized_) {
+        SignalKernel kernel(series.close());
+        kernel.computeSignals(SignalParams(params_.short_ma_period, params_.long_ma_period, params_.rsi_period,
+                                           params_.rsi_upper, params_.rsi_lower),
+                              start, total_bars, signals.data());
+    } else {
+        Strategy strategy(params_.short_ma_period, params_.long_ma_period, params_.rsi_period,
+                          params_.rsi_upper, params_.rsi_lower);
+        strategy.setVerbose(false);
+        for (size_t i = start; i < total_bars; ++i) {
+            Signal signal = strategy.generateSignal(series.close(), i);
+            signals[i - start] = signal == Signal::BUY ? kSignalBuy : (signal == Signal::SELL ? kSignalSell : kSignalHold);
+        }
+    }
+    for (size_t i = start; i < total_bars; ++i) {
+        int8_t code = signals[i - start];
+        if (code == kSignalHold) continue;
+        Order order;
+        order.timestamp = timestamps[i];
+        order.phase = code == kSignalBuy ? kPhaseBuy : kPhaseSell;
+        order.symbol = symbol;
+        order.bar = static_cast<uint32_t>(i);
+        orders.push_back(order);
+    }
+    Order close;
+    close.timestamp = timestamps[total_bars - 1];
+    close.phase = kPhaseClose;
+    close.symbol = symbol;
+    close.bar = static_cast<uint32_t>(total_bars - 1);
+    orders.push_back(close);
+}
+
+PortfolioResult PortfolioBacktester::run(TradeLogger& logger, size_t threads) {
+    PortfolioResult result;
+    auto start = std::chrono::steady_clock::now();
+
+    // Phase 1: every symbol's orders, independently and in parallel
+    std::vector<std::vector<Order>> per_symbol(instruments_.size());
+    {
+        ThreadPool pool(std::min(threads == 0 ? ThreadPool::defaultThreadCount() : threads,
+                                 std::max<size_t>(instruments_.size(), 1)));
+        parallelFor(pool, instruments_.size(), [&](size_t k) {
+            collectOrders(static_cast<uint32_t>(k), per_symbol[k]);
+        });
+    }
+    std::vector<Order> orders;
+    size_t order_count = 0;
+    for (const auto& list : per_symbol) order_count += list.size();
+    orders.reserve(order_count);
+    for (auto& list : per_symbol) {
+        orders.insert(orders.end(), list.begin(), list.end());
+        std::vector<Order>().swap(list);
+    }
+    std::sort(orders.begin(), orders.end(), [](const Order& a, const Order& b) {
+        if (a.timestamp != b.timestamp) return a.timestamp < b.timestamp;
+        if (a.phase != b.phase) return a.phase < b.phase;
+        return a.symbol < b.symbol;
+    });
+    auto signals_done = std::chrono::steady_clock::now();
+    result.signal_seconds = std::chrono::duration<double>(signals_done - start).count();
+
+    // Phase 2: fill against the shared cash balance in timeline order
+    RiskManager riskManager(params_.risk_percentage);
+    BrokerSimulator broker(params_.initial_balance);
+    broker.setVerbose(verbose_);
+    std::vector<double> bought(instruments_.size(), 0.0), sold(instruments_.size(), 0.0);
+    std::vector<PerformanceTracker> symbol_stats(instruments_.size());
+    std::vector<SymbolId> broker_ids(instruments_.size());  // interned up front; fills never touch names
+    for (size_t k = 0; k < instruments_.size(); ++k) broker_ids[k] = broker.registerSymbol(instruments_[k].symbol);
+
+    // Equity is marked once per timestamp on which any symbol has a tradable
+    // bar, after that timestamp's orders, for the portfolio's drawdown/Sharpe
+    std::vector<int64_t> marks;
+    for (const Instrument& instrument : instruments_) {
+        Span<const int64_t> timestamps = instrument.series->timestamps();
+        size_t first = std::min(static_cast<size_t>(std::max(params_.long_ma_period, 0)), timestamps.size());
+        marks.insert(marks.end(), timestamps.begin() + first, timestamps.end());
+    }
+    std::sort(marks.begin(), marks.end());
+    marks.erase(std::unique(marks.begin(), marks.end()), marks.end());
+    if (!marks.empty()) {
+        logger.performance().setPeriodsPerYear(PerformanceTracker::periodsPerYear(marks.front(), marks.back(),
+                                                                                  marks.size()));
+    }
+    std::vector<size_t> last_bar(instruments_.size(), 0);  // held symbols: latest bar at or before the mark
+    auto execute = [&](const Order& order) {
+        const Instrument& instrument = instruments_[order.symbol];
+        SymbolId symbol = broker_ids[order.symbol];
+        double price = instrument.series->close()[order.bar];
+        bool filled = false;
+        if (order.phase == kPhaseBuy) {
+            if (!broker.hasPosition(symbol)) {
+                int quantity = riskManager.calculatePositionSize(price, broker.getBalance());
+                filled = quantity > 0 &&
+                         broker.executeBuy(symbol, quantity, price, instrument.series->dateAt(order.bar));
+            }
+        } else if (broker.hasPosition(symbol)) {
+            filled = broker.executeSell(symbol, broker.position(symbol).quantity, price,
+                                        instrument.series->dateAt(order.bar));
+        }
+        if (filled) {
+            const Trade& trade = broker.getLastTrade();
+            logger.logTrade(trade);
+            symbol_stats[order.symbol].onFill(trade);
+            (trade.signal == Signal::BUY ? bought : sold)[order.symbol] += trade.value;
+        }
+        last_bar[order.symbol] = order.bar;
+    };
+
+    size_t next_order = 0;
+    for (size_t m = 0; m <= marks.size(); ++m) {
+        // Past the last mark, whatever is left (symbols too short to trade) still fills
+        bool tail = m == marks.size();
+        for (; next_order < orders.size(); ++next_order) {
+            const Order& order = orders[next_order];
+            if (!tail && (order.timestamp > marks[m] ||
+                          (order.timestamp == marks[m] && order.phase == kPhaseClose))) break;
+            execute(order);
+        }
+        if (tail) break;
+        double equity = broker.getBalance();
+        bool in_market = false;
+        for (size_t k = 0; k < instruments_.size(); ++k) {
+            int held = broker.position(broker_ids[k]).quantity;
+            if (held == 0) continue;
+            Span<const int64_t> timestamps = instruments_[k].series->timestamps();
+            size_t& bar = last_bar[k];
+            while (bar + 1 < timestamps.size() && timestamps[bar + 1] <= marks[m]) bar++;
+            equity += held * instruments_[k].series->close()[bar];
+            in_market = true;
+        }
+        logger.performance().onMark(equity, in_market);
+        // A symbol's last bar is marked while still held, as in a single backtest, then closed
+        for (; next_order < orders.size() && orders[next_order].timestamp <= marks[m]; ++next_order) {
+            execute(orders[next_order]);
+        }
+    }
+    result.execution_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - signals_done).count();
+
+    result.final_balance = broker.getBalance();
+    result.stats.total_profit_loss = result.final_balance - params_.initial_balance;
+    for (size_t k = 0; k < instruments_.size(); ++k) {
+        SymbolResult symbol_result;
+        symbol_result.symbol = instruments_[k].symbol;
+        symbol_result.bars = instruments_[k].series->size();
+        // every position is closed by now, so sold - bought is the realised P/L
+        symbol_result.stats = symbol_stats[k].snapshot(bought[k], sold[k]);
+        const Statistics& s = symbol_result.stats;
+        result.stats.total_trades += s.total_trades;
+        result.stats.winning_trades += s.winning_trades;
+        result.stats.losing_trades += s.losing_trades;
+        result.stats.gross_profit += s.gross_profit;
+        result.stats.gross_loss += s.gross_loss;
+        result.stats.largest_win = std::max(result.stats.largest_win, s.largest_win);
+        result.stats.largest_loss = std::min(result.stats.largest_loss, s.largest_loss);
+        result.symbols.push_back(symbol_result);
+    }
+    int round_trips = result.stats.winning_trades + result.stats.losing_trades;
+    if (round_trips > 0) {
+        result.stats.win_rate = static_cast<double>(result.stats.winning_trades) / round_trips * 100.0;
+    }
+    if (result.stats.gross_loss > 0) {
+        result.stats.profit_factor = result.stats.gross_profit / result.stats.gross_loss;
+    }
+    // Drawdown, Sharpe/Sortino and exposure of the combined equity
+    Statistics curve = logger.performance().snapshot(params_.initial_balance, result.final_balance);
+    result.stats.marked_bars = curve.marked_bars;
+    result.stats.max_drawdown = curve.max_drawdown;
+    result.stats.max_drawdown_pct = curve.max_drawdown_pct;
+    result.stats.sharpe_ratio = curve.sharpe_ratio;
+    result.stats.sortino_ratio = curve.sortino_ratio;
+    result.stats.exposure_pct = curve.exposure_pct;
+    return result;
+}
+
+void PortfolioBacktester::printTable(const PortfolioResult& result) {
+    std::cout << "\n" << std::string(60, '=') << "\n";
+    std::cout << "  Symbol            Bars   Trades    Win%        P/L (INR)\n";
+    std::cout << std::string(60, '-') << "\n";
+    std::cout << std::fixed;
+    for (const SymbolResult& row : result.symbols) {
+        std::cout << "  " << std::left << std::setw(14) << row.symbol << std::right
+                  << std::setw(8) << row.bars
+                  << std::setw(9) << row.stats.total_trades
+                  << std::setw(8) << std::setprecision(1) << row.stats.win_rate
+                  << std::setw(17) << std::setprecision(2) << row.stats.total_profit_loss << "\n";
+    }
+    std::cout << std::string(60, '=') << "\n";
+}
+}
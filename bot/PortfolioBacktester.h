@@ -0,0 +1,81 @@
+#ifndef PORTFOLIO_BACKTESTER_H
+#define PORTFOLIO_BACKTESTER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Types.h"
+#include "BarSeries.h"
+#include "Backtester.h"
+#include "TradeLogger.h"
+
+namespace TradingBot {
+
+struct SymbolResult {
+    std::string symbol;
+    size_t bars;
+    Statistics stats;   // total_profit_loss is this symbol's realised P/L
+
+    SymbolResult() : bars(0) {}
+};
+
+struct PortfolioResult {
+    double final_balance;
+    Statistics stats;                  // all symbols together
+    std::vector<SymbolResult> symbols; // in the order they were added
+    double signal_seconds;             // parallel per-symbol phase
+    double execution_seconds;          // sequential shared-cash phase
+
+    PortfolioResult() : final_balance(0), signal_seconds(0), execution_seconds(0) {}
+};
+
+// MA crossover backtest of several symbols against one cash balance. Fills
+// are always at the close without costs (params.execution and
+// use_matching_engine do not apply).
+//
+// Signals only depend on a symbol's own closes, so they are generated for
+// every symbol in parallel first. Orders are then merged onto one timeline
+// and filled in timestamp order by a single BrokerSimulator; at each
+// timestamp sells go first (freeing cash), then buys in the order the
+// symbols were added, so results do not depend on the thread count.
+// Symbols need not share a calendar: a symbol simply has no orders at
+// timestamps where it has no bar. Positions still open are closed at each
+// symbol's last bar. After each timestamp's orders the combined equity
+// (cash plus every open position at its latest close) is marked on the
+// logger's PerformanceTracker, which gives the portfolio's drawdown,
+// Sharpe/Sortino and exposure.
+class PortfolioBacktester {
+public:
+    // params.symbol is ignored; every other field applies to all symbols
+    PortfolioBacktester(const BacktestParams& params, bool vectorized_signals = true);
+    void addSymbol(const std::string& symbol, const BarSeries& series); // series must outlive the run
+    size_t symbolCount() const { return instruments_.size(); }
+    void setVerbose(bool verbose) { verbose_ = verbose; } // fills on stdout
+    PortfolioResult run(TradeLogger& logger, size_t threads = 0);
+
+    static void printTable(const PortfolioResult& result);
+private:
+    struct Instrument {
+        std::string symbol;
+        const BarSeries* series;
+    };
+    // One order on the merged timeline
+    struct Order {
+        int64_t timestamp;
+        uint8_t phase;      // kPhaseSell, kPhaseBuy or kPhaseClose
+        uint32_t symbol;    // index into instruments_
+        uint32_t bar;       // row in that symbol's series
+    };
+    static const uint8_t kPhaseSell = 0;
+    static const uint8_t kPhaseBuy = 1;
+    static const uint8_t kPhaseClose = 2;  // end of a symbol's data
+
+    BacktestParams params_;
+    bool vectorized_;
+    bool verbose_;
+    std::vector<Instrument> instruments_;
+    void collectOrders(uint32_t symbol, std::vector<Order>& orders) const;
+};
+}
+
+#endif
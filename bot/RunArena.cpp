@@ -0,0 +1,56 @@
+#include "RunArena.h"
+#include <algorithm>
+
+namespace TradingBot {
+
+RunArena::RunArena(size_t chunk_bytes)
+    : chunk_bytes_(std::max<size_t>(chunk_bytes, 4096)), current_(0), offset_(0), reserved_(0) {
+    // The first chunk comes with the arena, so a run's first allocation from it stays off the heap
+    chunks_.reserve(4);
+    addChunk(chunk_bytes_);
+}
+
+void* RunArena::allocate(size_t bytes, size_t alignment) {
+    for (;;) {
+        if (current_ < chunks_.size()) {
+            Chunk& chunk = chunks_[current_];
+            uintptr_t base = reinterpret_cast<uintptr_t>(chunk.data.get());
+            uintptr_t aligned = (base + offset_ + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+            size_t end = static_cast<size_t>(aligned - base) + bytes;
+            if (end <= chunk.size) {
+                offset_ = end;
+                return reinterpret_cast<void*>(aligned);
+            }
+            // Try the next chunk kept from an earlier run before growing
+            if (current_ + 1 < chunks_.size()) {
+                current_++;
+                offset_ = 0;
+                continue;
+            }
+        }
+        // Oversized requests get a chunk of their own
+        addChunk(std::max(chunk_bytes_, bytes + alignment));
+        current_ = chunks_.size() - 1;
+        offset_ = 0;
+    }
+}
+
+void RunArena::addChunk(size_t size) {
+    Chunk chunk;
+    chunk.data.reset(new unsigned char[size]);
+    chunk.size = size;
+    reserved_ += size;
+    chunks_.push_back(std::move(chunk));
+}
+
+void RunArena::reset() {
+    current_ = 0;
+    offset_ = 0;
+}
+
+size_t RunArena::bytesUsed() const {
+    size_t used = 0;
+    for (size_t i = 0; i < current_ && i < chunks_.size(); ++i) used += chunks_[i].size;
+    return used + offset_;
+}
+}
@@ -0,0 +1,94 @@
+#ifndef RUN_ARENA_H
+#define RUN_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace TradingBot {
+
+// Monotonic bump allocator that owns the scratch memory of one run: the
+// Backtester's signal batch, and (in an arena of its own) the
+// PerformanceTracker's FIFO lots. Nothing
+// is freed individually; reset() rewinds to the start and keeps every
+// chunk, so a worker that runs thousands of sweep combinations allocates
+// only while its arena grows to the largest run. Only trivially
+// destructible objects belong here.
+//
+// Trade, position and order records are deliberately not arena objects:
+// no trade history is kept (the broker holds the last Trade and the logger
+// streams each one out), positions are a dense array by SymbolId, and
+// order nodes come from the MatchingEngine's own OrderPool. Each of those
+// is sized once per run and reused, so none of them allocates per bar.
+class RunArena {
+public:
+    explicit RunArena(size_t chunk_bytes = 1 << 20);
+    RunArena(const RunArena&) = delete;
+    RunArena& operator=(const RunArena&) = delete;
+
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+    template <typename T>
+    T* allocateArray(size_t count) {
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+    void reset();                   // every pointer handed out is dead afterwards
+    size_t bytesUsed() const;       // since the last reset
+    size_t bytesReserved() const { return reserved_; }
+    size_t chunkCount() const { return chunks_.size(); }
+private:
+    struct Chunk {
+        std::unique_ptr<unsigned char[]> data;
+        size_t size;
+    };
+    size_t chunk_bytes_;
+    std::vector<Chunk> chunks_;
+    size_t current_;    // chunk being bumped
+    size_t offset_;     // within it
+    size_t reserved_;
+    void addChunk(size_t size);
+};
+
+// Free-list pool of T carved from a RunArena. acquire() reuses released
+// slots before bumping the arena; the pool must be reset together with
+// (or before) its arena.
+template <typename T>
+class ArenaPool {
+public:
+    explicit ArenaPool(RunArena& arena) : arena_(arena), free_(nullptr), live_(0) {}
+    T* acquire() {
+        void* slot;
+        if (free_) {
+            slot = free_;
+            free_ = free_->next;
+        } else {
+            slot = arena_.allocate(sizeof(Slot), alignof(Slot));
+        }
+        live_++;
+        return new (slot) T();
+    }
+    void release(T* object) {
+        object->~T();
+        Slot* slot = reinterpret_cast<Slot*>(object);
+        slot->next = free_;
+        free_ = slot;
+        live_--;
+    }
+    void reset() {
+        free_ = nullptr;
+        live_ = 0;
+    }
+    size_t live() const { return live_; }
+private:
+    union Slot {
+        Slot* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+    RunArena& arena_;
+    Slot* free_;
+    size_t live_;
+};
+}
+
+#endif
@@ -0,0 +1,308 @@
+#include "ShardedLiveEngine.h"
+#include "BrokerSimulator.h"
+#include "EventEngine.h"
+#include "MarketGenerator.h"
+#include "PaceTimer.h"
+#include "RiskManager.h"
+#include "Strategy.h"
+#include "ThreadPool.h"
+#include "TradingHandlers.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+namespace TradingBot {
+
+namespace {
+
+typedef ShardedLiveEngine::ShardUpdate ShardUpdate;
+
+// Sends the aggregator every fill as it is booked, and the position and
+// cash every `interval` bars; stands where a TradeRecorder would
+class ShardReporter : public EventHandler {
+public:
+    ShardReporter(uint32_t shard, const BrokerSimulator& broker, SymbolId symbol, SpscQueue<ShardUpdate>& out,
+                  uint32_t interval)
+        : shard_(shard), broker_(broker), symbol_(symbol), out_(out), interval_(std::max<uint32_t>(interval, 1)),
+          bars_(0), last_price_(0) {}
+    void onEvent(const Event& event, EventEngine&) override {
+        ShardUpdate update = make(event.price);
+        update.fill = true;
+        update.side = event.side;
+        update.quantity = event.quantity;
+        update.balance = event.fill.balance_after;
+        update.fees = event.fill.fees;
+        pushBlocking(out_, update);
+    }
+    void onBarClose(const Event& bar, EventEngine&) override {
+        bars_++;
+        last_price_ = bar.price;
+        if (bars_ % interval_ == 0) mark();
+    }
+    void mark() {
+        ShardUpdate update = make(last_price_);
+        update.quantity = broker_.position(symbol_).quantity;
+        pushBlocking(out_, update);
+    }
+private:
+    uint32_t shard_;
+    const BrokerSimulator& broker_;
+    SymbolId symbol_;
+    SpscQueue<ShardUpdate>& out_;
+    uint32_t interval_;
+    uint64_t bars_;
+    double last_price_;
+
+    ShardUpdate make(double price) const {
+        ShardUpdate update;
+        update.shard = shard_;
+        update.fill = false;
+        update.side = Signal::HOLD;
+        update.quantity = 0;
+        update.price = price;
+        update.balance = broker_.getBalance();
+        update.fees = 0;
+        update.bars = bars_;
+        return update;
+    }
+};
+
+// Everything one strategy instance needs, on the usual handler chain
+struct Shard {
+    MarketGenerator generator;
+    Strategy strategy;
+    RiskManager risk;
+    BrokerSimulator broker;
+    SymbolId symbol;
+    CloseExecution execution;
+    SignalHandler signals;
+    RiskHandler risk_handler;
+    ShardReporter reporter;
+    EventEngine engine;
+    uint32_t bar;
+
+    Shard(uint32_t index, const ShardSpec& spec, const ShardedLiveOptions& options, SpscQueue<ShardUpdate>& out)
+        : generator(options.generator, MarketGenerator::streamId(spec.symbol_index, 0)),
+          strategy(spec.params.short_ma_period, spec.params.long_ma_period, spec.params.rsi_period,
+                   spec.params.rsi_upper, spec.params.rsi_lower),
+          risk(spec.params.risk_percentage), broker(spec.params.initial_balance),
+          symbol(broker.registerSymbol(spec.params.symbol)), execution(broker), signals(strategy),
+          risk_handler(risk, broker, execution), reporter(index, broker, symbol, out, options.mark_interval),
+          bar(0) {
+        broker.setVerbose(false);
+        strategy.setVerbose(false);
+        std::vector<double> history(static_cast<size_t>(std::max(options.history, 0)));
+        generator.generate(history.size(), nullptr, nullptr, nullptr, nullptr, history.data(), nullptr);
+        strategy.warmUp(history);
+        attachTradingChain(engine, signals, risk_handler, execution, reporter);
+    }
+    void step() {
+        Event event;
+        generator.generate(1, &event.timestamp, &event.market.open, &event.market.high, &event.market.low,
+                           &event.price, &event.market.volume);
+        event.symbol = symbol;
+        event.bar = bar++;
+        engine.step(event);
+    }
+};
+}
+
+uint64_t ShardedLiveResult::bars() const {
+    uint64_t total = 0;
+    for (uint64_t bars : worker_bars) total += bars;
+    return total;
+}
+
+ShardedLiveEngine::ShardedLiveEngine(const std::vector<ShardSpec>& shards, const ShardedLiveOptions& options)
+    : specs_(shards), options_(options) {}
+
+uint64_t ShardedLiveEngine::workerLoop(size_t worker, size_t workers, SpscQueue<ShardUpdate>& out,
+                                       std::atomic<size_t>& ready, bool& pinned) {
+    pinned = options_.pin_threads && pinCurrentThread(worker % ThreadPool::defaultThreadCount());
+    // Built here, after pinning, so each shard's memory is first touched by the core that uses it
+    std::vector<std::unique_ptr<Shard>> shards;
+    for (size_t i = worker; i < specs_.size(); i += workers) {
+        shards.emplace_back(new Shard(static_cast<uint32_t>(i), specs_[i], options_, out));
+    }
+    // Start together so the aggregator times only the bars
+    ready.fetch_add(1, std::memory_order_acq_rel);
+    Backoff backoff;
+    while (ready.load(std::memory_order_acquire) < workers) backoff.pause();
+
+    const std::atomic<bool>* stop = options_.stop_flag;
+    bool paced = options_.feed_rate > 0;
+    PaceTimer pacing;
+    pacing.start();
+    uint64_t bars = 0;
+    for (int round = 0; round < options_.bars; ++round) {
+        if (stop && stop->load(std::memory_order_relaxed)) break;
+        if (paced && round > 0) {
+            auto offset = std::chrono::duration_cast<PaceTimer::Clock::duration>(
+                std::chrono::duration<double>(round / options_.feed_rate));
+            if (!pacing.waitUntil(offset, stop)) break;
+        }
+        for (const std::unique_ptr<Shard>& shard : shards) shard->step();
+        bars += shards.size();
+    }
+    for (const std::unique_ptr<Shard>& shard : shards) {
+        shard->engine.drain();
+        shard->reporter.mark();
+    }
+    return bars;
+}
+
+void ShardedLiveEngine::apply(const ShardUpdate& update, ShardState& state) {
+    state.bars = update.bars;
+    state.last_price = update.price;
+    state.balance = update.balance;
+    if (!update.fill) {
+        state.position = update.quantity;
+        return;
+    }
+    state.fills++;
+    if (update.side == Signal::BUY) {
+        if (state.position == 0) state.entry_balance = update.balance + update.quantity * update.price + update.fees;
+        state.position += update.quantity;
+    } else {
+        state.position -= update.quantity;
+        if (state.position == 0) {
+            state.round_trips++;
+            if (update.balance > state.entry_balance) state.winning_trips++;
+        }
+    }
+}
+
+ShardedLiveResult ShardedLiveEngine::run() {
+    ShardedLiveResult result;
+    size_t workers = options_.threads ? options_.threads : ThreadPool::defaultThreadCount();
+    workers = std::max<size_t>(1, std::min(workers, specs_.size()));
+    result.shards.resize(specs_.size());
+    for (size_t i = 0; i < specs_.size(); ++i) {
+        result.shards[i].balance = result.shards[i].entry_balance = specs_[i].params.initial_balance;
+    }
+    result.worker_bars.assign(workers, 0);
+    if (specs_.empty()) return result;
+
+    std::vector<std::unique_ptr<SpscQueue<ShardUpdate>>> rings;
+    std::unique_ptr<std::atomic<bool>[]> done(new std::atomic<bool>[workers]);
+    std::vector<uint8_t> pinned(workers, 0);
+    std::atomic<size_t> ready(0);
+    std::vector<std::thread> threads;
+    for (size_t w = 0; w < workers; ++w) {
+        rings.emplace_back(new SpscQueue<ShardUpdate>(options_.queue_capacity));
+        done[w].store(false);
+    }
+    for (size_t w = 0; w < workers; ++w) {
+        threads.emplace_back([&, w]() {
+            bool got_cpu = false;
+            result.worker_bars[w] = workerLoop(w, workers, *rings[w], ready, got_cpu);
+            pinned[w] = got_cpu;
+            done[w].store(true, std::memory_order_release);
+        });
+    }
+    Backoff backoff;
+    while (ready.load(std::memory_order_acquire) < workers) backoff.pause();
+    auto start = std::chrono::steady_clock::now();
+
+    // Aggregator: round-robin over the rings until every worker is done and drained
+    size_t finished = 0;
+    backoff.reset();
+    while (finished < workers) {
+        finished = 0;
+        bool any = false;
+        for (size_t w = 0; w < workers; ++w) {
+            // Read the flag before popping so updates pushed just before it was set are not missed
+            bool worker_done = done[w].load(std::memory_order_acquire);
+            ShardUpdate update;
+            while (rings[w]->tryPop(update)) {
+                apply(update, result.shards[update.shard]);
+                result.messages++;
+                any = true;
+            }
+            if (worker_done) finished++;
+        }
+        if (any) {
+            backoff.reset();
+        } else if (finished < workers) {
+            backoff.pause();
+        }
+    }
+    for (std::thread& thread : threads) thread.join();
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    for (uint8_t got_cpu : pinned) result.pinned_workers += got_cpu;
+    return result;
+}
+
+void ShardedLiveEngine::printReport(const ShardedLiveResult& result, size_t top) const {
+    double seconds = result.seconds > 0 ? result.seconds : 1e-9;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "\n" << std::string(78, '=') << "\n";
+    std::cout << "  " << specs_.size() << " shards on " << result.worker_bars.size() << " workers ("
+              << result.pinned_workers << " pinned) | " << result.bars() << " bars in " << result.seconds
+              << " s | " << result.bars() / seconds << " bars/s\n";
+    for (size_t w = 0; w < result.worker_bars.size(); ++w) {
+        std::cout << "  Worker " << std::setw(3) << w << ": " << std::setw(12) << result.worker_bars[w]
+                  << " bars, " << std::setw(14) << result.worker_bars[w] / seconds << " bars/s\n";
+    }
+    double initial = 0, equity = 0;
+    int fills = 0, trips = 0, wins = 0, open = 0;
+    for (size_t i = 0; i < result.shards.size(); ++i) {
+        const ShardState& shard = result.shards[i];
+        initial += specs_[i].params.initial_balance;
+        equity += shard.equity();
+        fills += shard.fills;
+        trips += shard.round_trips;
+        wins += shard.winning_trips;
+        open += shard.position != 0;
+    }
+    std::cout << "  Fills: " << fills << " | Round trips: " << trips << " | Win rate: "
+              << (trips ? 100.0 * wins / trips : 0.0) << "% | Open positions: " << open << " | Updates: "
+              << result.messages << "\n";
+    std::cout << "  Equity: INR " << equity << " (from INR " << initial << ") | P/L: INR " << equity - initial
+              << "\n";
+
+    std::vector<size_t> order(result.shards.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return result.shards[a].equity() - specs_[a].params.initial_balance >
+               result.shards[b].equity() - specs_[b].params.initial_balance;
+    });
+    std::cout << std::string(78, '-') << "\n";
+    std::cout << "  Rank  Shard  Symbol  Short  Long  Risk%   Fills   Win%  Position        P/L (INR)\n";
+    for (size_t r = 0; r < std::min(top, order.size()); ++r) {
+        const ShardState& shard = result.shards[order[r]];
+        const BacktestParams& params = specs_[order[r]].params;
+        std::cout << std::setw(6) << (r + 1) << std::setw(7) << order[r] << std::setw(8) << params.symbol
+                  << std::setw(7) << params.short_ma_period << std::setw(6) << params.long_ma_period
+                  << std::setprecision(1) << std::setw(7) << params.risk_percentage << std::setw(8) << shard.fills
+                  << std::setw(7) << (shard.round_trips ? 100.0 * shard.winning_trips / shard.round_trips : 0.0)
+                  << std::setw(10) << shard.position << std::setprecision(2) << std::setw(17)
+                  << shard.equity() - params.initial_balance << "\n";
+    }
+    std::cout << std::string(78, '=') << "\n";
+}
+
+bool ShardedLiveEngine::writeCSV(const std::string& filename, const ShardedLiveResult& result) const {
+    std::ofstream out(filename);
+    if (!out.is_open()) {
+        std::cerr << "Warning: Could not create shard results file " << filename << std::endl;
+        return false;
+    }
+    out << "Shard,Symbol,ShortMA,LongMA,RSIPeriod,RSIUpper,RSILower,RiskPercentage,Bars,Fills,RoundTrips,"
+           "WinningTrips,Position,LastPrice,Balance,Equity,ProfitLoss\n";
+    out << std::fixed << std::setprecision(2);
+    for (size_t i = 0; i < result.shards.size(); ++i) {
+        const ShardState& shard = result.shards[i];
+        const BacktestParams& params = specs_[i].params;
+        out << i << "," << params.symbol << "," << params.short_ma_period << "," << params.long_ma_period << ","
+            << params.rsi_period << "," << params.rsi_upper << "," << params.rsi_lower << ","
+            << params.risk_percentage << "," << shard.bars << "," << shard.fills << "," << shard.round_trips << ","
+            << shard.winning_trips << "," << shard.position << "," << shard.last_price << "," << shard.balance
+            << "," << shard.equity() << "," << shard.equity() - params.initial_balance << "\n";
+    }
+    return true;
+}
+}
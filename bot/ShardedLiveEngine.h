@@ -0,0 +1,103 @@
+#ifndef SHARDED_LIVE_ENGINE_H
+#define SHARDED_LIVE_ENGINE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Types.h"
+#include "Backtester.h"
+#include "SpscQueue.h"
+
+namespace TradingBot {
+
+// One strategy instance trading one synthetic symbol with its own cash.
+// Shards on the same symbol index see the same bars.
+struct ShardSpec {
+    BacktestParams params;      // symbol name, strategy, risk and starting cash
+    uint32_t symbol_index;      // generator stream
+};
+
+struct ShardedLiveOptions {
+    int bars;                   // per shard, after the warm-up
+    int history;                // warm-up bars per shard
+    double feed_rate;           // rounds (one bar for every shard) per second; 0 = unthrottled
+    size_t threads;             // workers; 0 = one per hardware thread
+    bool pin_threads;           // worker i stays on CPU i (modulo the CPU count)
+    size_t queue_capacity;      // per worker -> aggregator ring
+    uint32_t mark_interval;     // bars between a shard's position/equity reports
+    GeneratorParams generator;
+    const std::atomic<bool>* stop_flag;  // optional; workers stop at the next round once it is set
+
+    ShardedLiveOptions() : bars(10000), history(200), feed_rate(0), threads(0), pin_threads(true),
+                           queue_capacity(4096), mark_interval(256), stop_flag(nullptr) {}
+};
+
+// What the aggregator knows about a shard from its messages
+struct ShardState {
+    double balance;
+    double last_price;
+    double entry_balance;       // cash before the open position was bought
+    int position;
+    int fills;
+    int round_trips;
+    int winning_trips;
+    uint64_t bars;
+
+    ShardState() : balance(0), last_price(0), entry_balance(0), position(0), fills(0), round_trips(0),
+                   winning_trips(0), bars(0) {}
+    double equity() const { return balance + position * last_price; }
+};
+
+struct ShardedLiveResult {
+    std::vector<ShardState> shards;     // by shard index
+    std::vector<uint64_t> worker_bars;  // bars each worker processed
+    size_t pinned_workers;              // workers that got their own CPU
+    uint64_t messages;                  // fills and marks the aggregator took
+    double seconds;
+
+    ShardedLiveResult() : pinned_workers(0), messages(0), seconds(0) {}
+    uint64_t bars() const;
+};
+
+// Live simulation of many strategy instances at once:
+//   worker threads (each owns a disjoint set of shards) --ShardUpdate rings--> aggregator
+// A shard is a generator, Strategy, RiskManager, BrokerSimulator and its
+// own EventEngine with the usual handler chain, built on the worker that
+// runs it and never touched by another thread. Workers step their shards
+// one bar per round and report fills, and every mark_interval bars the
+// position and cash, over one SPSC ring each to the aggregator on the
+// caller's thread. Nothing is shared on the hot path but the rings, so
+// throughput grows with the number of cores.
+class ShardedLiveEngine {
+public:
+    ShardedLiveEngine(const std::vector<ShardSpec>& shards, const ShardedLiveOptions& options);
+    ShardedLiveResult run();
+    // Totals, per-worker throughput and the `top` shards by P/L
+    void printReport(const ShardedLiveResult& result, size_t top) const;
+    bool writeCSV(const std::string& filename, const ShardedLiveResult& result) const;
+
+    // Worker -> aggregator record: a booked fill, or a shard's position at a bar close
+    struct ShardUpdate {
+        uint32_t shard;
+        bool fill;
+        Signal side;
+        int quantity;           // fill size, or the position for a mark
+        double price;           // fill price, or the close the shard was marked at
+        double balance;         // shard cash afterwards
+        double fees;
+        uint64_t bars;          // bars the shard has processed
+    };
+private:
+    std::vector<ShardSpec> specs_;
+    ShardedLiveOptions options_;
+
+    // Builds and runs shards worker, worker + workers, ...; returns bars processed
+    uint64_t workerLoop(size_t worker, size_t workers, SpscQueue<ShardUpdate>& out, std::atomic<size_t>& ready,
+                        bool& pinned);
+    static void apply(const ShardUpdate& update, ShardState& state);
+};
+}
+
+#endif
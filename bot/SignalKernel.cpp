@@ -0,0 +1,240 @@
+#include "SignalKernel.h"
+#include <algorithm>
+#include <cmath>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define TRADINGBOT_AVX2_KERNEL 1
+#include <immintrin.h>
+#endif
+
+namespace TradingBot {
+
+namespace {
+
+// Error-free transformations (Knuth/Dekker); only correct without -ffast-math
+inline void twoSum(double a, double b, double& s, double& e) {
+    s = a + b;
+    double bb = s - a;
+    e = (a - (s - bb)) + (b - bb);
+}
+inline void quickTwoSum(double a, double b, double& s, double& e) {
+    s = a + b;
+    e = b - (s - a);
+}
+inline void twoDiff(double a, double b, double& s, double& e) {
+    s = a - b;
+    double bb = s - a;
+    e = (a - (s - bb)) - (b + bb);
+}
+
+// Append x to a double-double running sum
+inline void accumulate(double& hi, double& lo, double x) {
+    double s, e;
+    twoSum(hi, x, s, e);
+    e += lo;
+    quickTwoSum(s, e, hi, lo);
+}
+
+// Rounded value of prefix[a] - prefix[b]
+inline double windowSum(const double* hi, const double* lo, size_t a, size_t b) {
+    double s, e;
+    twoDiff(hi[a], hi[b], s, e);
+    e += lo[a] - lo[b];
+    return s + e;
+}
+
+inline double rsiFromSums(double gains, double losses, int period) {
+    double avg_gain = gains / period;
+    double avg_loss = losses / period;
+    if (avg_loss <= 0) return 100.0;
+    double rs = avg_gain / avg_loss;
+    return 100.0 - (100.0 / (1.0 + rs));
+}
+
+// out[k] = SMA ending at bar begin + k; every bar in range must have `period` bars of history
+void smaScalar(const double* hi, const double* lo, int period, size_t begin, size_t end, double* out) {
+    for (size_t i = begin; i < end; ++i) {
+        out[i - begin] = windowSum(hi, lo, i + 1, i + 1 - period) / period;
+    }
+}
+void rsiScalar(const double* ghi, const double* glo, const double* lhi, const double* llo,
+               int period, size_t begin, size_t end, double* out) {
+    for (size_t i = begin; i < end; ++i) {
+        double gains = windowSum(ghi, glo, i + 1, i + 1 - period);
+        double losses = windowSum(lhi, llo, i + 1, i + 1 - period);
+        out[i - begin] = rsiFromSums(gains, losses, period);
+    }
+}
+
+#ifdef TRADINGBOT_AVX2_KERNEL
+__attribute__((target("avx2")))
+inline __m256d windowSum4(const double* hi, const double* lo, size_t a, size_t b) {
+    __m256d ah = _mm256_loadu_pd(hi + a);
+    __m256d bh = _mm256_loadu_pd(hi + b);
+    __m256d s = _mm256_sub_pd(ah, bh);
+    __m256d bb = _mm256_sub_pd(s, ah);
+    __m256d e = _mm256_sub_pd(_mm256_sub_pd(ah, _mm256_sub_pd(s, bb)), _mm256_add_pd(bh, bb));
+    e = _mm256_add_pd(e, _mm256_sub_pd(_mm256_loadu_pd(lo + a), _mm256_loadu_pd(lo + b)));
+    return _mm256_add_pd(s, e);
+}
+
+__attribute__((target("avx2")))
+void smaAVX2(const double* hi, const double* lo, int period, size_t begin, size_t end, double* out) {
+    const __m256d divisor = _mm256_set1_pd(static_cast<double>(period));
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m256d sum = windowSum4(hi, lo, i + 1, i + 1 - period);
+        _mm256_storeu_pd(out + (i - begin), _mm256_div_pd(sum, divisor));
+    }
+    // GCC turns the scalar tail into a tail call without clearing the upper
+    // halves; left dirty, every later SSE instruction pays a merge penalty
+    _mm256_zeroupper();
+    smaScalar(hi, lo, period, i, end, out + (i - begin));
+}
+
+__attribute__((target("avx2")))
+void rsiAVX2(const double* ghi, const double* glo, const double* lhi, const double* llo,
+             int period, size_t begin, size_t end, double* out) {
+    const __m256d divisor = _mm256_set1_pd(static_cast<double>(period));
+    const __m256d hundred = _mm256_set1_pd(100.0);
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d zero = _mm256_setzero_pd();
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m256d avg_gain = _mm256_div_pd(windowSum4(ghi, glo, i + 1, i + 1 - period), divisor);
+        __m256d avg_loss = _mm256_div_pd(windowSum4(lhi, llo, i + 1, i + 1 - period), divisor);
+        __m256d rs = _mm256_div_pd(avg_gain, avg_loss);
+        __m256d rsi = _mm256_sub_pd(hundred, _mm256_div_pd(hundred, _mm256_add_pd(one, rs)));
+        __m256d no_loss = _mm256_cmp_pd(avg_loss, zero, _CMP_LE_OQ);
+        _mm256_storeu_pd(out + (i - begin), _mm256_blendv_pd(rsi, hundred, no_loss));
+    }
+    _mm256_zeroupper();     // as in smaAVX2
+    rsiScalar(ghi, glo, lhi, llo, period, i, end, out + (i - begin));
+}
+
+bool detectAVX2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+#else
+bool detectAVX2() {
+    return false;
+}
+#endif
+
+const bool kHasAVX2 = detectAVX2();
+
+void smaRange(const double* hi, const double* lo, int period, size_t begin, size_t end, double* out) {
+#ifdef TRADINGBOT_AVX2_KERNEL
+    if (kHasAVX2) {
+        smaAVX2(hi, lo, period, begin, end, out);
+        return;
+    }
+#endif
+    smaScalar(hi, lo, period, begin, end, out);
+}
+void rsiRange(const double* ghi, const double* glo, const double* lhi, const double* llo,
+              int period, size_t begin, size_t end, double* out) {
+#ifdef TRADINGBOT_AVX2_KERNEL
+    if (kHasAVX2) {
+        rsiAVX2(ghi, glo, lhi, llo, period, begin, end, out);
+        return;
+    }
+#endif
+    rsiScalar(ghi, glo, lhi, llo, period, begin, end, out);
+}
+
+const size_t kBlock = 512;  // bars per block; keeps the per-block buffers in L1
+}
+
+bool SignalKernel::usingAVX2() {
+    return kHasAVX2;
+}
+
+SignalKernel::SignalKernel(Span<const double> closes) : n_(0) {
+    rebuild(closes);
+}
+
+void SignalKernel::rebuild(Span<const double> closes) {
+    n_ = closes.size();
+    for (std::vector<double>* prefix : {&close_hi_, &close_lo_, &gain_hi_, &gain_lo_, &loss_hi_, &loss_lo_}) {
+        prefix->assign(n_ + 1, 0.0);
+    }
+    double chi = 0, clo = 0, ghi = 0, glo = 0, lhi = 0, llo = 0;
+    for (size_t k = 0; k < n_; ++k) {
+        accumulate(chi, clo, closes[k]);
+        if (k > 0) {
+            // the change into bar k, split the way Strategy::calculateRSI does
+            double change = closes[k] - closes[k - 1];
+            if (change > 0) {
+                accumulate(ghi, glo, change);
+            } else {
+                accumulate(lhi, llo, std::abs(change));
+            }
+        }
+        close_hi_[k + 1] = chi;
+        close_lo_[k + 1] = clo;
+        gain_hi_[k + 1] = ghi;
+        gain_lo_[k + 1] = glo;
+        loss_hi_[k + 1] = lhi;
+        loss_lo_[k + 1] = llo;
+    }
+}
+
+void SignalKernel::computeSMA(int period, size_t begin, size_t end, double* out) const {
+    end = std::min(end, n_);
+    if (begin >= end) return;
+    // bars without `period` bars of history read 0, like calculateSMA
+    size_t first_valid = period > 0 ? static_cast<size_t>(period) - 1 : end;
+    size_t i = begin;
+    for (; i < end && i < first_valid; ++i) {
+        out[i - begin] = 0.0;
+    }
+    if (i < end) {
+        smaRange(close_hi_.data(), close_lo_.data(), period, i, end, out + (i - begin));
+    }
+}
+
+void SignalKernel::computeRSI(int period, size_t begin, size_t end, double* out) const {
+    end = std::min(end, n_);
+    if (begin >= end) return;
+    // bars with fewer than `period` changes behind them are neutral
+    size_t first_valid = period > 0 ? static_cast<size_t>(period) : end;
+    size_t i = begin;
+    for (; i < end && i < first_valid; ++i) {
+        out[i - begin] = 50.0;
+    }
+    if (i < end) {
+        rsiRange(gain_hi_.data(), gain_lo_.data(), loss_hi_.data(), loss_lo_.data(),
+                 period, i, end, out + (i - begin));
+    }
+}
+
+void SignalKernel::computeSignals(const SignalParams& params, size_t begin, size_t end, int8_t* out) const {
+    end = std::min(end, n_);
+    if (begin >= end) return;
+    size_t first = std::max<size_t>(begin, static_cast<size_t>(std::max(params.long_period, 1)));
+    std::fill(out, out + (std::min(first, end) - begin), kSignalHold);
+
+    // Indicators for a block plus the bar before it (for the crossover test)
+    double short_ma[kBlock + 1];
+    double long_ma[kBlock + 1];
+    double rsi[kBlock];
+    for (size_t block = first; block < end; block += kBlock) {
+        size_t block_end = std::min(block + kBlock, end);
+        size_t len = block_end - block;
+        computeSMA(params.short_period, block - 1, block_end, short_ma);
+        computeSMA(params.long_period, block - 1, block_end, long_ma);
+        computeRSI(params.rsi_period, block, block_end, rsi);
+        int8_t* dst = out + (block - begin);
+        // Branch-free so the compiler can vectorise the comparisons
+        for (size_t k = 0; k < len; ++k) {
+            double prev_s = short_ma[k], prev_l = long_ma[k];
+            double s = short_ma[k + 1], l = long_ma[k + 1];
+            bool buy = (prev_s <= prev_l) & (s > l) & (rsi[k] < params.rsi_upper);
+            bool sell = (prev_s >= prev_l) & (s < l) & (rsi[k] > params.rsi_lower);
+            dst[k] = static_cast<int8_t>(buy ? kSignalBuy : (sell ? kSignalSell : kSignalHold));
+        }
+    }
+}
+}
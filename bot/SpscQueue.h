@@ -0,0 +1,108 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#define TRADINGBOT_CPU_RELAX() _mm_pause()
+#else
+#define TRADINGBOT_CPU_RELAX() ((void)0)
+#endif
+
+namespace TradingBot {
+
+// Bounded lock-free single-producer/single-consumer ring buffer.
+//
+// Exactly one thread may call tryPush and exactly one (other) thread may call
+// tryPop. Head and tail live on separate cache lines, and each side keeps a
+// cached copy of the other side's index so the shared line is only re-read
+// when the ring looks full (producer) or empty (consumer). T should be a
+// trivially copyable record; slots are copied in and out.
+template <typename T>
+class SpscQueue {
+    static_assert(std::is_trivially_copyable<T>::value, "SpscQueue holds POD records");
+public:
+    explicit SpscQueue(size_t capacity)
+        : slots_(roundUp(capacity < 2 ? 2 : capacity)), mask_(slots_.size() - 1),
+          head_(0), cached_tail_(0), tail_(0), cached_head_(0) {}
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer side; false when the ring is full
+    bool tryPush(const T& item) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head - cached_tail_ > mask_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head - cached_tail_ > mask_) return false;
+        }
+        slots_[head & mask_] = item;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+    // Consumer side; false when the ring is empty
+    bool tryPop(T& item) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == cached_head_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail == cached_head_) return false;
+        }
+        item = slots_[tail & mask_];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    size_t capacity() const { return slots_.size(); }
+    size_t sizeApprox() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+private:
+    static size_t roundUp(size_t n) {
+        size_t p = 1;
+        while (p < n) p <<= 1;
+        return p;
+    }
+    std::vector<T> slots_;
+    const size_t mask_;
+    // producer-owned line
+    alignas(64) std::atomic<size_t> head_;
+    size_t cached_tail_;
+    // consumer-owned line
+    alignas(64) std::atomic<size_t> tail_;
+    size_t cached_head_;
+    char pad_[64 - sizeof(size_t) * 2];
+};
+
+// Waiting strategy for an empty/full ring: spin briefly (lowest latency when
+// the other stage is about to deliver), then yield, then nap so a slow feed
+// does not keep a core busy
+class Backoff {
+public:
+    Backoff() : spins_(0) {}
+    void pause() {
+        if (spins_ < 256) {
+            TRADINGBOT_CPU_RELAX();
+        } else if (spins_ < 512) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+        spins_++;
+    }
+    void reset() { spins_ = 0; }
+private:
+    unsigned spins_;
+};
+
+template <typename T>
+void pushBlocking(SpscQueue<T>& queue, const T& item) {
+    Backoff backoff;
+    while (!queue.tryPush(item)) backoff.pause();
+}
+}
+
+#endif
@@ -4,31 +4,42 @@
 #include <iostream>
 
 namespace TradingBot {
-Strategy::Strategy(int short_period, int long_period)
-    : short_period_(short_period), long_period_(long_period), previous_signal_(Signal::HOLD) {}
-double Strategy::calculateSMA(const std::vector<OHLCV>& data, size_t end_index, int period) {
+Strategy::Strategy(int short_period, int long_period, int rsi_period,
+                   double rsi_upper, double rsi_lower)
+    : short_period_(std::max(short_period, 1)), long_period_(std::max(long_period, 1)),
+      rsi_period_(std::max(rsi_period, 1)),
+      rsi_upper_(rsi_upper), rsi_lower_(rsi_lower), verbose_(true), previous_signal_(Signal::HOLD),
+      rule_(makeMACrossoverRSI(SignalParams(short_period, long_period, rsi_period, rsi_upper, rsi_lower))),
+      fed_data_(nullptr), next_index_(0) {}
+void Strategy::reset() {
+    rule_.reset();
+    fed_data_ = nullptr;
+    next_index_ = 0;
+    previous_signal_ = Signal::HOLD;
+}
+double Strategy::calculateSMA(Span<const double> closes, size_t end_index, int period) {
 
     // Simple Moving Average calculation
-    if (end_index + 1 < static_cast<size_t>(period) || data.empty()) {
+    if (end_index + 1 < static_cast<size_t>(period) || closes.empty()) {
         return 0.0;
     }    
     double sum = 0.0;
     for (int i = 0; i < period; ++i) {
-        sum += data[end_index - i].close;
+        sum += closes[end_index - i];
     }    
     return sum / period;
 }
 
-double Strategy::calculateRSI(const std::vector<OHLCV>& data, size_t end_index, int period) {
+double Strategy::calculateRSI(Span<const double> closes, size_t end_index, int period) {
 
     // RSI (Relative Strength Index) calculation
-    if (end_index < static_cast<size_t>(period) || data.empty()) {
+    if (end_index < static_cast<size_t>(period) || closes.empty()) {
         return 50.0;  // Neutral RSI
     }    
     double gains = 0.0;
     double losses = 0.0;    
     for (int i = 1; i <= period; ++i) {
-        double change = data[end_index - i + 1].close - data[end_index - i].close;
+        double change = closes[end_index - i + 1] - closes[end_index - i];
         if (change > 0) {
             gains += change;
         } else {
@@ -44,32 +55,45 @@ double Strategy::calculateRSI(const std::vector<OHLCV>& data, size_t end_index,
     return rsi;
 }
 
-Signal Strategy::generateSignal(const std::vector<OHLCV>& data, size_t current_index) {
-    if (current_index < static_cast<size_t>(long_period_)) {
-        return Signal::HOLD;
-    }
-    
-    // Calculate moving averages
-    double short_ma = calculateSMA(data, current_index, short_period_);
-    double long_ma = calculateSMA(data, current_index, long_period_);
-    
-    // Calculate previous moving averages to detect crossover
-    double prev_short_ma = calculateSMA(data, current_index - 1, short_period_);
-    double prev_long_ma = calculateSMA(data, current_index - 1, long_period_);
-    
-    double rsi = calculateRSI(data, current_index, 14);  
-    Signal signal = Signal::HOLD;
-    if (prev_short_ma <= prev_long_ma && short_ma > long_ma && rsi < 70) {  
-        signal = Signal::BUY;  //Golden cross
-    }
-    else if (prev_short_ma >= prev_long_ma && short_ma < long_ma && rsi > 30) {  
-        signal = Signal::SELL;  //death cross
+Signal Strategy::onBar(double close) {
+    return advance(close, true);
+}
+
+void Strategy::warmUp(Span<const double> closes, size_t begin_index) {
+    for (size_t i = begin_index; i < closes.size(); ++i) {
+        advance(closes[i], false);
     }
-    if (signal != Signal::HOLD) {
-        std::cout << "Signal detected: Short MA=" << short_ma 
-                  << ", Long MA=" << long_ma << ", RSI=" << rsi << std::endl;
+}
+
+Signal Strategy::advance(double close, bool report) {
+    // HOLD for the first long_period bars, the batch path's warm-up
+    Signal signal = rule_.onBar(close);
+    if (report && verbose_ && signal != Signal::HOLD) {
+        std::cout << "Signal detected: Short MA=" << rule_.rule().fast().value()
+                  << ", Long MA=" << rule_.rule().slow().value() << ", RSI=" << rule_.filter().value() << std::endl;
     }    
     previous_signal_ = signal;
     return signal;
 }
+
+Signal Strategy::generateSignal(Span<const double> closes, size_t current_index) {
+    // Sequential calls are O(1). A jump (or a different series) replays only
+    // the bars the indicators need to warm up, so random access still works.
+    size_t warmup = static_cast<size_t>(std::max({short_period_, long_period_, rsi_period_ + 1})) + 1;
+    if (fed_data_ != closes.data() || current_index < next_index_ ||
+        current_index - next_index_ >= warmup) {
+        reset();
+        fed_data_ = closes.data();
+        next_index_ = current_index + 1 > warmup ? current_index + 1 - warmup : 0;
+        // bars before the replay window count towards the warm-up
+        rule_.rule().skip(next_index_);
+    }
+    Signal signal = Signal::HOLD;
+    while (next_index_ <= current_index) {
+        // only the requested bar reports; replayed bars are silent
+        signal = advance(closes[next_index_], next_index_ == current_index);
+        next_index_++;
+    }
+    return signal;
+}
 } 
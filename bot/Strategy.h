@@ -3,20 +3,41 @@
 
 #include <vector>
 #include "Types.h"
+#include "Indicators.h"
+#include "BarSeries.h"
+#include "StrategyTemplates.h"
 
 namespace TradingBot {
 
+// MA crossover filtered by RSI with the periods and thresholds given at run
+// time (config.txt): the RuntimeMACrossoverRSI composition from
+// StrategyTemplates.h plus signal reporting and random access by index.
+// Fixed parameters can use MACrossoverRSI<...> for a fully inlined path.
 class Strategy {
 public:
-    Strategy(int short_period, int long_period);
-    Signal generateSignal(const std::vector<OHLCV>& data, size_t current_index); // Generate trading signal
-    double calculateSMA(const std::vector<OHLCV>& data, size_t end_index, int period); //calculate SMA
-    double calculateRSI(const std::vector<OHLCV>& data, size_t end_index, int period = 14); // calculate RSI   
+    Strategy(int short_period, int long_period, int rsi_period = 14,
+             double rsi_upper = 70.0, double rsi_lower = 30.0);
+    void setVerbose(bool verbose) { verbose_ = verbose; } // print detected signals
+    Signal onBar(double close); // Feed the next bar and get its signal, O(1)
+    void warmUp(Span<const double> closes, size_t begin_index = 0); // Feed history without reporting signals
+    Signal generateSignal(Span<const double> closes, size_t current_index); // Generate trading signal
+    double calculateSMA(Span<const double> closes, size_t end_index, int period); //calculate SMA
+    double calculateRSI(Span<const double> closes, size_t end_index, int period = 14); // calculate RSI   
+    void reset(); // Drop all indicator state
 private:
     int short_period_;  // Short-term MA period
     int long_period_;   // Long-term MA period
+    int rsi_period_;
+    double rsi_upper_;  // BUY only while RSI is below this
+    double rsi_lower_;  // SELL only while RSI is above this
+    bool verbose_;
     
     Signal previous_signal_;  // Track previous signal to avoid rapid switching
+
+    RuntimeMACrossoverRSI rule_;          // streaming indicator state
+    const double* fed_data_;              // series generateSignal() is following
+    size_t next_index_;                   // next index of that series to feed
+    Signal advance(double close, bool report);
 };
 } 
 
@@ -0,0 +1,266 @@
+#ifndef STRATEGY_TEMPLATES_H
+#define STRATEGY_TEMPLATES_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include "Types.h"
+#include "Indicators.h"
+#include "BarSeries.h"
+#include "SignalKernel.h"
+
+namespace TradingBot {
+
+// Strategies composed from template parameters, e.g.
+//
+//   Filtered<Crossover<SMA<10>, SMA<50>>, RSIBand<14, 30, 70>>
+//
+// Every piece is a concrete class with non-virtual update()/value() calls,
+// so with compile-time periods the whole per-bar signal path inlines into
+// the caller's loop: fixed-size windows, constant divisors, no dispatch.
+// The same rule templates also take the runtime indicators from
+// Indicators.h (Crossover<RollingSMA, RollingSMA> with an RSIFilter), which
+// is how Strategy runs the periods and thresholds read from config.txt.
+// Both paths perform the same floating-point operations in the same order
+// and produce identical signals.
+
+// Last N values; the compile-time counterpart of RingBuffer
+template <int N>
+class FixedWindow {
+    static_assert(N > 0, "window length must be positive");
+public:
+    FixedWindow() { clear(); }
+    void push(double value) {
+        buffer_[head_] = value;
+        head_ = head_ + 1 == N ? 0 : head_ + 1;
+        if (size_ < N) size_++;
+    }
+    double oldest() const { return full() ? buffer_[head_] : 0.0; }
+    bool full() const { return size_ == N; }
+    // Sum newest-first, the order RingBuffer-based resyncs use: back from
+    // the write position, then back from the end of the array
+    double sum() const {
+        double total = 0.0;
+        for (int i = head_ - 1; i >= 0; --i) total += buffer_[i];
+        if (size_ == N) {
+            for (int i = N - 1; i >= head_; --i) total += buffer_[i];
+        }
+        return total;
+    }
+    void clear() {
+        for (int i = 0; i < N; ++i) buffer_[i] = 0.0;
+        head_ = 0;
+        size_ = 0;
+    }
+private:
+    double buffer_[N];
+    int head_;
+    int size_;
+};
+
+// RollingSMA with the period fixed at compile time
+template <int Period>
+class SMA {
+public:
+    SMA() : sum_(0.0), since_resync_(0) {}
+    void update(double value) {
+        if (window_.full()) sum_ -= window_.oldest();
+        window_.push(value);
+        sum_ += value;
+        if (++since_resync_ >= Period) {
+            sum_ = window_.sum();
+            since_resync_ = 0;
+        }
+    }
+    double value() const { return window_.full() ? sum_ / Period : 0.0; }
+    bool isReady() const { return window_.full(); }
+    int period() const { return Period; }
+    void reset() {
+        window_.clear();
+        sum_ = 0.0;
+        since_resync_ = 0;
+    }
+private:
+    FixedWindow<Period> window_;
+    double sum_;
+    int since_resync_;
+};
+
+// RollingRSI with the period fixed at compile time
+template <int Period>
+class RSI {
+public:
+    RSI() : gain_sum_(0.0), loss_sum_(0.0), last_close_(0.0), has_last_(false), since_resync_(0) {}
+    void update(double close) {
+        if (!has_last_) {
+            last_close_ = close;
+            has_last_ = true;
+            return;
+        }
+        double change = close - last_close_;
+        last_close_ = close;
+        double gain = change > 0 ? change : 0.0;
+        double loss = change > 0 ? 0.0 : std::abs(change);
+        if (gains_.full()) {
+            gain_sum_ -= gains_.oldest();
+            loss_sum_ -= losses_.oldest();
+        }
+        gains_.push(gain);
+        losses_.push(loss);
+        gain_sum_ += gain;
+        loss_sum_ += loss;
+        if (++since_resync_ >= Period) {
+            gain_sum_ = gains_.sum();
+            loss_sum_ = losses_.sum();
+            since_resync_ = 0;
+        }
+    }
+    double value() const {
+        if (!gains_.full()) return 50.0;
+        double avg_gain = gain_sum_ / Period;
+        double avg_loss = loss_sum_ / Period;
+        if (avg_loss <= 0) return 100.0;
+        return 100.0 - (100.0 / (1.0 + avg_gain / avg_loss));
+    }
+    bool isReady() const { return gains_.full(); }
+    int period() const { return Period; }
+    void reset() {
+        gains_.clear();
+        losses_.clear();
+        gain_sum_ = 0.0;
+        loss_sum_ = 0.0;
+        has_last_ = false;
+        since_resync_ = 0;
+    }
+private:
+    FixedWindow<Period> gains_;
+    FixedWindow<Period> losses_;
+    double gain_sum_;
+    double loss_sum_;
+    double last_close_;
+    bool has_last_;
+    int since_resync_;
+};
+
+// BUY when Fast crosses above Slow, SELL when it crosses below. HOLD for
+// the first Slow::period() bars, like the batch SignalKernel.
+template <typename Fast, typename Slow>
+class Crossover {
+public:
+    Crossover(const Fast& fast = Fast(), const Slow& slow = Slow())
+        : fast_(fast), slow_(slow), prev_fast_(0.0), prev_slow_(0.0), bars_seen_(0) {}
+    Signal update(double close) {
+        prev_fast_ = fast_.value();
+        prev_slow_ = slow_.value();
+        fast_.update(close);
+        slow_.update(close);
+        bars_seen_++;
+        if (bars_seen_ <= static_cast<size_t>(slow_.period())) return Signal::HOLD;
+        double fast = fast_.value();
+        double slow = slow_.value();
+        if (prev_fast_ <= prev_slow_ && fast > slow) return Signal::BUY;   // golden cross
+        if (prev_fast_ >= prev_slow_ && fast < slow) return Signal::SELL;  // death cross
+        return Signal::HOLD;
+    }
+    const Fast& fast() const { return fast_; }
+    const Slow& slow() const { return slow_; }
+    void reset() {
+        fast_.reset();
+        slow_.reset();
+        prev_fast_ = 0.0;
+        prev_slow_ = 0.0;
+        bars_seen_ = 0;
+    }
+    // Counts bars skipped before a replay window towards the warm-up
+    void skip(size_t bars) { bars_seen_ += bars; }
+private:
+    Fast fast_;
+    Slow slow_;
+    double prev_fast_;
+    double prev_slow_;
+    size_t bars_seen_;
+};
+
+// Lets a BUY through only while RSI < Upper and a SELL only while RSI > Lower
+template <int Period, int Lower, int Upper>
+class RSIBand {
+    static_assert(Lower < Upper, "RSI band needs lower < upper");
+public:
+    void update(double close) { rsi_.update(close); }
+    bool allowsBuy() const { return rsi_.value() < Upper; }
+    bool allowsSell() const { return rsi_.value() > Lower; }
+    double value() const { return rsi_.value(); }
+    int period() const { return Period; }
+    void reset() { rsi_.reset(); }
+private:
+    RSI<Period> rsi_;
+};
+
+// RSIBand with period and thresholds chosen at run time
+class RSIFilter {
+public:
+    RSIFilter(int period = 14, double lower = 30.0, double upper = 70.0)
+        : rsi_(period), lower_(lower), upper_(upper) {}
+    void update(double close) { rsi_.update(close); }
+    bool allowsBuy() const { return rsi_.value() < upper_; }
+    bool allowsSell() const { return rsi_.value() > lower_; }
+    double value() const { return rsi_.value(); }
+    int period() const { return rsi_.period(); }
+    void reset() { rsi_.reset(); }
+private:
+    RollingRSI rsi_;
+    double lower_;
+    double upper_;
+};
+
+// A rule whose BUY/SELL verdicts pass through a filter updated on the same bars
+template <typename Rule, typename Filter>
+class Filtered {
+public:
+    Filtered(const Rule& rule = Rule(), const Filter& filter = Filter()) : rule_(rule), filter_(filter) {}
+    Signal onBar(double close) {
+        Signal signal = rule_.update(close);
+        filter_.update(close);
+        if (signal == Signal::BUY && !filter_.allowsBuy()) return Signal::HOLD;
+        if (signal == Signal::SELL && !filter_.allowsSell()) return Signal::HOLD;
+        return signal;
+    }
+    Rule& rule() { return rule_; }
+    const Rule& rule() const { return rule_; }
+    const Filter& filter() const { return filter_; }
+    void reset() {
+        rule_.reset();
+        filter_.reset();
+    }
+private:
+    Rule rule_;
+    Filter filter_;
+};
+
+// The crossover + RSI rule with compile-time parameters
+template <int ShortPeriod, int LongPeriod, int RSIPeriod = 14, int RSILower = 30, int RSIUpper = 70>
+using MACrossoverRSI = Filtered<Crossover<SMA<ShortPeriod>, SMA<LongPeriod>>, RSIBand<RSIPeriod, RSILower, RSIUpper>>;
+// ... and with run-time parameters
+typedef Filtered<Crossover<RollingSMA, RollingSMA>, RSIFilter> RuntimeMACrossoverRSI;
+
+inline RuntimeMACrossoverRSI makeMACrossoverRSI(const SignalParams& params) {
+    return RuntimeMACrossoverRSI(Crossover<RollingSMA, RollingSMA>(RollingSMA(params.short_period),
+                                                                   RollingSMA(params.long_period)),
+                                 RSIFilter(params.rsi_period, params.rsi_lower, params.rsi_upper));
+}
+
+// Runs `strategy` over closes[0, end) and writes the signal codes of bars
+// [begin, end) to out[0, end - begin) (kSignalHold/Buy/Sell, the layout of
+// SignalKernel::computeSignals). Instantiated per strategy type, so the
+// loop is specialised for it.
+template <typename S>
+void generateSignals(S& strategy, Span<const double> closes, size_t begin, size_t end, int8_t* out) {
+    for (size_t i = 0; i < begin && i < end; ++i) strategy.onBar(closes[i]);
+    for (size_t i = begin; i < end; ++i) {
+        Signal signal = strategy.onBar(closes[i]);
+        out[i - begin] = signal == Signal::BUY ? kSignalBuy : signal == Signal::SELL ? kSignalSell : kSignalHold;
+    }
+}
+}
+
+#endif
@@ -0,0 +1,18 @@
+#include "SymbolTable.h"
+
+namespace TradingBot {
+
+SymbolId SymbolTable::intern(const std::string& name) {
+    auto it = ids_.find(name);
+    if (it != ids_.end()) return it->second;
+    SymbolId id = static_cast<SymbolId>(names_.size());
+    names_.push_back(name);
+    ids_.emplace(name, id);
+    return id;
+}
+
+SymbolId SymbolTable::find(const std::string& name) const {
+    auto it = ids_.find(name);
+    return it != ids_.end() ? it->second : kInvalidSymbol;
+}
+}
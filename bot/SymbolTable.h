@@ -0,0 +1,30 @@
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace TradingBot {
+
+// Dense integer handle for a symbol; ids are assigned 0, 1, 2, ... in
+// first-seen order so they can index plain arrays
+typedef uint32_t SymbolId;
+const SymbolId kInvalidSymbol = 0xFFFFFFFFu;
+
+// Interns symbol names once (at load/setup time) so hot paths can work
+// with ids instead of hashing and comparing strings
+class SymbolTable {
+public:
+    SymbolId intern(const std::string& name);      // existing id, or the next one
+    SymbolId find(const std::string& name) const;  // kInvalidSymbol if never interned
+    const std::string& name(SymbolId id) const { return names_[id]; }
+    size_t size() const { return names_.size(); }
+private:
+    std::vector<std::string> names_;
+    std::unordered_map<std::string, SymbolId> ids_;
+};
+}
+
+#endif
@@ -0,0 +1,122 @@
+#include "ThreadPool.h"
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace TradingBot {
+
+namespace {
+// Which pool/worker the current thread belongs to, for local submits
+thread_local const void* tls_pool = nullptr;
+thread_local size_t tls_worker = 0;
+}
+
+size_t ThreadPool::defaultThreadCount() {
+    unsigned int n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
+
+bool pinCurrentThread(size_t cpu) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(static_cast<int>(cpu % CPU_SETSIZE), &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+size_t ThreadPool::workerIndex() const {
+    return tls_pool == this ? tls_worker : workers_.size();
+}
+ThreadPool::ThreadPool(size_t threads)
+    : next_queue_(0), queued_(0), pending_(0), stopping_(false) {
+    if (threads == 0) threads = defaultThreadCount();
+    for (size_t i = 0; i < threads; ++i) {
+        queues_.push_back(std::unique_ptr<WorkQueue>(new WorkQueue()));
+    }
+    workers_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        workers_.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        stopping_ = true;
+    }
+    work_available_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+void ThreadPool::submit(std::function<void()> task) {
+    size_t target = (tls_pool == this) ? tls_worker
+                                       : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+    pending_.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(queues_[target]->mutex);
+        queued_.fetch_add(1);
+        queues_[target]->tasks.push_back(std::move(task));
+    }
+    // Taking the state lock orders this wake-up after a sleeper's predicate check
+    { std::lock_guard<std::mutex> lock(state_mutex_); }
+    work_available_.notify_one();
+}
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(state_mutex_);
+    all_done_.wait(lock, [this]() { return pending_.load() == 0; });
+    if (first_error_) {
+        std::exception_ptr error = first_error_;
+        first_error_ = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+bool ThreadPool::popOrSteal(size_t index, std::function<void()>& task) {
+    {
+        WorkQueue& own = *queues_[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    for (size_t k = 1; k < queues_.size(); ++k) {
+        WorkQueue& victim = *queues_[(index + k) % queues_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+void ThreadPool::workerLoop(size_t index) {
+    tls_pool = this;
+    tls_worker = index;
+    for (;;) {
+        std::function<void()> task;
+        if (!popOrSteal(index, task)) {
+            std::unique_lock<std::mutex> lock(state_mutex_);
+            work_available_.wait(lock, [this]() { return stopping_ || queued_.load() > 0; });
+            if (stopping_ && queued_.load() == 0) return;
+            continue;
+        }
+        queued_.fetch_sub(1);
+        try {
+            task();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            if (!first_error_) first_error_ = std::current_exception();
+        }
+        if (pending_.fetch_sub(1) == 1) {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            all_done_.notify_all();
+        }
+    }
+}
+}
@@ -0,0 +1,67 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace TradingBot {
+
+// Work-stealing worker pool. Every worker owns a deque: it pops its own work
+// LIFO (cache-warm) and, when empty, steals FIFO from the other workers.
+// Tasks submitted from outside are dealt round-robin across the deques;
+// tasks submitted from a worker go onto that worker's own deque.
+// wait() blocks until every submitted task has finished and rethrows the
+// first exception a task threw.
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threads = 0);  // 0 = one per hardware thread
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(std::function<void()> task);
+    void wait();
+    size_t size() const { return workers_.size(); }
+    size_t workerIndex() const;  // calling worker's index, or size() if it isn't one of ours
+    static size_t defaultThreadCount();
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<size_t> next_queue_;   // round-robin target for external submits
+    std::atomic<size_t> queued_;       // tasks sitting in some deque
+    std::atomic<size_t> pending_;      // queued + running
+    std::mutex state_mutex_;           // guards sleeping/waking and first_error_
+    std::condition_variable work_available_;
+    std::condition_variable all_done_;
+    bool stopping_;
+    std::exception_ptr first_error_;
+    void workerLoop(size_t index);
+    bool popOrSteal(size_t index, std::function<void()>& task);
+};
+
+// Keeps the calling thread on one CPU (Linux); false where unsupported or refused
+bool pinCurrentThread(size_t cpu);
+
+// Run body(i) for i in [0, count) on the pool and wait for all of them
+template <typename Body>
+void parallelFor(ThreadPool& pool, size_t count, Body body) {
+    for (size_t i = 0; i < count; ++i) {
+        pool.submit([&body, i]() { body(i); });
+    }
+    pool.wait();
+}
+}
+
+#endif
@@ -0,0 +1,210 @@
+#include "TradeJournal.h"
+#include "BarSeries.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace TradingBot {
+
+static const char kJournalMagic[8] = {'T', 'B', 'J', 'R', 'N', 'L', 0, 0};
+static_assert(sizeof(JournalHeader) == 64, "journal header must stay 64 bytes");
+static_assert(sizeof(JournalRecord) == 40, "journal records must stay 40 bytes");
+static const size_t kLegacyRecordSize = 32;   // versions 1 and 2
+static const size_t kBufferedRecords = 2048;  // 80 KB per write
+
+TradeJournal::TradeJournal() : buffer_(kBufferedRecords), buffered_(0), last_symbol_id_(0) {}
+TradeJournal::~TradeJournal() {
+    close();
+}
+
+bool TradeJournal::open(const std::string& filename) {
+    close();
+    symbol_ids_.clear();
+    last_symbol_.clear();
+    file_.open(filename, std::ios::binary | std::ios::trunc);
+    if (!file_.is_open()) return false;
+    JournalHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kJournalMagic, sizeof(kJournalMagic));
+    header.version = kVersion;
+    header.header_size = sizeof(JournalHeader);
+    header.record_size = sizeof(JournalRecord);
+    file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    return static_cast<bool>(file_);
+}
+
+bool TradeJournal::internSymbol(const std::string& symbol, uint16_t& id) {
+    if (!last_symbol_.empty() && symbol == last_symbol_) {
+        id = last_symbol_id_;
+        return true;
+    }
+    auto it = symbol_ids_.find(symbol);
+    if (it != symbol_ids_.end()) {
+        last_symbol_ = symbol;
+        last_symbol_id_ = it->second;
+        id = it->second;
+        return true;
+    }
+    if (symbol_ids_.size() >= kMaxSymbols) return false;
+    id = static_cast<uint16_t>(symbol_ids_.size());
+    symbol_ids_.emplace(symbol, id);
+    last_symbol_ = symbol;
+    last_symbol_id_ = id;
+    pushText(kJournalSymbol, id, symbol);
+    return true;
+}
+
+void TradeJournal::pushText(uint8_t kind, uint16_t symbol, const std::string& text) {
+    JournalRecord record;
+    size_t offset = 0;
+    do {
+        std::memset(&record, 0, sizeof(record));
+        record.symbol = symbol;
+        record.kind = kind;
+        record.quantity = static_cast<int32_t>(offset);
+        size_t n = std::min(text.size() - offset, sizeof(record.text));
+        std::memcpy(record.text, text.data() + offset, n);
+        push(record);
+        offset += n;
+    } while (offset < text.size());
+}
+
+void TradeJournal::append(uint16_t symbol, Signal signal, int quantity, double price, double fees,
+                          double balance_after, int64_t timestamp, uint8_t flags) {
+    JournalRecord record;
+    record.symbol = symbol;
+    record.kind = signal == Signal::BUY ? kJournalBuy : kJournalSell;
+    record.flags = flags;
+    record.quantity = quantity;
+    record.fill.timestamp = timestamp;
+    record.fill.price = price;
+    record.fill.balance_after = balance_after;
+    record.fill.fees = fees;
+    push(record);
+}
+
+bool TradeJournal::append(const Trade& trade) {
+    uint16_t symbol;
+    if (!internSymbol(trade.symbol, symbol)) return false;
+    int64_t timestamp = 0;
+    uint8_t flags = 0;
+    // Epoch seconds only when formatting them gives the same text back
+    // (not for fractions of a second, a "T" separator, "Live-007", ...)
+    if (parseTimestamp(trade.timestamp, timestamp)) {
+        formatTimestamp(timestamp, formatted_);
+    } else if (trade.timestamp.compare(0, 5, "Live-") == 0) {
+        // live sessions stamp bars "Live-<n>"
+        timestamp = std::strtoll(trade.timestamp.c_str() + 5, nullptr, 10);
+        flags = kJournalSequenceTime;
+        formatted_.assign("Live-");
+        formatted_.append(std::to_string(timestamp));
+    } else {
+        formatted_.clear();
+    }
+    if (formatted_.empty() || formatted_ != trade.timestamp) {
+        timestamp = 0;
+        flags = kJournalTextTime;
+        if (!trade.timestamp.empty()) pushText(kJournalTimeText, symbol, trade.timestamp);
+    }
+    append(symbol, trade.signal, trade.quantity, trade.price, trade.fees, trade.balance_after, timestamp, flags);
+    return true;
+}
+
+void TradeJournal::flush() {
+    if (!file_.is_open()) return;
+    if (buffered_ > 0) {
+        file_.write(reinterpret_cast<const char*>(buffer_.data()),
+                    static_cast<std::streamsize>(buffered_ * sizeof(JournalRecord)));
+        buffered_ = 0;
+    }
+    file_.flush();
+}
+
+void TradeJournal::close() {
+    if (!file_.is_open()) return;
+    flush();
+    file_.close();
+}
+
+bool TradeJournalReader::open(const std::string& filename) {
+    records_ = nullptr;
+    count_ = 0;
+    converted_.clear();
+    symbols_.clear();
+    text_times_.clear();
+    if (!file_.open(filename) || file_.size() < sizeof(JournalHeader)) return false;
+    JournalHeader header;
+    std::memcpy(&header, file_.data(), sizeof(header));
+    // Versions 1 and 2 had 32-byte records without fees (version 1 also
+    // had no text timestamps and names under 24 characters)
+    bool legacy = header.version < 3;
+    size_t record_size = legacy ? kLegacyRecordSize : sizeof(JournalRecord);
+    if (std::memcmp(header.magic, kJournalMagic, sizeof(kJournalMagic)) != 0 || header.version < 1 ||
+        header.version > TradeJournal::kVersion ||
+        header.header_size != sizeof(JournalHeader) || header.record_size != record_size) {
+        return false;
+    }
+    count_ = (file_.size() - sizeof(JournalHeader)) / record_size;
+    if (legacy) {
+        // Same fields at the same offsets, just 8 bytes shorter: copied over zeroed fees
+        converted_.resize(count_);
+        for (size_t i = 0; i < count_; ++i) {
+            std::memset(&converted_[i], 0, sizeof(JournalRecord));
+            std::memcpy(&converted_[i], file_.data() + sizeof(JournalHeader) + i * record_size, record_size);
+        }
+        records_ = converted_.data();
+    } else {
+        // The header is 64 bytes and mappings are page aligned, so records are aligned
+        records_ = reinterpret_cast<const JournalRecord*>(file_.data() + sizeof(JournalHeader));
+    }
+    std::string time_text;
+    for (size_t i = 0; i < count_; ++i) {
+        const JournalRecord& record = records_[i];
+        size_t offset = static_cast<size_t>(std::max(record.quantity, 0));
+        size_t length = strnlen(record.text, sizeof(record.text));
+        if (record.kind == kJournalSymbol) {
+            uint16_t id = record.symbol;
+            if (id >= symbols_.size()) symbols_.resize(id + 1);
+            symbols_[id].resize(std::min(offset, symbols_[id].size()));
+            symbols_[id].append(record.text, length);
+        } else if (record.kind == kJournalTimeText) {
+            time_text.resize(std::min(offset, time_text.size()));
+            time_text.append(record.text, length);
+        } else if (!time_text.empty()) {
+            if (record.flags & kJournalTextTime) text_times_[i] = time_text;
+            time_text.clear();
+        }
+    }
+    return true;
+}
+
+bool TradeJournalReader::isFill(size_t index) const {
+    return records_[index].kind == kJournalBuy || records_[index].kind == kJournalSell;
+}
+
+const std::string& TradeJournalReader::symbolName(uint16_t id) const {
+    static const std::string unknown = "?";
+    return id < symbols_.size() ? symbols_[id] : unknown;
+}
+
+Trade TradeJournalReader::tradeAt(size_t index) const {
+    const JournalRecord& record = records_[index];
+    Trade trade;
+    if (record.flags & kJournalSequenceTime) {
+        trade.timestamp = "Live-" + std::to_string(record.fill.timestamp);
+    } else if (record.flags & kJournalTextTime) {
+        auto it = text_times_.find(index);
+        if (it != text_times_.end()) trade.timestamp = it->second;
+    } else {
+        trade.timestamp = formatTimestamp(record.fill.timestamp);
+    }
+    trade.symbol = symbolName(record.symbol);
+    trade.signal = record.kind == kJournalBuy ? Signal::BUY : Signal::SELL;
+    trade.price = record.fill.price;
+    trade.quantity = record.quantity;
+    trade.value = record.value();
+    trade.balance_after = record.fill.balance_after;
+    trade.fees = record.fill.fees;
+    return trade;
+}
+}
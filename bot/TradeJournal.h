@@ -0,0 +1,114 @@
+#ifndef TRADE_JOURNAL_H
+#define TRADE_JOURNAL_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Types.h"
+#include "MappedFile.h"
+
+namespace TradingBot {
+
+// Append-only binary trade journal (".tbj").
+//
+// Layout, little-endian: a 64-byte header followed by 40-byte records.
+// A symbol is interned to a 16-bit id the first time it trades and
+// kJournalSymbol records carrying its name are written just before that
+// trade, so the file is self-describing and can be read front to back
+// (or mapped and indexed) without a separate symbol table. Names of any
+// length are split into 32-byte pieces, one record each. Timestamps are
+// stored as epoch seconds when that gives back the logged text exactly;
+// any other text goes into kJournalTimeText records right before its fill.
+// A truncated final record, e.g. after a crash, is ignored by the reader.
+struct JournalHeader {
+    char magic[8];          // "TBJRNL\0\0"
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t record_size;
+    uint32_t reserved[11];
+};
+
+const uint8_t kJournalBuy = 1;
+const uint8_t kJournalSell = 2;
+const uint8_t kJournalSymbol = 3;       // a piece of the name of `symbol`
+const uint8_t kJournalTimeText = 4;     // a piece of the timestamp text of the next fill
+const uint8_t kJournalSequenceTime = 1; // flag: timestamp is a live-session bar number ("Live-N")
+const uint8_t kJournalTextTime = 2;     // flag: the timestamp is in the kJournalTimeText records before it
+
+struct JournalFill {
+    int64_t timestamp;      // seconds since the Unix epoch, UTC
+    double price;
+    double balance_after;
+    double fees;            // brokerage + taxes, already out of balance_after
+};
+
+struct JournalRecord {
+    uint16_t symbol;        // interned id
+    uint8_t kind;
+    uint8_t flags;
+    int32_t quantity;           // fills; for text pieces the offset of `text` in the whole string
+    union {
+        JournalFill fill;
+        char text[32];          // kJournalSymbol / kJournalTimeText: NUL-padded when shorter
+    };
+    double value() const { return quantity * fill.price; }  // same product the broker computes
+};
+
+class TradeJournal {
+public:
+    static const uint32_t kVersion = 3;
+    static const size_t kMaxSymbols = 65536;  // ids are 16 bits
+    TradeJournal();
+    ~TradeJournal();
+    TradeJournal(const TradeJournal&) = delete;
+    TradeJournal& operator=(const TradeJournal&) = delete;
+
+    bool open(const std::string& filename);  // truncates
+    bool isOpen() const { return file_.is_open(); }
+    // Writes the definition on first use; false once kMaxSymbols names are taken
+    bool internSymbol(const std::string& symbol, uint16_t& id);
+    // Hot path: one 40-byte copy into the write buffer
+    void append(uint16_t symbol, Signal signal, int quantity, double price, double fees, double balance_after,
+                int64_t timestamp, uint8_t flags = 0);
+    // Interns the symbol and encodes the timestamp; false (nothing written)
+    // when the symbol table is full
+    bool append(const Trade& trade);
+    void flush();
+    void close();                                      // flushes; the file is complete afterwards
+private:
+    std::ofstream file_;
+    std::vector<JournalRecord> buffer_;
+    size_t buffered_;
+    std::unordered_map<std::string, uint16_t> symbol_ids_;
+    std::string last_symbol_;       // skips the hash lookup for runs of one symbol
+    uint16_t last_symbol_id_;
+    std::string formatted_;         // scratch for checking that a timestamp round-trips
+    void pushText(uint8_t kind, uint16_t symbol, const std::string& text);
+    void push(const JournalRecord& record) {
+        buffer_[buffered_++] = record;
+        if (buffered_ == buffer_.size()) flush();
+    }
+};
+
+// Read-only view of a journal through a memory mapping
+class TradeJournalReader {
+public:
+    bool open(const std::string& filename);
+    size_t recordCount() const { return count_; }
+    const JournalRecord& record(size_t index) const { return records_[index]; }
+    bool isFill(size_t index) const;     // BUY/SELL rather than a piece of text
+    const std::string& symbolName(uint16_t id) const;
+    Trade tradeAt(size_t index) const;   // a fill record back in TradeLogger's form
+private:
+    MappedFile file_;
+    std::vector<JournalRecord> converted_;  // versions 1-2 (32-byte records, no fees) in today's layout
+    const JournalRecord* records_ = nullptr;
+    size_t count_ = 0;
+    std::vector<std::string> symbols_;
+    std::unordered_map<size_t, std::string> text_times_;  // by fill index
+};
+}
+
+#endif
@@ -1,28 +1,215 @@
 #include "TradeLogger.h"
+#include "BarSeries.h"
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
 
 namespace TradingBot {
-TradeLogger::TradeLogger(const std::string& log_file) {
+namespace {
+void copyTruncated(char* dst, size_t capacity, const std::string& src) {
+    size_t n = std::min(src.size(), capacity - 1);
+    std::memcpy(dst, src.data(), n);
+    dst[n] = '\0';
+}
+
+void appendRow(std::string& out, const char* timestamp, const char* symbol, Signal signal, double price,
+               int quantity, double value, double fees, double balance_after) {
+    out.append(timestamp).push_back(',');
+    out.append(symbol).push_back(',');
+    out.append(signal == Signal::BUY ? "BUY," : "SELL,");
+    appendFixed2(out, price);
+    out.push_back(',');
+    out.append(std::to_string(quantity)).push_back(',');
+    appendFixed2(out, value);
+    out.push_back(',');
+    appendFixed2(out, fees);
+    out.push_back(',');
+    appendFixed2(out, balance_after);
+    out.push_back('\n');
+}
+}
+
+bool TradeRecord::fits(const Trade& trade) {
+    return trade.timestamp.size() < sizeof(TradeRecord::timestamp) && trade.symbol.size() < sizeof(TradeRecord::symbol);
+}
+TradeRecord TradeRecord::from(const Trade& trade) {
+    TradeRecord record;
+    record.row = nullptr;
+    copyTruncated(record.timestamp, sizeof(record.timestamp), trade.timestamp);
+    copyTruncated(record.symbol, sizeof(record.symbol), trade.symbol);
+    record.signal = trade.signal;
+    record.quantity = trade.quantity;
+    record.price = trade.price;
+    record.value = trade.value;
+    record.fees = trade.fees;
+    record.balance_after = trade.balance_after;
+    return record;
+}
+Trade TradeRecord::toTrade() const {
+    Trade trade;
+    trade.timestamp = timestamp;
+    trade.symbol = symbol;
+    trade.signal = signal;
+    trade.quantity = quantity;
+    trade.price = price;
+    trade.value = value;
+    trade.fees = fees;
+    trade.balance_after = balance_after;
+    return trade;
+}
+
+TradeLogger::TradeLogger(const std::string& log_file, bool async, int flush_interval_ms)
+    : async_(false), flush_interval_ms_(std::max(flush_interval_ms, 0)), stopping_(false), writer_idle_(false) {
+    if (log_file.empty()) return;
+    if (log_file.size() > 4 && log_file.compare(log_file.size() - 4, 4, ".tbj") == 0) {
+        journal_.reset(new TradeJournal());
+        if (journal_->open(log_file)) {
+            std::cout << "Trade journal created: " << log_file << std::endl;
+        } else {
+            std::cerr << "Warning: Could not create trade journal file" << std::endl;
+            journal_.reset();
+        }
+        return;
+    }
     log_file_.open(log_file);
     if (log_file_.is_open()) {
         writeHeader();
         std::cout << "Trade log created: " << log_file << std::endl;
     } else {
         std::cerr << "Warning: Could not create trade log file" << std::endl;
+        return;
+    }
+    if (async) {
+        async_ = true;
+        queue_.reset(new SpscQueue<TradeRecord>(kQueueCapacity));
+        writer_ = std::thread(&TradeLogger::writerLoop, this);
     }
 }
 TradeLogger::~TradeLogger() {
+    close();
+}
+void TradeLogger::close() {
+    if (writer_.joinable()) {
+        stopping_.store(true, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            wake_.notify_one();
+        }
+        writer_.join();
+    }
     if (log_file_.is_open()) {
         log_file_.close();
     }
+    if (journal_) {
+        journal_->close();
+    }
+}
+const char* TradeLogger::csvHeader() {
+    // Balance after a fill = balance before -/+ Value - Fees
+    return "Timestamp,Symbol,Signal,Price,Quantity,Value,Fees,Balance\n";
+}
+void TradeLogger::appendCSVRow(std::string& out, const TradeRecord& record) {
+    appendRow(out, record.timestamp, record.symbol, record.signal, record.price, record.quantity, record.value,
+              record.fees, record.balance_after);
+}
+void TradeLogger::appendCSVRow(std::string& out, const Trade& trade) {
+    appendRow(out, trade.timestamp.c_str(), trade.symbol.c_str(), trade.signal, trade.price, trade.quantity,
+              trade.value, trade.fees, trade.balance_after);
+}
+void TradeLogger::writerLoop() {
+    const size_t kWriteChunk = 64 * 1024;
+    std::string buffer;
+    buffer.reserve(kWriteChunk + 256);
+    auto interval = std::chrono::milliseconds(flush_interval_ms_);
+    auto last_flush = std::chrono::steady_clock::now();
+    bool dirty = false;     // written since the last flush
+    TradeRecord record;
+    for (;;) {
+        // Read the flag first: once it is set, everything queued before it is poppable
+        bool stopping = stopping_.load(std::memory_order_acquire);
+        uint64_t taken = 0;
+        while (queue_->tryPop(record)) {
+            if (record.row) {
+                buffer += *record.row;
+                delete record.row;
+            } else {
+                appendCSVRow(buffer, record);
+            }
+            taken++;
+            dirty = true;
+            if (buffer.size() >= kWriteChunk) {
+                log_file_.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                buffer.clear();
+            }
+        }
+        auto now = std::chrono::steady_clock::now();
+        if (stopping || now - last_flush >= interval) {
+            if (!buffer.empty()) {
+                log_file_.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                buffer.clear();
+            }
+            log_file_.flush();
+            last_flush = now;
+            dirty = false;
+        }
+        if (stopping) break;
+        if (taken == 0) {
+            // Idle: sleep until a trade arrives, close() is called or unflushed data is due
+            std::unique_lock<std::mutex> lock(wake_mutex_);
+            writer_idle_.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);  // pairs with the fence in wakeWriter()
+            if (queue_->sizeApprox() == 0 && !stopping_.load(std::memory_order_acquire)) {
+                if (dirty) {
+                    wake_.wait_until(lock, last_flush + interval);
+                } else {
+                    wake_.wait(lock);
+                }
+            }
+            writer_idle_.store(false, std::memory_order_relaxed);
+        }
+    }
+}
+void TradeLogger::wakeWriter() {
+    // The record is published before the flag is read, and the writer sets
+    // the flag before it last looks at the queue, so one of the two sees
+    // the other; notifying under the mutex cannot fall between the writer's
+    // check and its wait
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (writer_idle_.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        wake_.notify_one();
+    }
 }
 void TradeLogger::writeHeader() {
-    log_file_ << "Timestamp,Symbol,Signal,Price,Quantity,Value,Balance\n";
+    log_file_ << csvHeader();
 }
 void TradeLogger::logTrade(const Trade& trade) {
-    trades_.push_back(trade);
+    performance_.onFill(trade);
+    if (async_) {
+        TradeRecord record = TradeRecord::from(trade);
+        if (!TradeRecord::fits(trade)) {
+            // Rare: format it here rather than cut it, so the file matches the sync path
+            record.row = new std::string();
+            appendCSVRow(*record.row, trade);
+        }
+        while (!queue_->tryPush(record)) {
+            wakeWriter();
+            std::this_thread::yield();  // writer is behind; never drop a trade
+        }
+        wakeWriter();
+        return;
+    }
+    if (journal_) {
+        if (!journal_->append(trade)) {
+            std::cerr << "Error: trade journal is limited to " << TradeJournal::kMaxSymbols
+                      << " symbols; " << trade.symbol << " trade not journaled" << std::endl;
+        }
+        return;
+    }
     
     if (log_file_.is_open()) {
         log_file_ << trade.timestamp << ","
@@ -31,37 +218,13 @@ void TradeLogger::logTrade(const Trade& trade) {
                   << std::fixed << std::setprecision(2) << trade.price << ","
                   << trade.quantity << ","
                   << trade.value << ","
+                  << trade.fees << ","
                   << trade.balance_after << "\n";
         log_file_.flush();  // Ensure data is written immediately
     }
 }
 Statistics TradeLogger::calculateStatistics(double initial_balance, double final_balance) {
-    Statistics stats;    
-    stats.total_trades = static_cast<int>(trades_.size());
-    stats.total_profit_loss = final_balance - initial_balance;
-    
-    // Analyze each trade pair (buy-sell)
-    std::vector<double> profits;    
-    for (size_t i = 1; i < trades_.size(); i += 2) {
-        if (i >= trades_.size()) break;        
-        if (trades_[i-1].signal == Signal::BUY && trades_[i].signal == Signal::SELL) {
-            double profit = trades_[i].value - trades_[i-1].value;
-            profits.push_back(profit);
-            
-            if (profit > 0) {
-                stats.winning_trades++;
-                stats.largest_win = std::max(stats.largest_win, profit);
-            } else {
-                stats.losing_trades++;
-                stats.largest_loss = std::min(stats.largest_loss, profit);
-            }
-        }
-    }    
-    if (stats.total_trades > 0) {
-        stats.win_rate = (static_cast<double>(stats.winning_trades) / 
-                         (stats.winning_trades + stats.losing_trades)) * 100.0;
-    }    
-    return stats;
+    return performance_.snapshot(initial_balance, final_balance);
 }
 void TradeLogger::printSummary(const Statistics& stats) {
     std::cout << "\n" << std::string(60, '=') << "\n";
@@ -75,6 +238,17 @@ void TradeLogger::printSummary(const Statistics& stats) {
     std::cout << "Total P/L:           INR " << stats.total_profit_loss << "\n";
     std::cout << "Largest Win:         INR " << stats.largest_win << "\n";
     std::cout << "Largest Loss:        INR " << stats.largest_loss << "\n";
+    if (stats.gross_loss > 0) {
+        std::cout << "Profit Factor:       " << stats.profit_factor << "\n";
+    } else {
+        std::cout << "Profit Factor:       " << (stats.gross_profit > 0 ? "inf" : "n/a") << "\n";
+    }
+    if (stats.marked_bars > 0) {
+        std::cout << "Max Drawdown:        INR " << stats.max_drawdown << " (" << stats.max_drawdown_pct << "%)\n";
+        std::cout << "Sharpe Ratio:        " << stats.sharpe_ratio << "\n";
+        std::cout << "Sortino Ratio:       " << stats.sortino_ratio << "\n";
+        std::cout << "Exposure:            " << stats.exposure_pct << "%\n";
+    }
     std::cout << std::string(60, '=') << "\n";
 }
 } 
@@ -1,25 +1,79 @@
 #ifndef TRADE_LOGGER_H
 #define TRADE_LOGGER_H
 
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <string>
-#include <vector>
+#include <thread>
 #include <fstream>
 #include "Types.h"
+#include "SpscQueue.h"
+#include "TradeJournal.h"
+#include "PerformanceTracker.h"
 
 namespace TradingBot {
 
+// Fixed-size copy of a Trade for the async queue. A trade whose timestamp
+// or symbol does not fit travels as its finished CSV row instead.
+struct TradeRecord {
+    char timestamp[32];
+    char symbol[24];
+    Signal signal;
+    int quantity;
+    double price;
+    double value;
+    double fees;
+    double balance_after;
+    std::string* row;       // oversized trades: the whole line, formatted by the producer, freed by the writer
+
+    static bool fits(const Trade& trade);
+    static TradeRecord from(const Trade& trade);  // truncates what does not fit
+    Trade toTrade() const;
+};
+
 class TradeLogger {
 public:
-    TradeLogger(const std::string& log_file);
+    // Empty path = keep trades in memory only. A ".tbj" path writes the
+    // binary TradeJournal instead of CSV (buffered appends; async is not
+    // needed and is ignored). In async mode logTrade() only
+    // copies a TradeRecord into a lock-free queue; a writer thread formats
+    // the records and writes them in batches, flushing every
+    // flush_interval_ms (0 = after every batch), and sleeps on a condition
+    // variable while there is nothing to do. Everything logged is on disk
+    // once close() or the destructor returns.
+    TradeLogger(const std::string& log_file, bool async = false, int flush_interval_ms = 100);
     ~TradeLogger();
     void logTrade(const Trade& trade); //log trade
+    void close(); // drain the queue and flush the file
+    // Stats come from a PerformanceTracker fed on the logging thread, so no
+    // trade history is kept in memory whatever the mode
     Statistics calculateStatistics(double initial_balance, double final_balance); // return trade stats
+    PerformanceTracker& performance() { return performance_; } // mark equity here for drawdown/Sharpe
     void printSummary(const Statistics& stats); // print summary   
+    static const char* csvHeader();
+    static void appendCSVRow(std::string& out, const TradeRecord& record); // one CSV line, same as the sync path
+    static void appendCSVRow(std::string& out, const Trade& trade);        // the same, strings untruncated
 private:
     std::ofstream log_file_;
-    std::vector<Trade> trades_;
+    PerformanceTracker performance_;
+    std::unique_ptr<TradeJournal> journal_;
     void writeHeader();
+
+    // Async mode
+    bool async_;
+    int flush_interval_ms_;
+    std::unique_ptr<SpscQueue<TradeRecord>> queue_;
+    std::thread writer_;
+    std::atomic<bool> stopping_;
+    std::atomic<bool> writer_idle_;     // the writer is (about to be) waiting on wake_
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    void wakeWriter();
+    static const size_t kQueueCapacity = 65536;
+    void writerLoop();
 };
 } 
 
-#endif 
+#endif
@@ -0,0 +1,329 @@
+#include "TradingHandlers.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace TradingBot {
+
+namespace {
+// Offset of the first non-zero byte of a non-zero word read from memory
+inline size_t firstNonZeroByte(uint64_t word) {
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    return static_cast<size_t>(__builtin_ctzll(word)) / 8;
+#else
+    unsigned char bytes[8];
+    std::memcpy(bytes, &word, sizeof(word));
+    size_t i = 0;
+    while (bytes[i] == 0) i++;
+    return i;
+#endif
+}
+}
+
+SignalHandler::SignalHandler(Strategy& strategy, Span<const double> closes)
+    : strategy_(&strategy), closes_(closes), first_bar_(0), symbol_(0), kernel_(nullptr), verbose_(false) {}
+
+SignalHandler::SignalHandler(Span<const int8_t> signals, size_t first_bar, const BarSeries& series, SymbolId symbol,
+                             const SignalKernel* kernel, const SignalParams& params)
+    : strategy_(nullptr), closes_(series.close()), signals_(signals), first_bar_(first_bar),
+      timestamps_(series.timestamps()), symbol_(symbol), kernel_(kernel), params_(params), verbose_(false) {}
+
+void SignalHandler::reportSignal(size_t bar) const {
+    // Same line the streaming Strategy prints
+    double short_ma, long_ma, rsi;
+    kernel_->computeSMA(params_.short_period, bar, bar + 1, &short_ma);
+    kernel_->computeSMA(params_.long_period, bar, bar + 1, &long_ma);
+    kernel_->computeRSI(params_.rsi_period, bar, bar + 1, &rsi);
+    std::cout << "Signal detected: Short MA=" << short_ma
+              << ", Long MA=" << long_ma << ", RSI=" << rsi << std::endl;
+}
+
+void SignalHandler::attach(EventEngine& engine) {
+    if (strategy_) {
+        engine.subscribe(EventType::MARKET, this);
+        return;
+    }
+    engine.subscribe(EventType::SIGNAL, this);
+    scheduleFrom(first_bar_, engine);
+}
+
+bool SignalHandler::nextSignal(size_t bar, Event& signal) const {
+    size_t end = first_bar_ + signals_.size();
+    // Mostly HOLD: skip eight codes at a time, then jump to the first non-zero one
+    for (; bar + 8 <= end; bar += 8) {
+        uint64_t codes;
+        std::memcpy(&codes, signals_.data() + (bar - first_bar_), sizeof(codes));
+        if (codes != 0) {
+            bar += firstNonZeroByte(codes);
+            break;
+        }
+    }
+    while (bar < end && signals_[bar - first_bar_] == kSignalHold) bar++;
+    if (bar >= end) return false;
+    signal.timestamp = timestamps_[bar];
+    signal.type = EventType::SIGNAL;
+    signal.side = signals_[bar - first_bar_] == kSignalBuy ? Signal::BUY : Signal::SELL;
+    signal.symbol = symbol_;
+    signal.bar = static_cast<uint32_t>(bar);
+    signal.price = closes_[bar];
+    return true;
+}
+
+// Pushes the first BUY/SELL of the batch at or after `bar`
+void SignalHandler::scheduleFrom(size_t bar, EventEngine& engine) {
+    Event signal;
+    if (nextSignal(bar, signal)) engine.push(signal);
+}
+
+void SignalHandler::onEvent(const Event& event, EventEngine& engine) {
+    if (!strategy_) {
+        // One of our scheduled signals came due
+        if (verbose_ && kernel_) reportSignal(event.bar);
+        scheduleFrom(event.bar + 1, engine);
+        return;
+    }
+    Signal signal = closes_.empty() ? strategy_->onBar(event.price) : strategy_->generateSignal(closes_, event.bar);
+    if (signal == Signal::HOLD) return;
+    engine.emit(event, EventType::SIGNAL).side = signal;
+}
+
+ExecutionHandler::ExecutionHandler(BrokerSimulator& broker) : broker_(broker) {
+    date_.reserve(32);
+}
+
+bool ExecutionHandler::book(const Event& cause, Signal side, int quantity, double price, double fees, OrderId order,
+                            EventEngine& engine) {
+    formatTimestamp(cause.timestamp, date_);
+    bool booked = side == Signal::BUY ? broker_.executeBuy(cause.symbol, quantity, price, date_, fees)
+                                      : broker_.executeSell(cause.symbol, quantity, price, date_, fees);
+    if (!booked) return false;
+    Event& fill = engine.emit(cause, EventType::FILL);
+    fill.side = side;
+    fill.quantity = broker_.getLastTrade().quantity;  // a sell is capped at the position
+    fill.price = price;
+    fill.fill.fees = fees;
+    fill.fill.balance_after = broker_.getBalance();
+    fill.fill.order = order;
+    fill.fill.trade = broker_.tradeCount();
+    return true;
+}
+
+void ExecutionHandler::flatten(const Event& bar, EventEngine& engine) {
+    if (!broker_.hasPosition(bar.symbol)) return;
+    book(bar, Signal::SELL, broker_.position(bar.symbol).quantity, bar.price, 0.0, kInvalidOrder, engine);
+}
+
+void CloseExecution::onEvent(const Event& event, EventEngine& engine) {
+    book(event, event.side, event.quantity, event.price, 0.0, kInvalidOrder, engine);
+}
+
+EngineExecution::EngineExecution(BrokerSimulator& broker, const ExecutionSettings& settings, double stop_loss_pct)
+    : ExecutionHandler(broker), engine_(settings), stop_loss_pct_(stop_loss_pct) {
+    // Sized for the symbols already registered with the broker, so their first orders do not allocate
+    size_t symbols = broker.getPositions().size();
+    working_.resize(symbols);
+    engine_.reserve(symbols, 1);
+    fills_.reserve(8);
+}
+
+EngineExecution::Working& EngineExecution::working(SymbolId symbol) {
+    if (symbol >= working_.size()) working_.resize(symbol + 1);
+    return working_[symbol];
+}
+
+bool EngineExecution::pending(SymbolId symbol, Signal side) const {
+    if (symbol >= working_.size()) return false;
+    const Working& w = working_[symbol];
+    return engine_.order(side == Signal::BUY ? w.entry : w.exit) != nullptr;
+}
+
+void EngineExecution::onEvent(const Event& event, EventEngine& engine) {
+    if (event.type == EventType::MARKET) {
+        onBar(event, engine);
+        return;
+    }
+    Working& w = working(event.symbol);
+    if (event.side == Signal::BUY) {
+        w.entry = engine_.submit(OrderRequest::market(event.symbol, Signal::BUY, event.quantity));
+    } else {
+        engine_.cancel(w.entry);
+        engine_.cancel(w.stop);
+        w.entry = w.stop = kInvalidOrder;
+        w.exit = engine_.submit(OrderRequest::market(event.symbol, Signal::SELL, event.quantity));
+    }
+}
+
+void EngineExecution::onBar(const Event& bar, EventEngine& engine) {
+    SymbolId symbol = bar.symbol;
+    if (!engine_.hasOrders(symbol)) return;
+    BarRange range = {bar.market.open, bar.market.high, bar.market.low, bar.price, bar.market.volume};
+    fills_.clear();
+    engine_.match(symbol, range, fills_);
+    for (const Fill& fill : fills_) {
+        if (!book(bar, fill.side, fill.quantity, fill.price, fill.fees, fill.order, engine)) {
+            engine_.cancel(fill.order);  // the broker could not fund it; drop the rest
+        }
+    }
+    Working& w = working(symbol);
+    if (!engine_.order(w.entry)) w.entry = kInvalidOrder;
+    if (!engine_.order(w.exit)) w.exit = kInvalidOrder;
+    if (!engine_.order(w.stop)) w.stop = kInvalidOrder;
+    // Keep the protective stop sized to the position
+    int held = broker_.position(symbol).quantity;
+    if (stop_loss_pct_ > 0 && held > 0 && w.exit == kInvalidOrder) {
+        const OrderNode* stop = engine_.order(w.stop);
+        if (!stop || stop->quantity != held) {
+            engine_.cancel(w.stop);
+            double stop_price = broker_.position(symbol).entry_price * (1.0 - stop_loss_pct_ / 100.0);
+            w.stop = engine_.submit(OrderRequest::stop(symbol, Signal::SELL, held, stop_price));
+        }
+    }
+}
+
+void EngineExecution::flatten(const Event& bar, EventEngine& engine) {
+    engine_.cancelAll(bar.symbol);
+    if (bar.symbol < working_.size()) working_[bar.symbol] = Working();
+    if (!broker_.hasPosition(bar.symbol)) return;
+    int quantity = broker_.position(bar.symbol).quantity;
+    book(bar, Signal::SELL, quantity, bar.price, engine_.fees(Signal::SELL, quantity, bar.price), kInvalidOrder,
+         engine);
+}
+
+RiskHandler::RiskHandler(RiskManager& risk, const BrokerSimulator& broker, const ExecutionHandler& execution)
+    : risk_(risk), broker_(broker), execution_(execution) {}
+
+void RiskHandler::onEvent(const Event& event, EventEngine& engine) {
+    int held = broker_.position(event.symbol).quantity;
+    int quantity = 0;
+    if (event.side == Signal::BUY && held == 0 && !execution_.pending(event.symbol, Signal::BUY)) {
+        quantity = risk_.calculatePositionSize(event.price, broker_.getBalance());
+    } else if (event.side == Signal::SELL && held > 0 && !execution_.pending(event.symbol, Signal::SELL)) {
+        quantity = held;
+    }
+    if (quantity <= 0) return;
+    Event& order = engine.emit(event, EventType::ORDER);
+    order.quantity = quantity;
+    order.order.type = OrderType::MARKET;
+    order.order.limit_price = 0;
+    order.order.stop_price = 0;
+}
+
+TradeRecorder::TradeRecorder(TradeLogger& logger, const BrokerSimulator& broker)
+    : logger_(logger), broker_(broker), trade_symbol_(kInvalidSymbol) {
+    trade_.timestamp.reserve(32);
+}
+
+void TradeRecorder::onEvent(const Event& event, EventEngine&) {
+    if (event.fill.trade == broker_.tradeCount()) {
+        logger_.logTrade(broker_.getLastTrade());  // still the broker's latest: nothing to rebuild
+        return;
+    }
+    formatTimestamp(event.timestamp, trade_.timestamp);
+    if (event.symbol != trade_symbol_) {
+        trade_.symbol = broker_.symbolName(event.symbol);
+        trade_symbol_ = event.symbol;
+    }
+    trade_.signal = event.side;
+    trade_.price = event.price;
+    trade_.quantity = event.quantity;
+    trade_.value = event.quantity * event.price;
+    trade_.balance_after = event.fill.balance_after;
+    trade_.fees = event.fill.fees;
+    logger_.logTrade(trade_);
+}
+
+void TradeRecorder::onBarClose(const Event& bar, EventEngine&) {
+    int held = broker_.position(bar.symbol).quantity;
+    logger_.performance().onMark(broker_.getBalance() + held * bar.price, held > 0);
+}
+
+void TradeRecorder::onBarRun(const BarRun& run, EventEngine&) {
+    // Nothing trades inside a run, so cash and position are fixed across it
+    int held = broker_.position(run.symbol).quantity;
+    double balance = broker_.getBalance();
+    if (held == 0) {
+        logger_.performance().onMarks(balance, false, run.closes.size());
+        return;
+    }
+    static const size_t kBatch = 256;
+    double equity[kBatch];
+    uint8_t in_market[kBatch];
+    std::fill(in_market, in_market + kBatch, held > 0);
+    for (size_t base = 0; base < run.closes.size(); base += kBatch) {
+        size_t n = std::min(kBatch, run.closes.size() - base);
+        for (size_t i = 0; i < n; ++i) equity[i] = balance + held * run.closes[base + i];
+        logger_.performance().onMarks(equity, in_market, n);
+    }
+}
+
+void FillCollector::onEvent(const Event& event, EventEngine&) {
+    Trade trade;
+    trade.signal = event.side;
+    trade.price = event.price;
+    trade.quantity = event.quantity;
+    trade.value = event.quantity * event.price;
+    trade.balance_after = event.fill.balance_after;
+    trade.fees = event.fill.fees;
+    fills_.push_back(trade);
+}
+
+EquityCurveRecorder::EquityCurveRecorder(const BrokerSimulator& broker, std::vector<double>& curve)
+    : broker_(broker), curve_(curve) {}
+
+void EquityCurveRecorder::onBarClose(const Event& bar, EventEngine&) {
+    curve_.push_back(broker_.getBalance() + broker_.position(bar.symbol).quantity * bar.price);
+}
+
+void EquityCurveRecorder::onBarRun(const BarRun& run, EventEngine&) {
+    int held = broker_.position(run.symbol).quantity;
+    double balance = broker_.getBalance();
+    for (double close : run.closes) curve_.push_back(balance + held * close);
+}
+
+ProgressReporter::ProgressReporter(const BrokerSimulator& broker, size_t total_bars)
+    : broker_(broker), total_bars_(total_bars), step_(std::max<size_t>(total_bars / 10, 1)) {
+    date_.reserve(32);
+}
+
+void ProgressReporter::onBarClose(const Event& bar, EventEngine&) {
+    if (bar.bar % step_ != 0) return;
+    double progress = (static_cast<double>(bar.bar) / total_bars_) * 100.0;
+    formatTimestamp(bar.timestamp, date_);
+    std::cout << "Progress: " << static_cast<int>(progress) << "% | "
+              << "Date: " << date_ << " | "
+              << "Price: INR " << bar.price << " | "
+              << "Portfolio Value: INR " << broker_.getPortfolioValue(bar.symbol, bar.price) << "\n";
+}
+
+void attachCloseChain(EventEngine& engine, CloseExecution& execution, EventHandler& recorder) {
+    engine.subscribe(EventType::ORDER, &execution);
+    engine.subscribe(EventType::FILL, &recorder);
+    engine.subscribeBarClose(&recorder);
+}
+
+void runCloseChain(EventEngine& engine, SeriesFeed& feed, const SignalHandler& signals, RiskHandler& risk) {
+    Event signal, bar;
+    BarRun quiet;
+    size_t from = signals.firstBar();
+    while (signals.nextSignal(from, signal)) {
+        if (feed.nextRun(signal.timestamp, signal.bar, quiet)) engine.close(quiet);
+        if (!feed.next(bar)) return;
+        // Its order and fill are due on this bar, so they are handled before it closes
+        risk.onEvent(signal, engine);
+        engine.drain();
+        engine.close(bar);
+        from = signal.bar + 1;
+    }
+    if (feed.nextRun(INT64_MAX, UINT32_MAX, quiet)) engine.close(quiet);
+}
+
+void attachTradingChain(EventEngine& engine, SignalHandler& signals, RiskHandler& risk,
+                        ExecutionHandler& execution, EventHandler& recorder) {
+    if (execution.wantsBars()) engine.subscribe(EventType::MARKET, &execution);
+    signals.attach(engine);
+    engine.subscribe(EventType::SIGNAL, &risk);
+    engine.subscribe(EventType::ORDER, &execution);
+    engine.subscribe(EventType::FILL, &recorder);
+    engine.subscribeBarClose(&recorder);
+}
+}
@@ -0,0 +1,183 @@
+#ifndef TRADING_HANDLERS_H
+#define TRADING_HANDLERS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Types.h"
+#include "EventEngine.h"
+#include "Strategy.h"
+#include "SignalKernel.h"
+#include "RiskManager.h"
+#include "BrokerSimulator.h"
+#include "MatchingEngine.h"
+#include "TradeLogger.h"
+
+namespace TradingBot {
+
+// The components every driver plugs into an EventEngine:
+//   MARKET -> SignalHandler -> SIGNAL -> RiskHandler -> ORDER
+//          -> ExecutionHandler (broker) -> FILL -> TradeRecorder (logger, equity marks)
+// One set of trading rules for backtest, live and replay: a trade is logged
+// only once the broker has booked it, and its time is the bar's timestamp.
+
+// Bars in, BUY/SELL signals out. Signals come from the streaming Strategy
+// (following `closes` by bar index when given, else fed each bar's close) or
+// from a SignalKernel batch computed up front: signals[i - first_bar] for bar
+// i of `series`. A batch is not polled on every bar: its next BUY/SELL is
+// scheduled as a SIGNAL event for that bar, and each one schedules the next,
+// so bars in between cost this handler nothing.
+class SignalHandler : public EventHandler {
+public:
+    explicit SignalHandler(Strategy& strategy, Span<const double> closes = Span<const double>());
+    SignalHandler(Span<const int8_t> signals, size_t first_bar, const BarSeries& series, SymbolId symbol,
+                  const SignalKernel* kernel = nullptr, const SignalParams& params = SignalParams());
+    void setVerbose(bool verbose) { verbose_ = verbose; } // batch mode: print indicator values on signals
+    void attach(EventEngine& engine);  // subscribes, and schedules a batch's first signal
+    void onEvent(const Event& event, EventEngine& engine) override;
+    // Batch mode: the first BUY/SELL at or after `bar` as a SIGNAL event; false when there is none
+    bool nextSignal(size_t bar, Event& signal) const;
+    size_t firstBar() const { return first_bar_; }
+private:
+    Strategy* strategy_;
+    Span<const double> closes_;
+    Span<const int8_t> signals_;
+    size_t first_bar_;
+    Span<const int64_t> timestamps_;
+    SymbolId symbol_;
+    const SignalKernel* kernel_;
+    SignalParams params_;
+    bool verbose_;
+    void scheduleFrom(size_t bar, EventEngine& engine);
+    void reportSignal(size_t bar) const;
+};
+
+// Fills ORDER events through the broker and announces them as FILL events
+class ExecutionHandler : public EventHandler {
+public:
+    explicit ExecutionHandler(BrokerSimulator& broker);
+    virtual bool wantsBars() const { return false; }  // also subscribe to MARKET
+    // An order of this side is still working for the symbol
+    virtual bool pending(SymbolId symbol, Signal side) const { (void)symbol; (void)side; return false; }
+    // End of data: cancel what is working and sell the position at the bar's close
+    virtual void flatten(const Event& bar, EventEngine& engine);
+protected:
+    BrokerSimulator& broker_;
+    std::string date_;  // reused for every fill
+    bool book(const Event& cause, Signal side, int quantity, double price, double fees, OrderId order,
+              EventEngine& engine);
+};
+
+// Orders fill immediately at the close they were sized on, without costs
+class CloseExecution : public ExecutionHandler {
+public:
+    explicit CloseExecution(BrokerSimulator& broker) : ExecutionHandler(broker) {}
+    void onEvent(const Event& event, EventEngine& engine) override;
+};
+
+// Orders go to a MatchingEngine as market orders and fill from the next bar
+// on, with slippage and costs. An optional protective stop rests below the
+// entry while a position is open and follows its size.
+class EngineExecution : public ExecutionHandler {
+public:
+    EngineExecution(BrokerSimulator& broker, const ExecutionSettings& settings, double stop_loss_pct = 0);
+    bool wantsBars() const override { return true; }
+    bool pending(SymbolId symbol, Signal side) const override;
+    void flatten(const Event& bar, EventEngine& engine) override;
+    void onEvent(const Event& event, EventEngine& engine) override;
+    const MatchingEngine& engine() const { return engine_; }
+private:
+    struct Working {
+        OrderId entry;
+        OrderId exit;
+        OrderId stop;
+        Working() : entry(kInvalidOrder), exit(kInvalidOrder), stop(kInvalidOrder) {}
+    };
+    MatchingEngine engine_;
+    double stop_loss_pct_;
+    std::vector<Working> working_;  // by SymbolId
+    std::vector<Fill> fills_;       // reused by every match
+    Working& working(SymbolId symbol);
+    void onBar(const Event& bar, EventEngine& engine);
+};
+
+// Signals to sized orders: buy with the RiskManager's size when flat, sell
+// the whole position when long, never while an order of that side is working
+class RiskHandler : public EventHandler {
+public:
+    RiskHandler(RiskManager& risk, const BrokerSimulator& broker, const ExecutionHandler& execution);
+    void onEvent(const Event& event, EventEngine& engine) override;
+private:
+    RiskManager& risk_;
+    const BrokerSimulator& broker_;
+    const ExecutionHandler& execution_;
+};
+
+// Logs every fill and marks equity at each bar close
+class TradeRecorder : public EventHandler {
+public:
+    TradeRecorder(TradeLogger& logger, const BrokerSimulator& broker);
+    void onEvent(const Event& event, EventEngine& engine) override;
+    void onBarClose(const Event& bar, EventEngine& engine) override;
+    void onBarRun(const BarRun& run, EventEngine& engine) override;  // marks the whole run in one go
+private:
+    TradeLogger& logger_;
+    const BrokerSimulator& broker_;
+    Trade trade_;               // reused; its strings keep their capacity
+    SymbolId trade_symbol_;
+};
+
+// Every fill as a Trade appended to `fills` (timestamp and symbol left empty)
+class FillCollector : public EventHandler {
+public:
+    explicit FillCollector(std::vector<Trade>& fills) : fills_(fills) {}
+    void onEvent(const Event& event, EventEngine& engine) override;
+private:
+    std::vector<Trade>& fills_;
+};
+
+// Equity (cash plus the position at the close) of every bar, appended to `curve`
+class EquityCurveRecorder : public EventHandler {
+public:
+    EquityCurveRecorder(const BrokerSimulator& broker, std::vector<double>& curve);
+    void onEvent(const Event&, EventEngine&) override {}
+    void onBarClose(const Event& bar, EventEngine& engine) override;
+    void onBarRun(const BarRun& run, EventEngine& engine) override;
+private:
+    const BrokerSimulator& broker_;
+    std::vector<double>& curve_;
+};
+
+// Progress line every 10% of a backtest
+class ProgressReporter : public EventHandler {
+public:
+    ProgressReporter(const BrokerSimulator& broker, size_t total_bars);
+    void onEvent(const Event&, EventEngine&) override {}
+    void onBarClose(const Event& bar, EventEngine& engine) override;
+private:
+    const BrokerSimulator& broker_;
+    size_t total_bars_;
+    size_t step_;
+    std::string date_;  // reused for every line
+};
+
+// Subscribes the chain in its canonical order. The execution handler sees
+// each bar before the strategy, so fills of earlier orders are booked
+// before the bar's signal is sized.
+void attachTradingChain(EventEngine& engine, SignalHandler& signals, RiskHandler& risk,
+                        ExecutionHandler& execution, EventHandler& recorder);
+
+// The same chain for a signal batch filled at the close, without the queue.
+// Every order and fill then belongs to the bar of its signal and nothing
+// else can come between them, so scheduling each signal and dispatching it
+// through the engine only costs time: runCloseChain walks the batch itself,
+// hands each signal straight to the RiskHandler, lets the engine deliver
+// the order and fill it caused, and closes the bars in between as runs.
+// Same trades, marks and bar-close calls as EventEngine::run over
+// attachTradingChain. attachCloseChain subscribes the execution handler
+// and recorder; other FILL and bar-close subscribers may be added after.
+void attachCloseChain(EventEngine& engine, CloseExecution& execution, EventHandler& recorder);
+void runCloseChain(EventEngine& engine, SeriesFeed& feed, const SignalHandler& signals, RiskHandler& risk);
+}
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef TYPES_H
 #define TYPES_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <chrono>
@@ -17,7 +18,125 @@ enum class Signal {
 // Enum for trading mode
 enum class Mode {
     BACKTEST,
-    LIVE_SIM
+    LIVE_SIM,
+    REPLAY,
+    SWEEP,
+    PORTFOLIO,
+    SHARDED,
+    WALK_FORWARD,
+    MONTE_CARLO
+};
+
+// One instrument of a portfolio run and the file its bars come from
+struct SymbolSource {
+    std::string symbol;
+    std::string data_file;
+    
+    SymbolSource() {}
+    SymbolSource(const std::string& s, const std::string& file) : symbol(s), data_file(file) {}
+};
+
+// Inclusive start:end:step range of a swept parameter
+struct ParameterRange {
+    double start;
+    double end;
+    double step;
+    
+    ParameterRange() : start(0), end(0), step(0) {}
+    ParameterRange(double value) : start(value), end(value), step(0) {}
+    ParameterRange(double s, double e, double st) : start(s), end(e), step(st) {}
+    std::vector<double> values() const {
+        std::vector<double> out;
+        if (step <= 0 || end < start) {
+            out.push_back(start);
+            return out;
+        }
+        // index-based so floating steps don't accumulate error
+        for (int i = 0; start + i * step <= end + step * 1e-9; ++i) {
+            out.push_back(start + i * step);
+        }
+        return out;
+    }
+};
+
+// Order in which the matching engine assumes a bar visited its extremes
+enum class IntrabarPath {
+    OHLC,           // open -> high -> low -> close
+    OLHC,           // open -> low -> high -> close
+    NEAREST_FIRST   // open -> whichever extreme is closer to the open -> the other -> close
+};
+
+// Fill model and trading costs for the matching engine. Percentages are of
+// the traded value; brokerage is the lower of the flat and percentage
+// charge when both are set (discount-broker style), charged per fill.
+struct ExecutionSettings {
+    IntrabarPath path;
+    double brokerage_per_order;     // INR
+    double brokerage_pct;
+    double stt_buy_pct;             // securities transaction tax
+    double stt_sell_pct;
+    double slippage_bps;            // adverse, on market and stop fills
+    double volume_participation;    // max fraction of a bar's volume filled; 0 = unlimited
+    
+    ExecutionSettings() : path(IntrabarPath::NEAREST_FIRST), brokerage_per_order(0), brokerage_pct(0),
+                          stt_buy_pct(0), stt_sell_pct(0), slippage_bps(0), volume_participation(0) {}
+};
+
+// Price process of the synthetic market generator (MarketGenerator.h)
+enum class PriceModel {
+    GBM,                // geometric Brownian motion
+    JUMP_DIFFUSION,     // GBM plus Poisson jumps with normal log sizes (Merton)
+    REGIME_SWITCHING    // GBM whose drift/volatility follow a Markov chain of regimes
+};
+
+// One state of the regime-switching model; rates are per bar
+struct MarketRegime {
+    double drift;               // mean log return
+    double volatility;          // standard deviation of the log return
+    double switch_probability;  // chance of leaving the regime on each bar
+    
+    MarketRegime(double d = 0, double v = 0.005, double p = 0.01) : drift(d), volatility(v), switch_probability(p) {}
+};
+
+// Synthetic market settings. Rates are per bar and returns are logarithmic,
+// so the same numbers mean the same thing at any bar interval.
+struct GeneratorParams {
+    PriceModel model;
+    uint64_t seed;                      // same seed and stream = same bars
+    double start_price;
+    int64_t start_timestamp;            // epoch seconds of the first bar
+    int64_t bar_seconds;
+    double drift;                       // GBM/jump: mean log return per bar (0 = flat median price)
+    double volatility;                  // GBM/jump: its standard deviation
+    double jump_probability;            // jump: chance of a jump on a bar
+    double jump_mean;                   // jump: mean log jump size
+    double jump_volatility;             // jump: standard deviation of the log jump size
+    std::vector<MarketRegime> regimes;  // regime: states in order; empty = calm + volatile
+    double base_volume;                 // typical bar volume
+    
+    GeneratorParams() : model(PriceModel::GBM), seed(42), start_price(20000.0), start_timestamp(1704067200),
+                        bar_seconds(60), drift(0), volatility(0.005), jump_probability(0.002), jump_mean(0),
+                        jump_volatility(0.02), base_volume(100000) {}
+};
+
+// How the resampler (BarAggregator.h) closes an output bar
+enum class BarType {
+    TIME,       // fixed clock buckets aligned to the Unix epoch (days start at UTC midnight)
+    VOLUME,     // every `volume` units traded
+    RANGE       // once high - low reaches `range`
+};
+
+// One output timeframe: "30s", "5m", "1h", "1d", "vol:50000" or "range:25"
+struct BarSpec {
+    BarType type;
+    int64_t seconds;    // TIME: bucket length
+    int64_t volume;     // VOLUME: units per bar
+    double range;       // RANGE: price range that completes a bar
+    
+    BarSpec() : type(BarType::TIME), seconds(60), volume(0), range(0) {}
+    static BarSpec time(int64_t s) { BarSpec spec; spec.seconds = s; return spec; }
+    static BarSpec volumeBars(int64_t v) { BarSpec spec; spec.type = BarType::VOLUME; spec.volume = v; return spec; }
+    static BarSpec rangeBars(double r) { BarSpec spec; spec.type = BarType::RANGE; spec.range = r; return spec; }
 };
 
 // Structure to hold OHLCV (Open, High, Low, Close, Volume) data
@@ -41,21 +160,34 @@ struct Trade {
     int quantity;
     double value;
     double balance_after;
+    double fees;            // brokerage + taxes, already taken out of balance_after
     
-    Trade() : price(0), quantity(0), value(0), balance_after(0) {}
+    Trade() : price(0), quantity(0), value(0), balance_after(0), fees(0) {}
 };
 
 // Structure to hold trading statistics
 struct Statistics {
-    int total_trades;
-    int winning_trades;
+    int total_trades;       // fills
+    int winning_trades;     // round trips closed at a profit
     int losing_trades;
     double total_profit_loss;
     double win_rate;
     double largest_win;
     double largest_loss;    
+    double gross_profit;
+    double gross_loss;      // positive number
+    double profit_factor;   // gross_profit / gross_loss
+    // Equity-curve statistics; only meaningful when marked_bars > 0
+    long long marked_bars;
+    double max_drawdown;        // INR, peak to trough
+    double max_drawdown_pct;    // % of the peak
+    double sharpe_ratio;        // annualised, per-bar returns, zero risk-free rate
+    double sortino_ratio;
+    double exposure_pct;        // % of bars with an open position
     Statistics() : total_trades(0), winning_trades(0), losing_trades(0),
-                   total_profit_loss(0), win_rate(0), largest_win(0), largest_loss(0) {}
+                   total_profit_loss(0), win_rate(0), largest_win(0), largest_loss(0),
+                   gross_profit(0), gross_loss(0), profit_factor(0), marked_bars(0),
+                   max_drawdown(0), max_drawdown_pct(0), sharpe_ratio(0), sortino_ratio(0), exposure_pct(0) {}
 };
 }
 
@@ -0,0 +1,204 @@
+#include "WalkForward.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+
+namespace TradingBot {
+
+WalkForwardSpec WalkForwardSpec::fromConfig(const Config& config) {
+    WalkForwardSpec spec;
+    spec.train_bars = static_cast<size_t>(std::max(config.getWalkForwardTrainBars(), 1));
+    spec.test_bars = static_cast<size_t>(std::max(config.getWalkForwardTestBars(), 1));
+    spec.anchored = config.getWalkForwardAnchored();
+    spec.optimize_sharpe = config.getWalkForwardObjective() == "sharpe";
+    return spec;
+}
+
+double WalkForwardResult::returnPct() const {
+    if (equity.empty() || initial_balance <= 0) return 0;
+    return (equity.back() / initial_balance - 1) * 100;
+}
+
+double WalkForwardResult::maxDrawdownPct() const {
+    double peak = initial_balance;
+    double worst = 0;
+    for (double value : equity) {
+        peak = std::max(peak, value);
+        if (peak > 0) worst = std::max(worst, (peak - value) / peak * 100);
+    }
+    return worst;
+}
+
+WalkForward::WalkForward(const BarSeries& series, const BacktestParams& base, const SweepSpec& sweep,
+                         const WalkForwardSpec& spec)
+    : series_(series), base_(base), spec_(spec), combos_(ParameterSweep::grid(base, sweep)) {}
+
+std::vector<WalkForwardWindow> WalkForward::windows() const {
+    std::vector<WalkForwardWindow> windows;
+    size_t n = series_.size();
+    if (spec_.train_bars == 0 || spec_.test_bars == 0) return windows;
+    // Only whole test windows; a shorter tail at the end of the series is left out
+    for (size_t test_begin = spec_.train_bars; test_begin + spec_.test_bars <= n; test_begin += spec_.test_bars) {
+        WalkForwardWindow window = WalkForwardWindow();
+        window.train_begin = spec_.anchored ? 0 : test_begin - spec_.train_bars;
+        window.train_end = test_begin;
+        window.test_begin = test_begin;
+        window.test_end = test_begin + spec_.test_bars;
+        windows.push_back(window);
+    }
+    return windows;
+}
+
+double WalkForward::objective(const BacktestResult& result) const {
+    return spec_.optimize_sharpe ? result.stats.sharpe_ratio : result.stats.total_profit_loss;
+}
+
+WalkForwardResult WalkForward::run(size_t threads) {
+    auto start = std::chrono::steady_clock::now();
+    WalkForwardResult result;
+    result.windows = windows();
+    result.initial_balance = base_.initial_balance;
+    size_t count = result.windows.size();
+    size_t combos = combos_.size();
+    if (count == 0 || combos == 0) return result;
+
+    // Prefix sums are built once; every window and combination reads them
+    SignalKernel kernel(series_.close());
+    std::vector<BacktestResult> train(count * combos);
+    std::vector<std::vector<double>> curves(count);
+    for (std::vector<double>& curve : curves) curve.reserve(spec_.test_bars);
+    {
+        ThreadPool pool(threads);
+        std::unique_ptr<RunArena[]> arenas(new RunArena[pool.size() + 1]);
+        parallelFor(pool, train.size(), [&](size_t i) {
+            const WalkForwardWindow& window = result.windows[i / combos];
+            RunArena& arena = arenas[pool.workerIndex()];
+            arena.reset();
+            Backtester backtester(series_, combos_[i % combos], &kernel);
+            backtester.setArena(&arena);
+            backtester.setWindow(window.train_begin, window.train_end);
+            train[i] = backtester.run();
+        });
+        // Best combination per window; ties go to the earlier one in grid order
+        for (size_t w = 0; w < count; ++w) {
+            size_t best = w * combos;
+            for (size_t c = best + 1; c < (w + 1) * combos; ++c) {
+                if (objective(train[c]) > objective(train[best])) best = c;
+            }
+            result.windows[w].train = train[best];
+        }
+        parallelFor(pool, count, [&](size_t w) {
+            WalkForwardWindow& window = result.windows[w];
+            RunArena& arena = arenas[pool.workerIndex()];
+            arena.reset();
+            Backtester backtester(series_, window.train.params, &kernel);
+            backtester.setArena(&arena);
+            backtester.setWindow(window.test_begin, window.test_end);
+            backtester.setEquityCurve(&curves[w]);
+            window.test = backtester.run();
+        });
+    }
+
+    // Each test run starts from the initial balance; chaining their returns
+    // gives the curve of trading the windows one after another
+    Span<const int64_t> timestamps = series_.timestamps();
+    result.timestamps.reserve(count * spec_.test_bars);
+    result.equity.reserve(count * spec_.test_bars);
+    double capital = base_.initial_balance;
+    for (size_t w = 0; w < count; ++w) {
+        WalkForwardWindow& window = result.windows[w];
+        double scale = base_.initial_balance > 0 ? capital / base_.initial_balance : 0;
+        const std::vector<double>& curve = curves[w];
+        // The curve starts at the first bar the strategy could trade
+        size_t first = window.test_end - curve.size();
+        for (size_t i = 0; i < curve.size(); ++i) {
+            result.timestamps.push_back(timestamps[first + i]);
+            result.equity.push_back(curve[i] * scale);
+        }
+        window.start_equity = capital;
+        capital = window.test.final_balance * scale;
+        window.end_equity = capital;
+    }
+    result.backtests = train.size() + count;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+void WalkForward::printTable(const WalkForwardResult& result) {
+    std::cout << "\n" << std::string(78, '=') << "\n";
+    std::cout << "   Win   Test bars    Short  Long  Risk%  Train P/L  Trades   Win%   Test P/L\n";
+    std::cout << std::string(78, '-') << "\n";
+    std::cout << std::fixed;
+    int trades = 0, wins = 0, losses = 0, profitable = 0;
+    for (size_t i = 0; i < result.windows.size(); ++i) {
+        const WalkForwardWindow& w = result.windows[i];
+        std::string range = std::to_string(w.test_begin) + "-" + std::to_string(w.test_end - 1);
+        std::cout << std::setw(6) << (i + 1)
+                  << std::setw(12) << range
+                  << std::setw(9) << w.train.params.short_ma_period
+                  << std::setw(6) << w.train.params.long_ma_period
+                  << std::setprecision(1)
+                  << std::setw(7) << w.train.params.risk_percentage
+                  << std::setprecision(2)
+                  << std::setw(11) << w.train.stats.total_profit_loss
+                  << std::setw(8) << w.test.stats.total_trades
+                  << std::setprecision(1)
+                  << std::setw(7) << w.test.stats.win_rate
+                  << std::setprecision(2)
+                  << std::setw(11) << w.test.stats.total_profit_loss << "\n";
+        trades += w.test.stats.total_trades;
+        wins += w.test.stats.winning_trades;
+        losses += w.test.stats.losing_trades;
+        if (w.end_equity > w.start_equity) profitable++;
+    }
+    std::cout << std::string(78, '-') << "\n";
+    double final_equity = result.equity.empty() ? result.initial_balance : result.equity.back();
+    std::cout << "Out-of-sample: " << result.windows.size() << " windows (" << profitable << " profitable), "
+              << result.equity.size() << " bars, " << trades << " trades, win rate "
+              << std::setprecision(1) << (wins + losses > 0 ? 100.0 * wins / (wins + losses) : 0.0) << "%\n";
+    std::cout << std::setprecision(2) << "Equity: INR " << result.initial_balance << " -> INR " << final_equity
+              << " (" << result.returnPct() << "%), max drawdown " << result.maxDrawdownPct() << "%\n";
+    std::cout << std::string(78, '=') << "\n";
+}
+
+bool WalkForward::writeCSV(const std::string& filename, const WalkForwardResult& result) {
+    std::ofstream out(filename);
+    if (!out.is_open()) {
+        std::cerr << "Warning: Could not create walk-forward results file " << filename << std::endl;
+        return false;
+    }
+    out << "Window,TrainBegin,TrainEnd,TestBegin,TestEnd,ShortMA,LongMA,RSIPeriod,RSIUpper,RSILower,RiskPercentage,"
+           "TrainProfitLoss,TrainSharpe,TestTrades,TestWinRate,TestProfitFactor,TestMaxDrawdownPct,TestSharpe,"
+           "TestProfitLoss,StartEquity,EndEquity\n";
+    out << std::fixed << std::setprecision(2);
+    for (size_t i = 0; i < result.windows.size(); ++i) {
+        const WalkForwardWindow& w = result.windows[i];
+        const BacktestParams& p = w.train.params;
+        out << (i + 1) << "," << w.train_begin << "," << w.train_end << "," << w.test_begin << "," << w.test_end
+            << "," << p.short_ma_period << "," << p.long_ma_period << "," << p.rsi_period << "," << p.rsi_upper
+            << "," << p.rsi_lower << "," << p.risk_percentage << "," << w.train.stats.total_profit_loss << ","
+            << w.train.stats.sharpe_ratio << "," << w.test.stats.total_trades << "," << w.test.stats.win_rate << ","
+            << w.test.stats.profit_factor << "," << w.test.stats.max_drawdown_pct << "," << w.test.stats.sharpe_ratio
+            << "," << w.test.stats.total_profit_loss << "," << w.start_equity << "," << w.end_equity << "\n";
+    }
+    return true;
+}
+
+bool WalkForward::writeEquityCSV(const std::string& filename, const WalkForwardResult& result) {
+    std::ofstream out(filename);
+    if (!out.is_open()) {
+        std::cerr << "Warning: Could not create walk-forward equity file " << filename << std::endl;
+        return false;
+    }
+    out << "Timestamp,Equity\n";
+    out << std::fixed << std::setprecision(2);
+    for (size_t i = 0; i < result.equity.size(); ++i) {
+        out << result.timestamps[i] << "," << result.equity[i] << "\n";
+    }
+    return true;
+}
+}
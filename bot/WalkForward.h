@@ -0,0 +1,83 @@
+#ifndef WALK_FORWARD_H
+#define WALK_FORWARD_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Types.h"
+#include "BarSeries.h"
+#include "Backtester.h"
+#include "ParameterSweep.h"
+#include "Config.h"
+
+namespace TradingBot {
+
+// Window sizes in bars. Test windows follow each other without overlap, so
+// each train window starts test_bars after the previous one (or at bar 0
+// when anchored) and ends where its test window begins.
+struct WalkForwardSpec {
+    size_t train_bars;
+    size_t test_bars;
+    bool anchored;              // train from bar 0 every time instead of a rolling window
+    bool optimize_sharpe;       // pick by train Sharpe instead of train P/L
+
+    WalkForwardSpec() : train_bars(120), test_bars(40), anchored(false), optimize_sharpe(false) {}
+    static WalkForwardSpec fromConfig(const Config& config);
+};
+
+struct WalkForwardWindow {
+    size_t train_begin;
+    size_t train_end;           // = test_begin
+    size_t test_begin;
+    size_t test_end;
+    BacktestResult train;       // best combination on the train bars
+    BacktestResult test;        // that combination on the test bars, from the initial balance
+    double start_equity;        // stitched equity entering / leaving the window
+    double end_equity;
+};
+
+struct WalkForwardResult {
+    std::vector<WalkForwardWindow> windows;
+    // Out-of-sample equity, one point per test bar, each window compounding on the last
+    std::vector<int64_t> timestamps;
+    std::vector<double> equity;
+    double initial_balance;
+    size_t backtests;
+    double seconds;
+
+    WalkForwardResult() : initial_balance(0), backtests(0), seconds(0) {}
+    double returnPct() const;
+    double maxDrawdownPct() const;
+};
+
+// Walk-forward optimisation: for every window the sweep grid is backtested
+// on the train bars, and the best combination is traded on the test bars
+// that follow. Only those test bars count, so the stitched curve is
+// out-of-sample throughout.
+//
+// One SignalKernel over the whole series serves every run, so overlapping
+// windows share the same indicator prefix sums instead of rebuilding them.
+// All train runs (windows x combinations) go to the ThreadPool at once,
+// then all test runs.
+class WalkForward {
+public:
+    WalkForward(const BarSeries& series, const BacktestParams& base, const SweepSpec& sweep,
+                const WalkForwardSpec& spec);
+    std::vector<WalkForwardWindow> windows() const;  // ranges only
+    size_t combinations() const { return combos_.size(); }
+    WalkForwardResult run(size_t threads = 0);
+
+    static void printTable(const WalkForwardResult& result);
+    static bool writeCSV(const std::string& filename, const WalkForwardResult& result);
+    static bool writeEquityCSV(const std::string& filename, const WalkForwardResult& result);
+private:
+    const BarSeries& series_;
+    BacktestParams base_;
+    WalkForwardSpec spec_;
+    std::vector<BacktestParams> combos_;
+
+    double objective(const BacktestResult& result) const;
+};
+}
+
+#endif
@@ -1,18 +1,63 @@
 #include <iostream>
-#include <thread>
 #include <chrono>
-#ifdef _WIN32
-#include <windows.h>
-#endif
+#include <algorithm>
+#include <iomanip>
+#include <memory>
+#include <atomic>
+#include <csignal>
+#include <cmath>
 #include "Config.h"
 #include "MarketDataHandler.h"
 #include "Strategy.h"
 #include "RiskManager.h"
 #include "BrokerSimulator.h"
 #include "TradeLogger.h"
+#include "Backtester.h"
+#include "ParameterSweep.h"
+#include "PortfolioBacktester.h"
+#include "LivePipeline.h"
+#include "ShardedLiveEngine.h"
+#include "WalkForward.h"
+#include "MonteCarlo.h"
+#include "ThreadPool.h"
+#include "AllocationStats.h"
 
 using namespace TradingBot;
 
+// Set by Ctrl+C in live mode; the feed stops and the pipeline drains normally
+static std::atomic<bool> g_stop_requested(false);
+extern "C" void onInterrupt(int) {
+    g_stop_requested.store(true);
+}
+
+// Load the configured data file (or `path`) with the configured loader options
+static bool loadMarketData(const Config& config, MarketDataHandler& dataHandler, const std::string& path = "") {
+    dataHandler.setLoadThreads(static_cast<size_t>(std::max(config.getLoadThreads(), 0)));
+    dataHandler.setUseCache(config.getUseDataCache());
+    dataHandler.setRebuildCache(config.getRebuildCache());
+    dataHandler.setTimeframes(config.getBarTimeframes());
+    if (!dataHandler.loadFromCSV(path.empty() ? config.getDataFilePath() : path)) {
+        std::cerr << "Failed to load market data. Exiting.\n";
+        return false;
+    }
+    return true;
+}
+
+// logs/<name>.csv, or logs/<name>.tbj when the binary journal is selected
+static std::string tradeLogPath(const Config& config, const std::string& name) {
+    return "logs/" + name + (config.getBinaryTradeLog() ? ".tbj" : ".csv");
+}
+
+// Heap activity and memory high-water mark of a run
+static void printResourceUsage(uint64_t allocations, uint64_t loop_allocations, size_t bars) {
+    std::cout << std::fixed << std::setprecision(2);
+    if (AllocationStats::enabled()) {
+        std::cout << "Heap allocations: " << allocations << " (" << loop_allocations
+                  << " inside the bar loop over " << bars << " bars)\n";
+    }
+    std::cout << "Peak RSS: " << AllocationStats::peakRSSBytes() / (1024.0 * 1024.0) << " MB\n";
+}
+
 // Function to run backtest mode
 void runBacktest(Config& config) {
     std::cout << "\n" << std::string(60, '=') << "\n";
@@ -21,77 +66,177 @@ void runBacktest(Config& config) {
     
     // Initialize components
     MarketDataHandler dataHandler;
-    if (!dataHandler.loadFromCSV(config.getDataFilePath())) {
-        std::cerr << "Failed to load market data. Exiting.\n";
+    if (!loadMarketData(config, dataHandler)) {
         return;
     }   
-    Strategy strategy(config.getShortMA(), config.getLongMA());
-    RiskManager riskManager(config.getRiskPercentage());
-    BrokerSimulator broker(config.getInitialBalance());
-    TradeLogger logger("logs/trades.csv");
+    TradeLogger logger(tradeLogPath(config, "trades"), config.getAsyncLogging(), config.getLogFlushIntervalMs());
     
     std::cout << "Initial Balance: INR " << config.getInitialBalance() << "\n";
     std::cout << "Strategy: MA Crossover (" << config.getShortMA() 
-              << "/" << config.getLongMA() << ")\n";
+              << "/" << config.getLongMA() << ") + RSI(" << config.getRSIPeriod() << ") "
+              << config.getRSILower() << "/" << config.getRSIUpper() << "\n";
     std::cout << "Risk per Trade: " << config.getRiskPercentage() << "%\n\n";
     
     // Run backtest
-    const auto& all_data = dataHandler.getAllData();
-    size_t total_bars = all_data.size();
-    
-    for (size_t i = config.getLongMA(); i < total_bars; ++i) {
-        const OHLCV& current_bar = all_data[i];
-        
-        // Generate signal
-        Signal signal = strategy.generateSignal(all_data, i);
-        
-        // Execute trades based on signal
-        if (signal == Signal::BUY && !broker.hasPosition(config.getSymbol())) {
-            int quantity = riskManager.calculatePositionSize(
-                current_bar.close, broker.getBalance());
-            
-            if (quantity > 0) {
-                if (broker.executeBuy(config.getSymbol(), quantity, 
-                                     current_bar.close, current_bar.date)) {
-                    logger.logTrade(broker.getLastTrade());
-                }
-            }
-        } 
-        else if (signal == Signal::SELL && broker.hasPosition(config.getSymbol())) {
-            Position pos = broker.getPosition(config.getSymbol());
-            if (broker.executeSell(config.getSymbol(), pos.quantity, 
-                                  current_bar.close, current_bar.date)) {
-                logger.logTrade(broker.getLastTrade());
-            }
-        }
-        
-        // Show progress every 10%
-        if (i % (total_bars / 10) == 0) {
-            double progress = (static_cast<double>(i) / total_bars) * 100.0;
-            double portfolio_value = broker.getPortfolioValue(
-                config.getSymbol(), current_bar.close);
-            std::cout << "Progress: " << static_cast<int>(progress) << "% | "
-                      << "Date: " << current_bar.date << " | "
-                      << "Price: INR " << current_bar.close << " | "
-                      << "Portfolio Value: INR " << portfolio_value << "\n";
+    std::unique_ptr<SignalKernel> kernel;
+    if (config.getVectorizedSignals()) {
+        kernel.reset(new SignalKernel(dataHandler.getSeries().close()));
+    }
+    Backtester backtester(dataHandler.getSeries(), BacktestParams::fromConfig(config), kernel.get());
+    backtester.setVerbose(true);
+    BacktestResult result = backtester.run(logger);
+    
+    std::cout << "\nFinal Balance: INR " << result.final_balance << "\n";
+    logger.printSummary(result.stats);
+    printResourceUsage(result.allocations, result.loop_allocations, result.bars);
+}
+
+// Function to run a parameter sweep over the configured ranges
+void runSweep(Config& config) {
+    std::cout << "\n" << std::string(60, '=') << "\n";
+    std::cout << "    NIFTY 50 TRADING BOT - PARAMETER SWEEP\n";
+    std::cout << std::string(60, '=') << "\n\n";
+    
+    MarketDataHandler dataHandler;
+    if (!loadMarketData(config, dataHandler)) {
+        return;
+    }
+    ParameterSweep sweep(dataHandler.getSeries(), BacktestParams::fromConfig(config),
+                         SweepSpec::fromConfig(config));
+    size_t threads = static_cast<size_t>(std::max(config.getSweepThreads(), 0));
+    size_t combos = sweep.combinations().size();
+    std::cout << "Running " << combos << " parameter combinations on "
+              << (threads == 0 ? ThreadPool::defaultThreadCount() : threads) << " threads...\n";
+    
+    std::vector<BacktestResult> results = sweep.run(threads);
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Completed in " << sweep.lastRunSeconds() << " s ("
+              << (sweep.lastRunSeconds() > 0 ? combos / sweep.lastRunSeconds() : 0.0) << " backtests/s)\n";
+    ParameterSweep::printTable(results, static_cast<size_t>(std::max(config.getSweepTop(), 0)));
+    if (ParameterSweep::writeCSV("logs/sweep_results.csv", results)) {
+        std::cout << "Full results written to logs/sweep_results.csv\n";
+    }
+    uint64_t allocations = 0, loop_allocations = 0;
+    size_t bars = 0;
+    for (const BacktestResult& r : results) {
+        allocations += r.allocations;
+        loop_allocations += r.loop_allocations;
+        bars += r.bars;
+    }
+    printResourceUsage(allocations, loop_allocations, bars);
+}
+
+// Function to run every configured symbol against one cash balance
+void runPortfolio(Config& config) {
+    std::cout << "\n" << std::string(60, '=') << "\n";
+    std::cout << "    NIFTY 50 TRADING BOT - PORTFOLIO BACKTEST\n";
+    std::cout << std::string(60, '=') << "\n\n";
+    
+    // Load the symbols in parallel; each file is parsed by one thread
+    std::vector<SymbolSource> sources = config.getPortfolioSymbols();
+    size_t threads = static_cast<size_t>(std::max(config.getPortfolioThreads(), 0));
+    std::vector<MarketDataHandler> handlers(sources.size());
+    std::vector<char> loaded(sources.size(), 0);
+    auto load_start = std::chrono::steady_clock::now();
+    {
+        ThreadPool pool(std::min(threads == 0 ? ThreadPool::defaultThreadCount() : threads, sources.size()));
+        parallelFor(pool, sources.size(), [&](size_t k) {
+            handlers[k].setLoadThreads(sources.size() == 1 ? static_cast<size_t>(std::max(config.getLoadThreads(), 0)) : 1);
+            handlers[k].setUseCache(config.getUseDataCache());
+            handlers[k].setRebuildCache(config.getRebuildCache());
+            handlers[k].setTimeframes(config.getBarTimeframes());
+            handlers[k].setVerbose(false);
+            loaded[k] = handlers[k].loadFromCSV(sources[k].data_file);
+        });
+    }
+    double load_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - load_start).count();
+    
+    if (config.getUseMatchingEngine()) {
+        std::cerr << "Warning: portfolio mode fills at the close without costs; execution_model=engine and "
+                     "its fees, slippage and stop loss are ignored\n";
+    }
+    PortfolioBacktester portfolio(BacktestParams::fromConfig(config), config.getVectorizedSignals());
+    size_t total_bars = 0;
+    for (size_t k = 0; k < sources.size(); ++k) {
+        if (!loaded[k]) {
+            std::cerr << "Warning: skipping " << sources[k].symbol << " (no data from "
+                      << sources[k].data_file << ")\n";
+            continue;
         }
+        portfolio.addSymbol(sources[k].symbol, handlers[k].getSeries());
+        total_bars += handlers[k].getSeries().size();
+    }
+    if (portfolio.symbolCount() == 0) {
+        std::cerr << "Failed to load market data. Exiting.\n";
+        return;
     }
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Loaded " << portfolio.symbolCount() << " symbols (" << total_bars << " bars) in "
+              << load_seconds << " s\n";
+    std::cout << "Initial Balance: INR " << config.getInitialBalance() << "\n";
+    std::cout << "Strategy: MA Crossover (" << config.getShortMA() 
+              << "/" << config.getLongMA() << ") + RSI(" << config.getRSIPeriod() << ") "
+              << config.getRSILower() << "/" << config.getRSIUpper() << "\n";
+    std::cout << "Risk per Trade: " << config.getRiskPercentage() << "% of cash\n";
+    
+    TradeLogger logger(tradeLogPath(config, "portfolio_trades"), config.getAsyncLogging(), config.getLogFlushIntervalMs());
+    PortfolioResult result = portfolio.run(logger, threads);
     
-    // Close any remaining positions
-    if (broker.hasPosition(config.getSymbol())) {
-        const OHLCV& last_bar = all_data.back();
-        Position pos = broker.getPosition(config.getSymbol());
-        broker.executeSell(config.getSymbol(), pos.quantity, 
-                          last_bar.close, last_bar.date);
-        logger.logTrade(broker.getLastTrade());
+    PortfolioBacktester::printTable(result);
+    std::cout << "Signals: " << result.signal_seconds << " s | Execution: "
+              << result.execution_seconds << " s\n";
+    std::cout << "\nFinal Balance: INR " << result.final_balance << "\n";
+    logger.printSummary(result.stats);
+}
+
+// Strategy, risk manager, broker and logger for a live or replayed session
+struct LiveSession {
+    AllocationScope allocations;    // this thread's, from here on (the feed thread counts its own)
+    Strategy strategy;
+    RiskManager riskManager;
+    BrokerSimulator broker;
+    TradeLogger logger;
+    LivePipelineOptions options;
+
+    LiveSession(const Config& config, const std::string& log_name)
+        : strategy(config.getShortMA(), config.getLongMA(), config.getRSIPeriod(), config.getRSIUpper(),
+                   config.getRSILower()),
+          riskManager(config.getRiskPercentage()),
+          broker(config.getInitialBalance()),
+          logger(tradeLogPath(config, log_name), config.getAsyncLogging(), config.getLogFlushIntervalMs()) {
+        options.iterations = config.getLiveIterations();
+        options.feed_rate = config.getLiveFeedRate();
+        options.print_bars = config.getLivePrintBars();
+        options.symbol = config.getSymbol();
+        options.stop_flag = &g_stop_requested;
+        // Console output belongs to the engine thread, after the timed part
+        broker.setVerbose(false);
+        strategy.setVerbose(false);
     }
+};
+
+// Reports and final summary shared by live and replay mode
+static void finishLiveSession(const Config& config, LiveSession& session, const LivePipeline& pipeline) {
+    session.logger.close();  // everything logged is on disk from here on
     
-    // Calculate and display final statistics
-    double final_balance = broker.getBalance();
-    Statistics stats = logger.calculateStatistics(config.getInitialBalance(), final_balance);
+    // Positions stay open as before; show what they are worth
+    if (session.broker.hasPosition(config.getSymbol())) {
+        std::cout << "\nOpen position valued at INR "
+                  << session.broker.getPortfolioValue(config.getSymbol(), pipeline.lastPrice()) << "\n";
+    }
+    pipeline.printLatencyReport();
+    printResourceUsage(session.allocations.allocations() + pipeline.feedAllocations(), pipeline.loopAllocations(),
+                       pipeline.barsProcessed());
+#if TRADINGBOT_LATENCY_PROBES
+    if (!config.getLatencyDumpFile().empty() && pipeline.latency().writeCSV(config.getLatencyDumpFile())) {
+        std::cout << "Latency histograms written to " << config.getLatencyDumpFile() << "\n";
+    }
+#endif
     
-    std::cout << "\nFinal Balance: INR " << final_balance << "\n";
-    logger.printSummary(stats);
+    // Final summary; P/L counts the open position at the last price, like the equity marks
+    double final_value = session.broker.getPortfolioValue(config.getSymbol(), pipeline.lastPrice());
+    Statistics stats = session.logger.calculateStatistics(config.getInitialBalance(), final_value);
+    session.logger.printSummary(stats);
 }
 
 // Function to run live simulation mode
@@ -100,106 +245,276 @@ void runLiveSimulation(Config& config) {
     std::cout << "    NIFTY 50 TRADING BOT - LIVE SIMULATION MODE\n";
     std::cout << std::string(60, '=') << "\n\n";    
     MarketDataHandler dataHandler;
-    if (!dataHandler.loadFromCSV(config.getDataFilePath())) {
-        std::cerr << "Failed to load market data. Exiting.\n";
+    if (!loadMarketData(config, dataHandler)) {
         return;
     }   
-    Strategy strategy(config.getShortMA(), config.getLongMA());
-    RiskManager riskManager(config.getRiskPercentage());
-    BrokerSimulator broker(config.getInitialBalance());
-    TradeLogger logger("logs/live_trades.csv");
+    LiveSession session(config, "live_trades");
+    dataHandler.setGeneratorParams(config.getGeneratorParams());
     
     std::cout << "Starting live simulation...\n";
     std::cout << "Press Ctrl+C to stop.\n\n";
     
     // Use data points as history, then simulate live
-    std::vector<OHLCV> live_data;
-    const auto& historical_data = dataHandler.getAllData();
+    const BarSeries& historical_data = dataHandler.getSeries();
     
     size_t history_size = static_cast<size_t>(config.getLiveHistorySize());
     size_t start_index = historical_data.size() > history_size ? 
                          historical_data.size() - history_size : 0;
-    for (size_t i = start_index; i < historical_data.size(); ++i) {
-        live_data.push_back(historical_data[i]);
-    }
-    
-    // Simulate live trading for configured number of iterations
-    int iterations = config.getLiveIterations();
-    for (int iteration = 0; iteration < iterations; ++iteration) {
-        // Generate new "live" data point
-        OHLCV new_data = dataHandler.generateLiveData(live_data.back());
-        new_data.date = "Live-" + std::to_string(iteration);
-        live_data.push_back(new_data);
-
-        // Generate signal
-        Signal signal = strategy.generateSignal(live_data, live_data.size() - 1);
-        
-        std::cout << "\n--- Iteration " << iteration << " ---\n";
-    std::cout << "Current Price: INR " << new_data.close << " | Signal: ";
-        
-        if (signal == Signal::BUY) {
-            std::cout << "BUY\n";
-            if (!broker.hasPosition(config.getSymbol())) {
-                int quantity = riskManager.calculatePositionSize(
-                    new_data.close, broker.getBalance());
-                if (quantity > 0) {
-                    broker.executeBuy(config.getSymbol(), quantity, 
-                                     new_data.close, new_data.date);
-                    logger.logTrade(broker.getLastTrade());
-                }
-            }
-        } else if (signal == Signal::SELL) {
-            std::cout << "SELL\n";
-            if (broker.hasPosition(config.getSymbol())) {
-                Position pos = broker.getPosition(config.getSymbol());
-                broker.executeSell(config.getSymbol(), pos.quantity, 
-                                  new_data.close, new_data.date);
-                logger.logTrade(broker.getLastTrade());
-            }
+    session.strategy.warmUp(historical_data.close(), start_index);
+    size_t last = historical_data.size() - 1;
+    OHLCV last_bar = historical_data.barAt(last);
+    // New bars continue the history's spacing (daily when it cannot be told)
+    Span<const int64_t> timestamps = historical_data.timestamps();
+    int64_t interval = last > 0 && timestamps[last] > timestamps[last - 1] ? timestamps[last] - timestamps[last - 1]
+                                                                          : 86400;
+    
+    // A recorded session starts with its warm-up history, so replaying it
+    // (replay_file, same live_history_size) trades the same bars again
+    BarSeries recording;
+    if (!config.getLiveRecordFile().empty()) {
+        recording.reserve(historical_data.size() - start_index + std::max(config.getLiveIterations(), 0));
+        for (size_t i = start_index; i < historical_data.size(); ++i) {
+            recording.append(timestamps[i], historical_data.open()[i], historical_data.high()[i],
+                             historical_data.low()[i], historical_data.close()[i], historical_data.volume()[i]);
+        }
+        session.options.record = &recording;
+    }
+    
+    // The feed runs on its own thread; the event engine runs on this one
+    std::signal(SIGINT, onInterrupt);
+    LivePipeline pipeline(dataHandler, session.strategy, session.riskManager, session.broker, session.logger,
+                          session.options);
+    pipeline.run(last_bar, timestamps[last], interval);
+    std::signal(SIGINT, SIG_DFL);
+    if (!config.getLiveRecordFile().empty()) {
+        if (writeBarsCSV(config.getLiveRecordFile(), recording)) {
+            std::cout << "\nSession recorded to " << config.getLiveRecordFile() << " (" << recording.size()
+                      << " bars)\n";
         } else {
-            std::cout << "HOLD\n";
+            std::cerr << "Warning: Could not write session file " << config.getLiveRecordFile() << "\n";
         }
-        
-        double portfolio_value = broker.getPortfolioValue(
-            config.getSymbol(), new_data.close);
-        std::cout << "Portfolio Value: INR " << portfolio_value << "\n";
-        
-    // Simulate real-time delay
-#ifdef _WIN32
-    ::Sleep(500); // Sleep takes milliseconds on Windows
-#else
-    std::this_thread::sleep_for(std::chrono::milliseconds(500));
-#endif
+    }
+    finishLiveSession(config, session, pipeline);
+}
+
+// Function to replay the recorded data through the live engine
+void runReplay(Config& config) {
+    std::cout << "\n" << std::string(60, '=') << "\n";
+    std::cout << "    NIFTY 50 TRADING BOT - REPLAY MODE\n";
+    std::cout << std::string(60, '=') << "\n\n";
+    MarketDataHandler dataHandler;
+    if (!loadMarketData(config, dataHandler, config.getReplayFile())) {
+        return;
+    }
+    LiveSession session(config, "replay_trades");
+    double speed = config.getReplaySpeed();
+    if (std::isinf(speed)) {
+        session.options.feed_rate = 0;
+    } else if (speed > 0) {
+        session.options.speed = speed;
     }
     
-    // Final summary
-    double final_balance = broker.getBalance();
-    Statistics stats = logger.calculateStatistics(config.getInitialBalance(), final_balance);
-    logger.printSummary(stats);
+    // The first live_history_size bars warm the strategy up; the rest are replayed
+    const BarSeries& recorded = dataHandler.getSeries();
+    if (recorded.size() < 2) {
+        std::cerr << "Error: " << (config.getReplayFile().empty() ? config.getDataFilePath() : config.getReplayFile())
+                  << " has " << recorded.size()
+                  << " bars; nothing to replay after the warm-up" << std::endl;
+        return;
+    }
+    size_t history_size = static_cast<size_t>(std::max(config.getLiveHistorySize(), 0));
+    if (history_size >= recorded.size()) {
+        // The file is no longer than the warm-up: warm up only as far as the strategy needs
+        size_t needed = static_cast<size_t>(std::max(std::max(config.getLongMA(), config.getRSIPeriod()), 0)) + 1;
+        history_size = std::min(needed, recorded.size() - 1);
+        std::cout << "live_history_size=" << config.getLiveHistorySize() << " covers all " << recorded.size()
+                  << " recorded bars; warming up on " << history_size << " instead\n";
+    }
+    session.strategy.warmUp(recorded.close().subspan(0, history_size));
+    session.options.iterations = static_cast<int>(recorded.size() - history_size);
+    std::cout << "Replaying " << session.options.iterations << " bars after " << history_size
+              << " bars of history ";
+    if (session.options.speed > 0) {
+        std::cout << "at " << session.options.speed << "x recorded time...\n";
+    } else if (session.options.feed_rate > 0) {
+        std::cout << "at " << session.options.feed_rate << " bars/s...\n";
+    } else {
+        std::cout << "unthrottled...\n";
+    }
+    std::cout << "Press Ctrl+C to stop.\n\n";
+    
+    std::signal(SIGINT, onInterrupt);
+    LivePipeline pipeline(dataHandler, session.strategy, session.riskManager, session.broker, session.logger,
+                          session.options);
+    pipeline.replay(recorded, history_size, recorded.size());
+    std::signal(SIGINT, SIG_DFL);
+    finishLiveSession(config, session, pipeline);
+}
+
+// Function to run every sweep combination on many synthetic symbols at once
+void runSharded(Config& config) {
+    std::cout << "\n" << std::string(60, '=') << "\n";
+    std::cout << "    NIFTY 50 TRADING BOT - SHARDED LIVE SIMULATION\n";
+    std::cout << std::string(60, '=') << "\n\n";
+    
+    std::vector<BacktestParams> strategies = ParameterSweep::grid(BacktestParams::fromConfig(config),
+                                                                  SweepSpec::fromConfig(config));
+    std::vector<ShardSpec> shards;
+    for (int s = 0; s < config.getShardSymbols(); ++s) {
+        for (const BacktestParams& strategy : strategies) {
+            ShardSpec shard;
+            shard.params = strategy;
+            shard.params.symbol = "SYN" + std::to_string(s + 1);  // same bars as synth_bars' SYN<s+1>.csv
+            shard.symbol_index = static_cast<uint32_t>(s);
+            shards.push_back(shard);
+        }
+    }
+    ShardedLiveOptions options;
+    options.bars = config.getShardBars();
+    options.history = config.getLiveHistorySize();
+    options.feed_rate = config.getShardFeedRate();
+    options.threads = static_cast<size_t>(std::max(config.getShardThreads(), 0));
+    options.pin_threads = config.getShardPinThreads();
+    options.generator = config.getGeneratorParams();
+    options.stop_flag = &g_stop_requested;
+    std::cout << "Running " << shards.size() << " shards (" << config.getShardSymbols() << " symbols x "
+              << strategies.size() << " strategies), " << options.bars << " bars each...\n";
+    std::cout << "Press Ctrl+C to stop.\n";
+    
+    std::signal(SIGINT, onInterrupt);
+    ShardedLiveEngine engine(shards, options);
+    ShardedLiveResult result = engine.run();
+    std::signal(SIGINT, SIG_DFL);
+    engine.printReport(result, static_cast<size_t>(std::max(config.getSweepTop(), 0)));
+    if (engine.writeCSV("logs/shard_results.csv", result)) {
+        std::cout << "Per-shard results written to logs/shard_results.csv\n";
+    }
+    std::cout << "Peak RSS: " << AllocationStats::peakRSSBytes() / (1024.0 * 1024.0) << " MB\n";
+}
+
+// Function to optimise on rolling train windows and trade each winner out of sample
+void runWalkForward(Config& config) {
+    std::cout << "\n" << std::string(60, '=') << "\n";
+    std::cout << "    NIFTY 50 TRADING BOT - WALK-FORWARD OPTIMISATION\n";
+    std::cout << std::string(60, '=') << "\n\n";
+    
+    MarketDataHandler dataHandler;
+    if (!loadMarketData(config, dataHandler)) {
+        return;
+    }
+    WalkForwardSpec spec = WalkForwardSpec::fromConfig(config);
+    WalkForward walk(dataHandler.getSeries(), BacktestParams::fromConfig(config), SweepSpec::fromConfig(config),
+                     spec);
+    size_t windows = walk.windows().size();
+    if (windows == 0) {
+        std::cerr << "Error: " << dataHandler.getSeries().size() << " bars are too few for a "
+                  << spec.train_bars << "-bar train window and a " << spec.test_bars << "-bar test window\n";
+        return;
+    }
+    size_t threads = static_cast<size_t>(std::max(config.getSweepThreads(), 0));
+    std::cout << "Walking " << windows << " windows (" << spec.train_bars << " train / " << spec.test_bars
+              << " test bars, " << (spec.anchored ? "anchored" : "rolling") << ") x " << walk.combinations()
+              << " combinations on " << (threads == 0 ? ThreadPool::defaultThreadCount() : threads)
+              << " threads, best " << (spec.optimize_sharpe ? "Sharpe" : "P/L") << " wins...\n";
+    
+    WalkForwardResult result = walk.run(threads);
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Completed in " << result.seconds << " s ("
+              << (result.seconds > 0 ? result.backtests / result.seconds : 0.0) << " backtests/s)\n";
+    WalkForward::printTable(result);
+    if (WalkForward::writeCSV("logs/walkforward_windows.csv", result)) {
+        std::cout << "Per-window results written to logs/walkforward_windows.csv\n";
+    }
+    if (WalkForward::writeEquityCSV("logs/walkforward_equity.csv", result)) {
+        std::cout << "Out-of-sample equity curve written to logs/walkforward_equity.csv\n";
+    }
+}
+
+// Function to put confidence intervals on the configured strategy's backtest
+void runMonteCarlo(Config& config) {
+    std::cout << "\n" << std::string(60, '=') << "\n";
+    std::cout << "    NIFTY 50 TRADING BOT - MONTE CARLO ANALYSIS\n";
+    std::cout << std::string(60, '=') << "\n\n";
+    
+    MarketDataHandler dataHandler;
+    if (!loadMarketData(config, dataHandler)) {
+        return;
+    }
+    MonteCarloSpec spec = MonteCarloSpec::fromConfig(config);
+    MonteCarlo monteCarlo(dataHandler.getSeries(), BacktestParams::fromConfig(config), spec);
+    size_t threads = static_cast<size_t>(std::max(config.getMonteCarloThreads(), 0));
+    std::cout << "Running " << spec.runs << " scenarios each of trade bootstrap, " << spec.block_bars
+              << "-bar block bootstrap and " << spec.slippage_bps << " bps random slippage on "
+              << (threads == 0 ? ThreadPool::defaultThreadCount() : threads) << " threads (seed "
+              << spec.seed << ")...\n";
+    
+    MonteCarloResult result = monteCarlo.run(threads);
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Completed in " << result.seconds << " s ("
+              << (result.seconds > 0 ? result.scenarios() / result.seconds : 0.0) << " scenarios/s)\n";
+    MonteCarlo::printReport(result);
+    if (MonteCarlo::writeCSV("logs/montecarlo_results.csv", result)) {
+        std::cout << "Every scenario written to logs/montecarlo_results.csv\n";
+    }
+    printResourceUsage(result.allocations, result.loop_allocations, result.bars);
 }
 
 int main(int argc, char* argv[]) {
+    bool mode_from_args = false;
+    bool rebuild_cache = false;
     Mode mode = Mode::BACKTEST;
-    if (argc > 1) {
-        std::string arg = argv[1];
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
         if (arg == "--live") {
             mode = Mode::LIVE_SIM;
+            mode_from_args = true;
+        } else if (arg == "--sweep") {
+            mode = Mode::SWEEP;
+            mode_from_args = true;
+        } else if (arg == "--replay") {
+            mode = Mode::REPLAY;
+            mode_from_args = true;
+        } else if (arg == "--portfolio") {
+            mode = Mode::PORTFOLIO;
+            mode_from_args = true;
+        } else if (arg == "--sharded") {
+            mode = Mode::SHARDED;
+            mode_from_args = true;
+        } else if (arg == "--walkforward") {
+            mode = Mode::WALK_FORWARD;
+            mode_from_args = true;
+        } else if (arg == "--montecarlo") {
+            mode = Mode::MONTE_CARLO;
+            mode_from_args = true;
+        } else if (arg == "--backtest") {
+            mode = Mode::BACKTEST;
+            mode_from_args = true;
+        } else if (arg == "--rebuild-cache") {
+            rebuild_cache = true;
+        } else {
+            std::cerr << "Unknown option: " << arg << "\n";
         }
     }
     Config config;
     config.loadFromFile("config.txt");
-    if (argc > 1) {
-        if (mode == Mode::LIVE_SIM) {
-            runLiveSimulation(config);
-        } else {
-            runBacktest(config);
-        }
+    if (rebuild_cache) config.setRebuildCache(true);
+    if (!mode_from_args) mode = config.getMode();
+    if (mode == Mode::LIVE_SIM) {
+        runLiveSimulation(config);
+    } else if (mode == Mode::REPLAY) {
+        runReplay(config);
+    } else if (mode == Mode::SWEEP) {
+        runSweep(config);
+    } else if (mode == Mode::PORTFOLIO) {
+        runPortfolio(config);
+    } else if (mode == Mode::SHARDED) {
+        runSharded(config);
+    } else if (mode == Mode::WALK_FORWARD) {
+        runWalkForward(config);
+    } else if (mode == Mode::MONTE_CARLO) {
+        runMonteCarlo(config);
     } else {
-        if (config.getMode() == Mode::LIVE_SIM) {
-            runLiveSimulation(config);
-        } else {
-            runBacktest(config);
-        }
-    }    
+        runBacktest(config);
+    }
     return 0;
 }
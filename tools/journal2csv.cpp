@@ -0,0 +1,45 @@
+// Convert a binary trade journal (.tbj) into the CSV TradeLogger writes.
+//
+//   g++ -std=c++17 -O2 -I../bot journal2csv.cpp ../bot/TradeJournal.cpp ../bot/TradeLogger.cpp
+//       ../bot/PerformanceTracker.cpp ../bot/RunArena.cpp ../bot/BarSeries.cpp ../bot/MappedFile.cpp -pthread -o journal2csv
+//   ./journal2csv logs/trades.tbj [out.csv]     (stdout when no output file is given)
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include "TradeJournal.h"
+#include "TradeLogger.h"
+
+using namespace TradingBot;
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <journal.tbj> [output.csv]\n";
+        return 2;
+    }
+    TradeJournalReader reader;
+    if (!reader.open(argv[1])) {
+        std::cerr << "Error: " << argv[1] << " is not a readable trade journal\n";
+        return 1;
+    }
+    std::FILE* out = argc > 2 ? std::fopen(argv[2], "wb") : stdout;
+    if (!out) {
+        std::cerr << "Error: could not create " << argv[2] << "\n";
+        return 1;
+    }
+    std::string buffer = TradeLogger::csvHeader();
+    size_t trades = 0;
+    for (size_t i = 0; i < reader.recordCount(); ++i) {
+        if (!reader.isFill(i)) continue;
+        TradeLogger::appendCSVRow(buffer, reader.tradeAt(i));
+        trades++;
+        if (buffer.size() >= 64 * 1024) {
+            std::fwrite(buffer.data(), 1, buffer.size(), out);
+            buffer.clear();
+        }
+    }
+    std::fwrite(buffer.data(), 1, buffer.size(), out);
+    bool ok = std::fflush(out) == 0;
+    if (out != stdout) ok = std::fclose(out) == 0 && ok;
+    if (argc > 2) std::cerr << "Wrote " << trades << " trades to " << argv[2] << "\n";
+    return ok ? 0 : 1;
+}